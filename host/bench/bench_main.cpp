@@ -0,0 +1,87 @@
+// bench_main.cpp - Host microbenchmarks for the LVGL-free firmware modules (pio run -e native)
+//
+// Reports wall time and heap traffic per call. Heap numbers come from the counting allocator
+// in host/shims/host_alloc.cpp and match the device for String and ArduinoJson; timings are
+// host timings and only meaningful relative to each other and to earlier runs.
+#include <Arduino.h>
+#include <chrono>
+#include "bar_layout.h"
+#include "data_parser.h"
+#include "formatters.h"
+#include "legacy_formatters.h"
+#include "rotation.h"
+#include "sample_payload.h"
+
+static volatile uint32_t benchSink;  // keeps results observable so calls are not optimized away
+
+template <typename Fn>
+static void bench(const char* name, uint32_t iterations, Fn fn) {
+    for (uint32_t i = 0; i < iterations / 10 + 1; i++) fn(i); // warm up
+    HostAllocStats before = hostAllocStats();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    HostAllocStats after = hostAllocStats();
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    printf("%-26s %10.1f %10.2f %10.1f\n", name, ns,
+           (double)(after.allocs - before.allocs) / iterations,
+           (double)(after.bytes - before.bytes) / iterations);
+}
+
+int main() {
+    String payload(SAMPLE_PAYLOAD);
+    if (!parseCombinedData(payload, data)) {
+        fprintf(stderr, "sample payload does not parse\n");
+        return 1;
+    }
+
+    static const float POWERS[] = {0, 42.4f, 850, 999.6f, 1234, 4210, 9999, 12345, -3700};
+    static const int NPOWERS = sizeof(POWERS) / sizeof(POWERS[0]);
+    const String planTime = data.lp1.effectivePlanTime;
+
+    printf("%-26s %10s %10s %10s\n", "benchmark", "ns/op", "allocs/op", "bytes/op");
+    bench("parseCombinedData", 20000, [&](uint32_t) {
+        benchSink = parseCombinedData(payload, data);
+    });
+    char text[FORMAT_BUF_SIZE];
+    bench("formatPower", 200000, [&](uint32_t i) {
+        benchSink = formatPower(text, sizeof(text), POWERS[i % NPOWERS])[0];
+    });
+    bench("  legacy String version", 200000, [&](uint32_t i) {
+        benchSink = legacyFormatPower(POWERS[i % NPOWERS]).length();
+    });
+    bench("formatEnergy", 200000, [&](uint32_t i) {
+        benchSink = formatEnergy(text, sizeof(text), POWERS[i % NPOWERS] * 4)[0];
+    });
+    bench("  legacy String version", 200000, [&](uint32_t i) {
+        benchSink = legacyFormatEnergy(POWERS[i % NPOWERS] * 4).length();
+    });
+    bench("formatPercentage", 200000, [&](uint32_t i) {
+        benchSink = formatPercentage(text, sizeof(text), (float)(i % 101))[0];
+    });
+    bench("  legacy String version", 200000, [&](uint32_t i) {
+        benchSink = legacyFormatPercentage((float)(i % 101)).length();
+    });
+    bench("formatDuration", 200000, [&](uint32_t i) {
+        benchSink = formatDuration(text, sizeof(text), (int)(i % 20000))[0];
+    });
+    bench("  legacy String version", 200000, [&](uint32_t i) {
+        benchSink = legacyFormatDuration((int)(i % 20000)).length();
+    });
+    bench("formatPlanTime", 50000, [&](uint32_t) {
+        benchSink = formatPlanTime(planTime).length();
+    });
+    bench("getActiveLoadpoint", 1000000, [&](uint32_t) {
+        benchSink = (uint32_t)(uintptr_t)getActiveLoadpoint();
+    });
+    bench("compositeBarLayout", 1000000, [&](uint32_t i) {
+        float values[4] = {POWERS[i % NPOWERS], 1200, data.lp1.chargePower, 300};
+        BarSegmentLayout layout[4];
+        benchSink = compositeBarLayout(values, 4, COLUMN_WIDTH - 8, layout) ? layout[3].x : 0;
+    });
+
+    HostAllocStats total = hostAllocStats();
+    printf("\nheap: %llu allocs, %llu frees, %zu bytes live, %zu bytes peak\n",
+           (unsigned long long)total.allocs, (unsigned long long)total.frees, total.liveBytes, total.peakBytes);
+    return 0;
+}
@@ -0,0 +1,29 @@
+// legacy_formatters.h - The String-returning number formatters the firmware used before the
+// fixed-buffer ones in src/formatters.cpp; reference for the equivalence check and the bench
+#pragma once
+
+#include <Arduino.h>
+
+inline String legacyFormatPower(float watts) {
+    if (abs(watts) < 1000) return String((int)watts) + "W";
+    if (abs(watts) < 10000) return String(watts / 1000.0, 1) + "kW";
+    return String(watts / 1000.0, 0) + "kW";
+}
+
+inline String legacyFormatEnergy(float wh) {
+    if (abs(wh) < 1000) return String((int)wh) + "Wh";
+    if (abs(wh) < 10000) return String(wh / 1000.0, 1) + "kWh";
+    return String(wh / 1000.0, 0) + "kWh";
+}
+
+inline String legacyFormatPercentage(float value) { return value >= 0 ? String((int)value) + "%" : "---"; }
+inline String legacyFormatDistance(float value) { return value >= 0 ? String((int)value) + "km" : "-- km"; }
+
+inline String legacyFormatDuration(int seconds) {
+    if (seconds <= 0) return "--:--";
+    int hours = seconds / 3600;
+    int minutes = (seconds % 3600) / 60;
+    char buf[8];
+    snprintf(buf, sizeof(buf), "%02d:%02d", hours, minutes);
+    return String(buf);
+}
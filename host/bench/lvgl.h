@@ -0,0 +1,7 @@
+// lvgl.h - Bench-only stand-in: config.h includes LVGL for its font macros, which the benchmarks never use
+#pragma once
+
+typedef struct _lv_font_t lv_font_t;
+extern const lv_font_t lv_font_montserrat_12;
+extern const lv_font_t lv_font_montserrat_14;
+extern const lv_font_t lv_font_montserrat_16;
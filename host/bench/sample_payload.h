@@ -0,0 +1,4 @@
+// sample_payload.h - Representative /api/state?jq=... response (two loadpoints, one charging)
+#pragma once
+
+static const char SAMPLE_PAYLOAD[] = R"JSON({"gridPower":-1834.5,"pvPower":7412.3,"batterySoc":87,"homePower":612.8,"batteryPower":-1245.1,"solar":{"scale":0.94,"todayEnergy":38125.6},"loadpoints":[{"chargePower":3720.4,"soc":64,"charging":true,"plugged":true,"title":"Garage","vehicletitle":"ID.3","vehicleRange":271,"effectivePlanTime":"2026-10-18T05:00:00Z","effectivePlanSoc":80,"effectiveLimitSoc":90,"planProjectedStart":"2026-10-18T01:30:00Z","chargeCurrents":[5.4,5.3,5.5],"maxCurrent":16,"offeredCurrent":5.5,"phasesActive":3,"chargeRemainingDuration":5820,"chargedEnergy":6240.2,"vehicleCapacity":58},{"chargePower":0,"soc":41,"charging":false,"plugged":true,"title":"Carport","vehicletitle":"Zoe","vehicleRange":132,"effectivePlanTime":null,"effectivePlanSoc":0,"effectiveLimitSoc":100,"planProjectedStart":null,"chargeCurrents":[0,0,0],"maxCurrent":32,"offeredCurrent":0,"phasesActive":0,"chargeRemainingDuration":0,"chargedEnergy":0,"vehicleCapacity":52}]})JSON";
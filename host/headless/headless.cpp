@@ -0,0 +1,51 @@
+// headless.cpp - Firmware runtime for host programs that drive the real UI
+#include "headless.h"
+#include "clock.h"
+#include "config.h"
+#include "ui_helpers.h"
+
+// Defined by the sketch on the device
+UIElements ui;
+lv_style_t stripe_style;
+
+uint32_t headlessFlushedPixels = 0;
+
+static lv_color_t drawBuf[SCREEN_WIDTH * 10];
+static lv_disp_draw_buf_t dispBuf;
+static lv_disp_drv_t dispDrv;
+static time_t epochOverride = 0;
+
+static void headlessFlush(lv_disp_drv_t* disp, const lv_area_t* area, lv_color_t*) {
+    headlessFlushedPixels += lv_area_get_size(area);
+    lv_disp_flush_ready(disp);
+}
+
+void headlessDisplayInit() {
+    lv_init();
+    lv_disp_draw_buf_init(&dispBuf, drawBuf, NULL, SCREEN_WIDTH * 10);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = SCREEN_WIDTH;
+    dispDrv.ver_res = SCREEN_HEIGHT;
+    dispDrv.flush_cb = headlessFlush;
+    dispDrv.draw_buf = &dispBuf;
+    lv_disp_drv_register(&dispDrv);
+}
+
+static uint32_t headlessMillis() {
+    return (uint32_t)millis();
+}
+
+static time_t headlessTime() {
+    return epochOverride ? epochOverride : time(nullptr);
+}
+
+static const ClockSource headlessClock = {headlessMillis, headlessTime};
+
+void headlessSetEpoch(time_t epoch) {
+    epochOverride = epoch;
+    clockInstall(&headlessClock);
+}
+
+time_t headlessEpoch() {
+    return epochOverride;
+}
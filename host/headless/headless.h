@@ -0,0 +1,18 @@
+// headless.h - Firmware runtime for host programs that drive the real UI (replay, soak)
+//
+// Provides what the sketch defines on the device (ui, stripe_style, the display driver)
+// with a display that only counts flushed pixels, and a wall clock the harness controls.
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+extern uint32_t headlessFlushedPixels;  // pixels flushed since the harness last reset it
+
+// lv_init() and a SCREEN_WIDTH x 10 draw buffer like the device; call before createUI()
+void headlessDisplayInit();
+
+// Installs a clock whose wall time is this epoch while it is non-zero (time() otherwise);
+// its millis() is the host clock, virtual once hostClockSetVirtual() was called
+void headlessSetEpoch(time_t epoch);
+time_t headlessEpoch();
@@ -0,0 +1,11 @@
+// lv_conf.h - Headless host builds: the firmware's LVGL configuration with an externally driven tick
+//
+// src/lv_conf.h takes the tick from millis() via Arduino.h, which the C parts of LVGL cannot
+// include on the host; the harness calls lv_tick_inc() as it advances its virtual clock instead.
+// LVGL's objects hold 64-bit pointers on the host, so its static pool gets twice the device's
+#define LV_MEM_SIZE (96U * 1024U)
+
+#include "../../src/lv_conf.h"
+
+#undef LV_TICK_CUSTOM
+#define LV_TICK_CUSTOM 0
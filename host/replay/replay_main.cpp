@@ -0,0 +1,249 @@
+// replay_main.cpp - Replays recorded EVCC responses through the firmware pipeline on the host
+//
+// Input is the NDJSON downloaded from /capture, one {"seq","ms","epoch","len","body"} record per
+// poll. Each record runs the same steps as pollEVCCData() followed by one LVGL refresh:
+// parse -> updateUI() -> publish (/events delta) -> render into a
+// headless display. A virtual clock follows the recorded timestamps, so loadpoint rotation,
+// plan-time formatting and LVGL timers see the times the device saw and a day of polls replays
+// in seconds. --speed N paces the replay at N times real time instead of as fast as possible.
+//
+// Usage: program <capture.ndjson> [--speed N] [--summary]
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <lvgl.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "clock.h"
+#include "config.h"
+#include "data_parser.h"
+#include "display_updates.h"
+#include "events.h"
+#include "headless.h"
+#include "ui_helpers.h"
+
+struct Record {
+    uint32_t seq;
+    uint32_t ms;
+    uint32_t epoch;
+    std::string body;
+};
+
+enum StepOutcome : uint8_t { STEP_APPLIED, STEP_PARSE_ERROR };
+#define ALL_STEPS 0x03
+
+struct StepResult {
+    uint32_t seq;
+    uint32_t ms;
+    StepOutcome outcome;
+    float parseUs, uiUs, publishUs, renderUs;
+    uint32_t pixels;
+    uint64_t allocs;
+    uint64_t bytes;
+    size_t heapLive;        // after the step, relative to the baseline before LVGL started
+    size_t heapPeak;        // high-water mark during the step, same baseline
+};
+
+using ReplayClock = std::chrono::steady_clock;
+
+static float usSince(ReplayClock::time_point start) {
+    return std::chrono::duration<float, std::micro>(ReplayClock::now() - start).count();
+}
+
+static bool loadCapture(const char* path, std::vector<Record>& out) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    std::string line;
+    size_t lineNo = 0, truncated = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (line.empty()) continue;
+        DynamicJsonDocument doc(line.size() + 256);
+        if (deserializeJson(doc, line) || !doc["body"].is<const char*>()) {
+            fprintf(stderr, "%s:%zu: not a capture record, skipped\n", path, lineNo);
+            continue;
+        }
+        if (doc["truncated"] | false) {
+            truncated++;
+            continue;
+        }
+        out.push_back({doc["seq"] | 0u, doc["ms"] | 0u, doc["epoch"] | 0u, doc["body"].as<const char*>()});
+    }
+    if (truncated) fprintf(stderr, "%zu truncated records skipped\n", truncated);
+    return true;
+}
+
+// One poll as pollEVCCData() runs it, then the LVGL refresh the next loop() iteration does
+static StepResult runStep(const Record& rec, size_t heapBase) {
+    StepResult r = {};
+    r.seq = rec.seq;
+    r.ms = rec.ms;
+    hostAllocResetPeak();
+    HostAllocStats before = hostAllocStats();
+    {
+        // Stands in for http.getString() into the pre-reserved response
+        String response;
+        response.reserve(2048);
+        response.concat(rec.body.c_str(), rec.body.length());
+
+        auto start = ReplayClock::now();
+        bool parsed = parseCombinedData(response, data);
+        r.parseUs = usSince(start);
+        if (parsed) {
+            r.outcome = STEP_APPLIED;
+            data.lastUpdate = clockMillis();
+            start = ReplayClock::now();
+            updateUI();
+            r.uiUs = usSince(start);
+            start = ReplayClock::now();
+            eventsPublish(data);
+            r.publishUs = usSince(start);
+        } else {
+            r.outcome = STEP_PARSE_ERROR;
+        }
+        if (r.outcome != STEP_PARSE_ERROR) updatePhaseHistory();
+    }
+    headlessFlushedPixels = 0;
+    auto start = ReplayClock::now();
+    lv_timer_handler();
+    r.renderUs = usSince(start);
+    r.pixels = headlessFlushedPixels;
+
+    HostAllocStats after = hostAllocStats();
+    r.allocs = after.allocs - before.allocs;
+    r.bytes = after.bytes - before.bytes;
+    r.heapLive = after.liveBytes - heapBase;
+    r.heapPeak = after.peakBytes - heapBase;
+    return r;
+}
+
+struct StageSummary {
+    const char* name;
+    float StepResult::*field;
+    uint8_t outcomes;       // bit per StepOutcome in which the stage runs
+};
+
+static void printStage(const std::vector<StepResult>& steps, const StageSummary& stage) {
+    std::vector<float> v;
+    for (const StepResult& s : steps) {
+        if (stage.outcomes & (1 << s.outcome)) v.push_back(s.*stage.field);
+    }
+    if (v.empty()) return;
+    std::sort(v.begin(), v.end());
+    double sum = 0;
+    for (float x : v) sum += x;
+    printf("  %-8s %8zu %10.1f %10.1f %10.1f\n", stage.name, v.size(), sum / v.size(),
+           v[std::min(v.size() - 1, v.size() * 95 / 100)], v.back());
+}
+
+static void printSummary(const std::vector<StepResult>& steps, double wallMs) {
+    if (steps.empty()) return;
+    size_t errors = 0;
+    uint64_t allocs = 0, bytes = 0, maxAllocs = 0;
+    size_t peak = 0;
+    for (const StepResult& s : steps) {
+        errors += s.outcome == STEP_PARSE_ERROR;
+        allocs += s.allocs;
+        bytes += s.bytes;
+        maxAllocs = std::max(maxAllocs, s.allocs);
+        peak = std::max(peak, s.heapPeak);
+    }
+    double recordedS = (uint32_t)(steps.back().ms - steps.front().ms) / 1000.0;
+    printf("\nreplayed %zu polls covering %.0f s in %.1f ms: %.0f polls/s, %.0fx real time\n",
+           steps.size(), recordedS, wallMs, steps.size() * 1000.0 / wallMs, recordedS * 1000.0 / wallMs);
+    printf("  %zu applied, %zu parse errors, %lu label/chart updates skipped (unchanged)\n", steps.size() - errors, errors,
+           (unsigned long)uiRedrawsSkipped);
+    printf("\n  %-8s %8s %10s %10s %10s\n", "stage", "count", "avg us", "p95 us", "max us");
+    static const StageSummary STAGES[] = {
+        {"parse", &StepResult::parseUs, ALL_STEPS},
+        {"ui", &StepResult::uiUs, 1 << STEP_APPLIED},
+        {"publish", &StepResult::publishUs, 1 << STEP_APPLIED},
+        {"render", &StepResult::renderUs, ALL_STEPS},
+    };
+    for (const StageSummary& stage : STAGES) printStage(steps, stage);
+    printf("\n  allocations: %.1f/poll (max %llu), %.0f bytes/poll\n", (double)allocs / steps.size(),
+           (unsigned long long)maxAllocs, (double)bytes / steps.size());
+    printf("  heap: %zu bytes live at end, %zu bytes high-water\n", steps.back().heapLive, peak);
+    lv_mem_monitor_t ui;
+    lv_mem_monitor(&ui);
+    printf("  LVGL pool: %lu of %lu bytes used (high-water %lu), %u%% fragmented\n",
+           (unsigned long)(ui.total_size - ui.free_size), (unsigned long)ui.total_size, (unsigned long)ui.max_used,
+           ui.frag_pct);
+}
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    double speed = 0;       // 0 = as fast as possible
+    bool summaryOnly = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) speed = atof(argv[++i]);
+        else if (strcmp(argv[i], "--summary") == 0) summaryOnly = true;
+        else if (!path && argv[i][0] != '-') path = argv[i];
+        else path = nullptr, i = argc; // unknown option: show usage
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s <capture.ndjson> [--speed N] [--summary]\n", argv[0]);
+        return 2;
+    }
+    std::vector<Record> records;
+    if (!loadCapture(path, records)) return 1;
+    if (records.empty()) {
+        fprintf(stderr, "%s: no records\n", path);
+        return 1;
+    }
+
+    setenv("TZ", TIMEZONE, 1);
+    tzset();
+    hostClockSetVirtual(records.front().ms);
+    headlessSetEpoch(records.front().epoch);
+    size_t heapBase = hostAllocStats().liveBytes;
+
+    headlessDisplayInit();
+    initStripeStyle();
+    createUI();
+    lv_timer_handler();
+    lv_mem_monitor_t ui;
+    lv_mem_monitor(&ui);
+    printf("UI created: %zu bytes heap, %lu bytes LVGL pool\n\n", hostAllocStats().liveBytes - heapBase,
+           (unsigned long)(ui.total_size - ui.free_size));
+
+    if (!summaryOnly) {
+        printf("%8s %8s %-7s %8s %8s %8s %8s %7s %7s %7s %7s %7s\n", "seq", "t[s]", "step",
+               "parse", "ui", "publish", "render", "px", "allocs", "bytes", "heap", "peak");
+    }
+    static const char* OUTCOMES[] = {"applied", "error"};
+    std::vector<StepResult> steps;
+    steps.reserve(records.size());
+    uint32_t prevMs = records.front().ms;
+    auto wallStart = ReplayClock::now();
+    for (const Record& rec : records) {
+        uint32_t delta = rec.ms - prevMs;
+        prevMs = rec.ms;
+        hostClockAdvance(delta);
+        lv_tick_inc(delta);
+        if (rec.epoch) headlessSetEpoch(rec.epoch);
+        else if (headlessEpoch()) headlessSetEpoch(headlessEpoch() + delta / 1000);
+        if (speed > 0) {
+            auto due = wallStart + std::chrono::duration<double, std::milli>((rec.ms - records.front().ms) / speed);
+            std::this_thread::sleep_until(due);
+        }
+
+        StepResult r = runStep(rec, heapBase);
+        steps.push_back(r);
+        if (!summaryOnly) {
+            printf("%8lu %8.1f %-7s %8.1f %8.1f %8.1f %8.1f %7lu %7llu %7llu %7zu %7zu\n",
+                   (unsigned long)r.seq, (uint32_t)(r.ms - records.front().ms) / 1000.0, OUTCOMES[r.outcome],
+                   r.parseUs, r.uiUs, r.publishUs, r.renderUs, (unsigned long)r.pixels,
+                   (unsigned long long)r.allocs, (unsigned long long)r.bytes, r.heapLive, r.heapPeak);
+        }
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(ReplayClock::now() - wallStart).count();
+    printSummary(steps, wallMs);
+    return 0;
+}
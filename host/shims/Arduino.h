@@ -0,0 +1,86 @@
+// Arduino.h - Host shim of the Arduino-ESP32 core (just what the LVGL-free modules need)
+//
+// The host build is single-threaded, so the FreeRTOS critical sections compile to nothing.
+// ESP.getFreeHeap() and friends report the simulated heap when one is installed (soak runs),
+// otherwise a nominal device heap (HOST_HEAP_SIZE) minus the bytes currently allocated on the
+// host, as counted by host_alloc.cpp.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "WString.h"
+#include "host_alloc.h"
+
+using std::abs;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#ifndef HOST_HEAP_SIZE
+#define HOST_HEAP_SIZE 300000   // typical free heap of the display firmware after boot
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+inline void yield() {}
+
+// Virtual clock for replays: once set, millis()/micros() only move via hostClockAdvance()
+// and delay() returns immediately after advancing it
+void hostClockSetVirtual(unsigned long startMs);
+void hostClockAdvance(unsigned long ms);
+
+// FreeRTOS
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+typedef void* TaskHandle_t;
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+
+class EspClass {
+public:
+    uint32_t getHeapSize() { return HOST_HEAP_SIZE; }
+    uint32_t getFreeHeap() {
+        HostHeap* heap = hostAllocHeap();
+        return heap ? heap->freeBytes() : heapLeft(hostAllocStats().liveBytes);
+    }
+    uint32_t getMinFreeHeap() {
+        HostHeap* heap = hostAllocHeap();
+        return heap ? heap->minFreeBytes() : heapLeft(hostAllocStats().peakBytes);
+    }
+    uint32_t getMaxAllocHeap() {
+        HostHeap* heap = hostAllocHeap();
+        return heap ? heap->largestFreeBlock() : getFreeHeap();
+    }
+    uint32_t getFreePsram() { return 0; }
+    void restart() { exit(0); }
+
+private:
+    static uint32_t heapLeft(size_t used) { return used < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - (uint32_t)used : 0; }
+};
+extern EspClass ESP;
+
+class HardwareSerial {
+public:
+    void begin(unsigned long) {}
+    size_t print(const String& s) { return fputs(s.c_str(), stdout) >= 0 ? s.length() : 0; }
+    size_t print(const char* s) { return fputs(s, stdout) >= 0 ? strlen(s) : 0; }
+    size_t println(const String& s = String()) { size_t n = print(s); putchar('\n'); return n + 1; }
+    size_t println(const char* s) { size_t n = print(s); putchar('\n'); return n + 1; }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vprintf(fmt, args);
+        va_end(args);
+        return n > 0 ? n : 0;
+    }
+};
+extern HardwareSerial Serial;
@@ -0,0 +1,294 @@
+// WString.cpp - Host shim of the Arduino String class
+#include "WString.h"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void formatInteger(char* out, size_t cap, unsigned long value, bool negative, unsigned char base) {
+    char tmp[sizeof(unsigned long) * 8 + 2];
+    int n = 0;
+    if (base < 2) base = 10;
+    do {
+        unsigned digit = value % base;
+        tmp[n++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while (value);
+    size_t o = 0;
+    if (negative && o + 1 < cap) out[o++] = '-';
+    while (n > 0 && o + 1 < cap) out[o++] = tmp[--n];
+    out[o] = '\0';
+}
+
+String::String(const char* cstr) {
+    if (cstr) assign(cstr, strlen(cstr));
+}
+
+String::String(const String& other) {
+    assign(other.c_str(), other.len_);
+}
+
+String::String(String&& other) noexcept : buf_(other.buf_), len_(other.len_), cap_(other.cap_) {
+    other.buf_ = nullptr;
+    other.len_ = other.cap_ = 0;
+}
+
+String::String(char c) {
+    char s[2] = {c, '\0'};
+    assign(s, 1);
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long)value, base) {}
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) {
+    char s[sizeof(long) * 8 + 2];
+    bool negative = value < 0 && base == 10;
+    formatInteger(s, sizeof(s), negative ? 0UL - (unsigned long)value : (unsigned long)value, negative, base);
+    assign(s, strlen(s));
+}
+
+String::String(unsigned long value, unsigned char base) {
+    char s[sizeof(long) * 8 + 2];
+    formatInteger(s, sizeof(s), value, false, base);
+    assign(s, strlen(s));
+}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+    char s[64];
+    dtostrf(value, decimalPlaces + 2, decimalPlaces, s);
+    assign(s, strlen(s));
+}
+
+// arduino-esp32 stdlib_noniso.c, including its rounding
+char* dtostrf(double number, signed int width, unsigned int prec, char* s) {
+    if (std::isnan(number)) return strcpy(s, "nan");
+    if (std::isinf(number)) return strcpy(s, "inf");
+    bool negative = false;
+    char* out = s;
+    int fillme = width;
+    if (prec > 0) fillme -= prec + 1;
+    if (number < 0.0) {
+        negative = true;
+        fillme--;
+        number = -number;
+    }
+    double rounding = 2.0;
+    for (unsigned int i = 0; i < prec; ++i) rounding *= 10.0;
+    number += 1.0 / rounding;
+    double tenpow = 1.0;
+    int digitcount = 1;
+    while (number >= 10.0 * tenpow) {
+        tenpow *= 10.0;
+        digitcount++;
+    }
+    number /= tenpow;
+    fillme -= digitcount;
+    while (fillme-- > 0) *out++ = ' ';
+    if (negative) *out++ = '-';
+    digitcount += prec;
+    while (digitcount-- > 0) {
+        int digit = (int)number;
+        if (digit > 9) digit = 9;
+        *out++ = (char)('0' | digit);
+        if (digitcount == (int)prec && prec > 0) *out++ = '.';
+        number -= digit;
+        number *= 10.0;
+    }
+    *out = 0;
+    return s;
+}
+
+String::~String() {
+    free(buf_);
+}
+
+String& String::operator=(const String& rhs) {
+    if (this != &rhs) assign(rhs.c_str(), rhs.len_);
+    return *this;
+}
+
+String& String::operator=(String&& rhs) noexcept {
+    if (this != &rhs) {
+        free(buf_);
+        buf_ = rhs.buf_;
+        len_ = rhs.len_;
+        cap_ = rhs.cap_;
+        rhs.buf_ = nullptr;
+        rhs.len_ = rhs.cap_ = 0;
+    }
+    return *this;
+}
+
+String& String::operator=(const char* cstr) {
+    // ArduinoJson assigns nullptr for missing strings; the core then leaves an empty String
+    if (cstr) {
+        assign(cstr, strlen(cstr));
+    } else {
+        len_ = 0;
+        if (buf_) buf_[0] = '\0';
+    }
+    return *this;
+}
+
+bool String::ensure(unsigned int size) {
+    if (buf_ && cap_ >= size) return true;
+    char* p = (char*)realloc(buf_, size + 1);
+    if (!p) return false;
+    if (!buf_) p[0] = '\0';
+    buf_ = p;
+    cap_ = size;
+    return true;
+}
+
+bool String::reserve(unsigned int size) {
+    return ensure(size);
+}
+
+void String::assign(const char* cstr, unsigned int length) {
+    if (!ensure(length)) {
+        len_ = 0;
+        return;
+    }
+    memmove(buf_, cstr, length);
+    buf_[length] = '\0';
+    len_ = length;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+    if (!cstr) return false;
+    if (length == 0) return true;
+    if (!ensure(len_ + length)) return false;
+    memmove(buf_ + len_, cstr, length);
+    len_ += length;
+    buf_[len_] = '\0';
+    return true;
+}
+
+bool String::concat(const String& s) { return concat(s.c_str(), s.len_); }
+bool String::concat(const char* cstr) { return cstr && concat(cstr, strlen(cstr)); }
+bool String::concat(char c) { return concat(&c, 1); }
+bool String::concat(int value) { return concat(String(value)); }
+bool String::concat(unsigned int value) { return concat(String(value)); }
+bool String::concat(long value) { return concat(String(value)); }
+bool String::concat(unsigned long value) { return concat(String(value)); }
+bool String::concat(float value) { return concat(String(value)); }
+bool String::concat(double value) { return concat(String(value)); }
+
+bool String::equals(const String& s) const {
+    return len_ == s.len_ && memcmp(c_str(), s.c_str(), len_) == 0;
+}
+
+bool String::equals(const char* cstr) const {
+    return strcmp(c_str(), cstr ? cstr : "") == 0;
+}
+
+bool String::operator<(const String& rhs) const {
+    return strcmp(c_str(), rhs.c_str()) < 0;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return prefix.len_ <= len_ && memcmp(c_str(), prefix.c_str(), prefix.len_) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return suffix.len_ <= len_ && memcmp(c_str() + len_ - suffix.len_, suffix.c_str(), suffix.len_) == 0;
+}
+
+char& String::operator[](unsigned int index) {
+    static char dummy;
+    if (index >= len_) {
+        dummy = 0;
+        return dummy;
+    }
+    return buf_[index];
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+    if (fromIndex >= len_) return -1;
+    const char* p = strchr(c_str() + fromIndex, c);
+    return p ? (int)(p - c_str()) : -1;
+}
+
+int String::indexOf(const char* s, unsigned int fromIndex) const {
+    if (fromIndex >= len_) return -1;
+    const char* p = strstr(c_str() + fromIndex, s);
+    return p ? (int)(p - c_str()) : -1;
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    if (beginIndex > endIndex) {
+        unsigned int t = beginIndex;
+        beginIndex = endIndex;
+        endIndex = t;
+    }
+    String out;
+    if (beginIndex >= len_) return out;
+    if (endIndex > len_) endIndex = len_;
+    out.assign(c_str() + beginIndex, endIndex - beginIndex);
+    return out;
+}
+
+void String::toLowerCase() {
+    for (unsigned int i = 0; i < len_; i++) buf_[i] = tolower((unsigned char)buf_[i]);
+}
+
+void String::toUpperCase() {
+    for (unsigned int i = 0; i < len_; i++) buf_[i] = toupper((unsigned char)buf_[i]);
+}
+
+void String::trim() {
+    if (len_ == 0) return;
+    unsigned int begin = 0, end = len_;
+    while (begin < end && isspace((unsigned char)buf_[begin])) begin++;
+    while (end > begin && isspace((unsigned char)buf_[end - 1])) end--;
+    len_ = end - begin;
+    memmove(buf_, buf_ + begin, len_);
+    buf_[len_] = '\0';
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index >= len_) return;
+    if (count > len_ - index) count = len_ - index;
+    memmove(buf_ + index, buf_ + index + count, len_ - index - count + 1);
+    len_ -= count;
+}
+
+long String::toInt() const {
+    return atol(c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(c_str());
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs) {
+    StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+    a.concat(rhs);
+    return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr) {
+    StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+    a.concat(cstr);
+    return a;
+}
+
+#define SUM_OPERATOR(T) \
+    StringSumHelper& operator+(const StringSumHelper& lhs, T value) { \
+        StringSumHelper& a = const_cast<StringSumHelper&>(lhs); \
+        a.concat(value); \
+        return a; \
+    }
+
+SUM_OPERATOR(char)
+SUM_OPERATOR(int)
+SUM_OPERATOR(unsigned int)
+SUM_OPERATOR(long)
+SUM_OPERATOR(unsigned long)
+SUM_OPERATOR(float)
+SUM_OPERATOR(double)
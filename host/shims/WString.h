@@ -0,0 +1,107 @@
+// WString.h - Host shim of the Arduino String class (subset used by src/ and ArduinoJson)
+//
+// Storage comes from malloc/realloc like the Arduino core, so the allocation counters in
+// host_alloc.cpp see the same heap traffic as on the device. Float conversion goes through the
+// core's dtostrf() algorithm (double arithmetic, ties can round either way), not printf.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class StringSumHelper;
+
+class String {
+public:
+    String(const char* cstr = "");
+    String(const String& other);
+    String(String&& other) noexcept;
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+    ~String();
+
+    String& operator=(const String& rhs);
+    String& operator=(String&& rhs) noexcept;
+    String& operator=(const char* cstr);
+
+    bool reserve(unsigned int size);
+    unsigned int length() const { return len_; }
+    bool isEmpty() const { return len_ == 0; }
+    const char* c_str() const { return buf_ ? buf_ : ""; }
+
+    bool concat(const String& s);
+    bool concat(const char* cstr);
+    bool concat(const char* cstr, unsigned int length);
+    bool concat(char c);
+    bool concat(int value);
+    bool concat(unsigned int value);
+    bool concat(long value);
+    bool concat(unsigned long value);
+    bool concat(float value);
+    bool concat(double value);
+
+    template <typename T> String& operator+=(const T& rhs) { concat(rhs); return *this; }
+
+    bool equals(const String& s) const;
+    bool equals(const char* cstr) const;
+    bool operator==(const String& rhs) const { return equals(rhs); }
+    bool operator==(const char* rhs) const { return equals(rhs); }
+    bool operator!=(const String& rhs) const { return !equals(rhs); }
+    bool operator!=(const char* rhs) const { return !equals(rhs); }
+    bool operator<(const String& rhs) const;
+    bool startsWith(const String& prefix) const;
+    bool endsWith(const String& suffix) const;
+
+    char charAt(unsigned int index) const { return index < len_ ? buf_[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index);
+
+    int indexOf(char c, unsigned int fromIndex = 0) const;
+    int indexOf(const char* s, unsigned int fromIndex = 0) const;
+    int indexOf(const String& s, unsigned int fromIndex = 0) const { return indexOf(s.c_str(), fromIndex); }
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, len_); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+    void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+    long toInt() const;
+    float toFloat() const;
+
+private:
+    char* buf_ = nullptr;
+    unsigned int len_ = 0;
+    unsigned int cap_ = 0;
+
+    bool ensure(unsigned int size);
+    void assign(const char* cstr, unsigned int length);
+};
+
+class StringSumHelper : public String {
+public:
+    StringSumHelper(const String& s) : String(s) {}
+    StringSumHelper(const char* p) : String(p) {}
+    explicit StringSumHelper(char c) : String(c) {}
+    explicit StringSumHelper(int num) : String(num) {}
+    explicit StringSumHelper(unsigned long num) : String(num) {}
+};
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs);
+StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr);
+StringSumHelper& operator+(const StringSumHelper& lhs, char c);
+StringSumHelper& operator+(const StringSumHelper& lhs, int num);
+StringSumHelper& operator+(const StringSumHelper& lhs, unsigned int num);
+StringSumHelper& operator+(const StringSumHelper& lhs, long num);
+StringSumHelper& operator+(const StringSumHelper& lhs, unsigned long num);
+StringSumHelper& operator+(const StringSumHelper& lhs, float num);
+StringSumHelper& operator+(const StringSumHelper& lhs, double num);
+inline bool operator==(const char* lhs, const String& rhs) { return rhs.equals(lhs); }
+
+// stdlib_noniso.h of the core (used by String(float/double))
+char* dtostrf(double number, signed int width, unsigned int prec, char* s);
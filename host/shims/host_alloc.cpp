@@ -0,0 +1,151 @@
+// host_alloc.cpp - Counting wrappers around the C allocator (see host_alloc.h)
+//
+// Each C library block carries a small header with its requested size so free() can keep
+// liveBytes exact without asking the C library for usable sizes. Blocks of an installed
+// HostHeap carry their own bookkeeping.
+#include "host_alloc.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+void __real_free(void* p);
+void __wrap_free(void* p);
+}
+
+static HostAllocStats allocStats;
+static HostHeap* heapModel = nullptr;
+static bool heapActive = false;
+static bool heapBusy = false;       // inside a HostHeap call: nested allocations go to the C library
+
+static const size_t ALLOC_HEADER = alignof(std::max_align_t);
+
+static void countAlloc(size_t size, size_t live) {
+    allocStats.allocs++;
+    allocStats.bytes += size;
+    allocStats.liveBytes += live;
+    if (allocStats.liveBytes > allocStats.peakBytes) allocStats.peakBytes = allocStats.liveBytes;
+}
+
+static void* track(void* raw, size_t size) {
+    if (!raw) return nullptr;
+    *(size_t*)raw = size;
+    countAlloc(size, size);
+    return (char*)raw + ALLOC_HEADER;
+}
+
+static void* untrack(void* p) {
+    char* raw = (char*)p - ALLOC_HEADER;
+    allocStats.frees++;
+    allocStats.liveBytes -= *(size_t*)raw;
+    return raw;
+}
+
+static bool useHeap() {
+    return heapModel && heapActive && !heapBusy;
+}
+
+static bool heapOwns(const void* p) {
+    return heapModel && !heapBusy && heapModel->owns(p);
+}
+
+static void* heapAlloc(size_t size) {
+    heapBusy = true;
+    void* p = heapModel->alloc(size);
+    if (p) countAlloc(size, heapModel->usableSize(p));
+    heapBusy = false;
+    return p;
+}
+
+static void heapFree(void* p) {
+    heapBusy = true;
+    allocStats.frees++;
+    allocStats.liveBytes -= heapModel->usableSize(p);
+    heapModel->free(p);
+    heapBusy = false;
+}
+
+extern "C" {
+
+void* __wrap_malloc(size_t size) {
+    if (useHeap()) return heapAlloc(size);
+    return track(__real_malloc(size + ALLOC_HEADER), size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    if (size && n > (SIZE_MAX - ALLOC_HEADER) / size) return nullptr;
+    void* p = __wrap_malloc(n * size);
+    if (p) memset(p, 0, n * size);
+    return p;
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+    if (!p) return __wrap_malloc(size);
+    if (size == 0) {
+        __wrap_free(p);
+        return nullptr;
+    }
+    if (heapOwns(p)) {
+        heapBusy = true;
+        size_t old = heapModel->usableSize(p);
+        void* q = heapModel->realloc(p, size);
+        if (q) {
+            allocStats.frees++;
+            allocStats.liveBytes -= old;
+            countAlloc(size, heapModel->usableSize(q));
+        }
+        heapBusy = false;
+        return q;
+    }
+    size_t old = *(size_t*)((char*)p - ALLOC_HEADER);
+    void* raw = __real_realloc((char*)p - ALLOC_HEADER, size + ALLOC_HEADER);
+    if (!raw) return nullptr;
+    // A resized block counts as a fresh allocation, like the reallocation it is on the device
+    allocStats.frees++;
+    allocStats.liveBytes -= old;
+    return track(raw, size);
+}
+
+void __wrap_free(void* p) {
+    if (!p) return;
+    if (heapOwns(p)) heapFree(p);
+    else __real_free(untrack(p));
+}
+
+} // extern "C"
+
+// Route C++ allocations through the wrapped malloc as well
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+HostAllocStats hostAllocStats() {
+    return allocStats;
+}
+
+void hostAllocResetPeak() {
+    allocStats.peakBytes = allocStats.liveBytes;
+}
+
+void hostAllocInstallHeap(HostHeap* heap) {
+    heapModel = heap;
+    heapActive = false;
+}
+
+void hostAllocHeapActive(bool active) {
+    heapActive = active;
+}
+
+HostHeap* hostAllocHeap() {
+    return heapModel;
+}
@@ -0,0 +1,40 @@
+// host_alloc.h - Heap accounting for host builds
+//
+// The native env links with -Wl,--wrap=malloc,... so every malloc/calloc/realloc/free (String,
+// ArduinoJson, operator new) goes through host_alloc.cpp. Needs GNU ld; on other linkers drop
+// the wrap flags and the counters simply stay at zero.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct HostAllocStats {
+    uint64_t allocs;        // successful malloc/calloc/realloc calls that returned a new block
+    uint64_t frees;
+    uint64_t bytes;         // total bytes requested
+    size_t liveBytes;       // currently allocated
+    size_t peakBytes;       // high-water mark of liveBytes since the last reset
+};
+
+HostAllocStats hostAllocStats();
+void hostAllocResetPeak();  // peak := live
+
+// Simulated device heap (host/soak). While installed and active, allocations are served by it
+// instead of the C library; frees of its blocks are routed back to it even when inactive.
+// Calls into it are never nested: allocations it makes itself go to the C library.
+class HostHeap {
+public:
+    virtual ~HostHeap() {}
+    virtual void* alloc(size_t size) = 0;
+    virtual void* realloc(void* p, size_t size) = 0;
+    virtual void free(void* p) = 0;
+    virtual bool owns(const void* p) const = 0;
+    virtual size_t usableSize(const void* p) const = 0;
+    virtual size_t freeBytes() const = 0;
+    virtual size_t largestFreeBlock() const = 0;
+    virtual size_t minFreeBytes() const = 0;
+};
+
+void hostAllocInstallHeap(HostHeap* heap);  // nullptr = C library only
+void hostAllocHeapActive(bool active);      // route new allocations to the installed heap
+HostHeap* hostAllocHeap();                  // installed heap, or nullptr
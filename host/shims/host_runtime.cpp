@@ -0,0 +1,57 @@
+// host_runtime.cpp - Host definitions of the Arduino core and firmware globals the modules use
+#include <Arduino.h>
+#include <chrono>
+#include <thread>
+#include "config.h"
+#include "logging.h"
+
+EspClass ESP;
+HardwareSerial Serial;
+
+static const auto hostStart = std::chrono::steady_clock::now();
+static bool hostClockVirtual = false;
+static uint64_t hostVirtualUs = 0;
+
+unsigned long millis() {
+    return micros() / 1000;
+}
+
+unsigned long micros() {
+    if (hostClockVirtual) return (unsigned long)hostVirtualUs;
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - hostStart).count();
+}
+
+void delay(unsigned long ms) {
+    if (hostClockVirtual) hostClockAdvance(ms);
+    else std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void hostClockSetVirtual(unsigned long startMs) {
+    hostClockVirtual = true;
+    hostVirtualUs = (uint64_t)startMs * 1000;
+}
+
+void hostClockAdvance(unsigned long ms) {
+    hostVirtualUs += (uint64_t)ms * 1000;
+}
+
+// Firmware state shared by the modules (defined in evcc_display_esp32.ino on the device)
+EVCCData data;
+RotationState rotationState;
+
+// Logging globals (logging.cpp on the device); there is no RTC memory to mirror into
+static LogEntry hostLogRing[LOG_BUFFER_SIZE];
+LogEntry* logBuffer = hostLogRing;
+int logCapacity = LOG_BUFFER_SIZE;
+int logHead = 0;
+int logCount = 0;
+bool debugEnabled = false;
+uint32_t logTotal = 0;
+uint32_t logOverwrites = 0;
+uint32_t logDropped = 0;
+uint32_t logCollapsed = 0;
+uint32_t logRateLimited = 0;
+portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED;
+
+void rtcLogMirror(uint32_t, const LogEntry&) {}
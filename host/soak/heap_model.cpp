@@ -0,0 +1,183 @@
+// heap_model.cpp - First-fit model of the ESP32 heap (see heap_model.h)
+#include "heap_model.h"
+#include <cstring>
+
+#define HEAP_HEADER 8       // size | used bit, previous block size
+#define HEAP_ALIGN 8        // the ESP32 heap aligns to 4; host code stores 8-byte pointers and doubles
+#define HEAP_MIN_BLOCK 16   // header + free-list link, rounded to the alignment
+#define HEAP_NONE 0xFFFFFFFFu
+
+static uint32_t blockNeed(size_t size) {
+    uint32_t need = (uint32_t)((size + HEAP_ALIGN - 1) & ~(size_t)(HEAP_ALIGN - 1)) + HEAP_HEADER;
+    return need < HEAP_MIN_BLOCK ? HEAP_MIN_BLOCK : need;
+}
+
+FirstFitHeap::FirstFitHeap(size_t size)
+    : arenaSize((uint32_t)size & ~(HEAP_ALIGN - 1)),
+      blockSite(arenaSize / HEAP_ALIGN),
+      blockCycle(arenaSize / HEAP_ALIGN) {
+    arena = new uint8_t[arenaSize];
+    sizeField(0) = arenaSize;
+    prevField(0) = 0;
+    nextFree(0) = HEAP_NONE;
+    freeHead = 0;
+    freeTotal = freeMin = arenaSize - HEAP_HEADER;
+}
+
+FirstFitHeap::~FirstFitHeap() {
+    delete[] arena;
+}
+
+void FirstFitHeap::setBlock(uint32_t off, uint32_t size, bool used) {
+    sizeField(off) = size | (used ? 1u : 0u);
+    if (off + size < arenaSize) prevField(off + size) = size;
+}
+
+uint32_t FirstFitHeap::freePredecessor(uint32_t off) const {
+    uint32_t pred = HEAP_NONE;
+    for (uint32_t f = freeHead; f != HEAP_NONE && f < off; f = nextFree(f)) pred = f;
+    return pred;
+}
+
+void FirstFitHeap::unlinkFree(uint32_t off, uint32_t pred) {
+    if (pred == HEAP_NONE) freeHead = nextFree(off);
+    else nextFree(pred) = nextFree(off);
+}
+
+void FirstFitHeap::markUsed(uint32_t off) {
+    blockSite[off / HEAP_ALIGN] = site;
+    blockCycle[off / HEAP_ALIGN] = cycle;
+}
+
+void FirstFitHeap::noteFree() {
+    if (freeTotal < freeMin) freeMin = freeTotal;
+}
+
+void* FirstFitHeap::alloc(size_t size) {
+    if (size >= arenaSize) {
+        failures++;
+        return nullptr;
+    }
+    uint32_t need = blockNeed(size);
+    uint32_t pred = HEAP_NONE;
+    uint32_t off = freeHead;
+    while (off != HEAP_NONE && blockSize(off) < need) {
+        pred = off;
+        off = nextFree(off);
+    }
+    if (off == HEAP_NONE) {
+        failures++;
+        return nullptr;
+    }
+    uint32_t size0 = blockSize(off);
+    if (size0 - need >= HEAP_MIN_BLOCK) {
+        // Take the low end; the remainder keeps the block's place in the free list
+        uint32_t rest = off + need;
+        nextFree(rest) = nextFree(off);
+        if (pred == HEAP_NONE) freeHead = rest;
+        else nextFree(pred) = rest;
+        setBlock(rest, size0 - need, false);
+        setBlock(off, need, true);
+        freeTotal -= need;
+    } else {
+        unlinkFree(off, pred);
+        setBlock(off, size0, true);
+        freeTotal -= size0 - HEAP_HEADER;
+    }
+    markUsed(off);
+    noteFree();
+    return arena + off + HEAP_HEADER;
+}
+
+void FirstFitHeap::free(void* p) {
+    uint32_t off = (uint32_t)((uint8_t*)p - arena) - HEAP_HEADER;
+    uint32_t size = blockSize(off);
+    freeTotal += size - HEAP_HEADER;
+
+    uint32_t pred = freePredecessor(off);
+    uint32_t cur;
+    if (pred != HEAP_NONE && pred + blockSize(pred) == off) {
+        setBlock(pred, blockSize(pred) + size, false);     // merge into the free block below
+        freeTotal += HEAP_HEADER;
+        cur = pred;
+    } else {
+        nextFree(off) = pred == HEAP_NONE ? freeHead : nextFree(pred);
+        if (pred == HEAP_NONE) freeHead = off;
+        else nextFree(pred) = off;
+        setBlock(off, size, false);
+        cur = off;
+    }
+    uint32_t next = cur + blockSize(cur);
+    if (next < arenaSize && !isUsed(next)) {
+        // A free block right above is also cur's successor in the address-ordered list
+        nextFree(cur) = nextFree(next);
+        setBlock(cur, blockSize(cur) + blockSize(next), false);
+        freeTotal += HEAP_HEADER;
+    }
+}
+
+void FirstFitHeap::splitUsed(uint32_t off, uint32_t need) {
+    uint32_t size = blockSize(off);
+    if (size - need < HEAP_MIN_BLOCK) return;
+    setBlock(off, need, true);
+    setBlock(off + need, size - need, true);
+    free(arena + off + need + HEAP_HEADER);
+}
+
+void* FirstFitHeap::realloc(void* p, size_t size) {
+    uint32_t off = (uint32_t)((uint8_t*)p - arena) - HEAP_HEADER;
+    uint32_t cur = blockSize(off);
+    uint32_t need = blockNeed(size);
+    if (need <= cur) {
+        splitUsed(off, need);
+        return p;
+    }
+    uint32_t next = off + cur;
+    if (next < arenaSize && !isUsed(next) && cur + blockSize(next) >= need) {
+        // Grow into the free block above
+        uint32_t nextSize = blockSize(next);
+        unlinkFree(next, freePredecessor(next));
+        freeTotal -= nextSize - HEAP_HEADER;
+        setBlock(off, cur + nextSize, true);
+        splitUsed(off, need);
+        noteFree();
+        return p;
+    }
+    void* q = alloc(size);
+    if (!q) return nullptr;
+    memcpy(q, p, cur - HEAP_HEADER);
+    free(p);
+    return q;
+}
+
+bool FirstFitHeap::owns(const void* p) const {
+    return p >= arena + HEAP_HEADER && p < arena + arenaSize;    // not the arena itself
+}
+
+size_t FirstFitHeap::usableSize(const void* p) const {
+    uint32_t off = (uint32_t)((const uint8_t*)p - arena) - HEAP_HEADER;
+    return blockSize(off) - HEAP_HEADER;
+}
+
+size_t FirstFitHeap::largestFreeBlock() const {
+    uint32_t largest = 0;
+    for (uint32_t f = freeHead; f != HEAP_NONE; f = nextFree(f)) {
+        if (blockSize(f) > largest) largest = blockSize(f);
+    }
+    return largest ? largest - HEAP_HEADER : 0;
+}
+
+size_t FirstFitHeap::freeBlockCount() const {
+    size_t n = 0;
+    for (uint32_t f = freeHead; f != HEAP_NONE; f = nextFree(f)) n++;
+    return n;
+}
+
+void FirstFitHeap::holes(std::vector<Hole>& out) const {
+    out.clear();
+    for (uint32_t f = freeHead; f != HEAP_NONE; f = nextFree(f)) {
+        uint32_t above = f + blockSize(f);
+        if (above >= arenaSize) continue;   // the free space at the top is not a hole
+        out.push_back({blockSize(f) - HEAP_HEADER, blockSite[above / HEAP_ALIGN], blockCycle[above / HEAP_ALIGN]});
+    }
+}
@@ -0,0 +1,69 @@
+// heap_model.h - First-fit model of the ESP32 heap for the soak harness
+//
+// Blocks live in a real byte arena, so the firmware code can use them: an 8-byte header
+// (size + used bit, previous block size) in front of an 8-byte aligned payload, free blocks
+// kept in an address-ordered list and allocated first-fit from their low end, neighbours
+// coalesced on free, realloc grown in place when the next block is free. Every block
+// remembers the call site and cycle that allocated it so holes can be traced to the
+// long-lived block pinning them.
+//
+// Object sizes are the host's (64-bit pointers make LVGL objects larger than on the device),
+// so absolute numbers run high; compare runs against each other.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "host_alloc.h"
+
+class FirstFitHeap : public HostHeap {
+public:
+    explicit FirstFitHeap(size_t size);
+    ~FirstFitHeap();
+
+    void* alloc(size_t size) override;
+    void* realloc(void* p, size_t size) override;
+    void free(void* p) override;
+    bool owns(const void* p) const override;
+    size_t usableSize(const void* p) const override;
+    size_t freeBytes() const override { return freeTotal; }
+    size_t largestFreeBlock() const override;
+    size_t minFreeBytes() const override { return freeMin; }
+
+    // Attribution for new blocks, set by the harness
+    uint16_t site = 0;
+    uint32_t cycle = 0;
+
+    uint64_t failures = 0;          // allocations that found no block
+    size_t freeBlockCount() const;
+
+    // A free block below a used one: it can only be reused by allocations that fit into it
+    struct Hole {
+        size_t size;                // payload bytes
+        uint16_t pinSite;           // site of the used block right above
+        uint32_t pinCycle;          // cycle that block was allocated in
+    };
+    void holes(std::vector<Hole>& out) const;
+
+private:
+    uint8_t* arena;
+    uint32_t arenaSize;
+    uint32_t freeHead;              // offset of the lowest free block, NONE if full
+    size_t freeTotal;
+    size_t freeMin;
+    std::vector<uint16_t> blockSite;    // indexed by block offset / HEAP_ALIGN
+    std::vector<uint32_t> blockCycle;
+
+    uint32_t& sizeField(uint32_t off) const { return *(uint32_t*)(arena + off); }
+    uint32_t& prevField(uint32_t off) const { return *(uint32_t*)(arena + off + 4); }
+    uint32_t& nextFree(uint32_t off) const { return *(uint32_t*)(arena + off + 8); }
+    uint32_t blockSize(uint32_t off) const { return sizeField(off) & ~1u; }
+    bool isUsed(uint32_t off) const { return sizeField(off) & 1u; }
+
+    void setBlock(uint32_t off, uint32_t size, bool used);
+    uint32_t freePredecessor(uint32_t off) const;   // last free block below off, NONE if none
+    void unlinkFree(uint32_t off, uint32_t pred);
+    void splitUsed(uint32_t off, uint32_t need);    // trailing remainder becomes a free block
+    void markUsed(uint32_t off);
+    void noteFree();
+};
@@ -0,0 +1,453 @@
+// soak_main.cpp - Heap fragmentation soak: months of polling against a model of the ESP32 heap
+//
+// Every cycle is one POLL_INTERVAL of the firmware on a virtual clock: the HTTP fetch, parse,
+// updateUI(), the /events delta, an LVGL refresh and the log lines of pollEVCCData(), plus
+// web requests served concurrently by the async_tcp task. The firmware
+// code is the real one; the network stack and web server objects it cannot run on the host
+// are modeled as allocations of their typical sizes and lifetimes. All of it is served by a
+// first-fit arena (heap_model.h) that reports free heap, largest free block and fragmentation
+// over time, and which allocation sites pin the holes that remain. LVGL allocates from its own
+// static pool, whose use and fragmentation are reported alongside ("ui" columns). The heap
+// health tracker (heap_health.h) samples the model like the device's loop() does; its trend is
+// the "trend" column, and restarts it would have performed are listed (the model heap is not
+// reset by them, only the tracker).
+//
+// Usage: pio run -e soak && .pio/build/soak/program [options], --help lists them. The default
+// is a month of polls on synthetic payloads; --capture replays /capture bodies instead, and
+// --callers refines the pinning sites to the allocating function. The --max-frag /
+// --min-largest gates make the exit status non-zero when they are exceeded. Object sizes are
+// the host's (heap_model.h), so compare runs rather than reading absolute bytes.
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <lvgl.h>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "clock.h"
+#include "config.h"
+#include "data_parser.h"
+#include "display_updates.h"
+#include "events.h"
+#include "headless.h"
+#include "heap_health.h"
+#include "heap_model.h"
+#include "logging.h"
+#include "ui_helpers.h"
+
+#define SOAK_CYCLES_PER_DAY (86400000UL / POLL_INTERVAL)
+
+// Allocation sites: the firmware stage that was running, optionally refined by caller
+enum SoakStage : uint16_t { STAGE_BOOT, STAGE_HTTP, STAGE_PARSE, STAGE_UI, STAGE_EVENTS, STAGE_RENDER, STAGE_LOG, STAGE_WEB, STAGE_COUNT };
+static const char* STAGE_NAMES[STAGE_COUNT] = {"boot", "http", "parse", "ui", "events", "render", "log", "web"};
+
+static std::vector<std::string> siteNames(STAGE_NAMES, STAGE_NAMES + STAGE_COUNT);
+static bool resolveCallers = false;
+
+// First frame below the allocator plumbing, as "<stage>/<function>"
+static bool isPlumbing(const std::string& fn) {
+    static const char* PREFIXES[] = {"__wrap_", "operator new", "operator+", "String::", "StringSumHelper",
+                                     "ArduinoJson", "lv_mem", "_lv_mem", "_lv_ll", "std::", "FirstFitHeap",
+                                     "SoakHeap", "malloc", "realloc", "calloc"};
+    for (const char* prefix : PREFIXES) {
+        if (fn.compare(0, strlen(prefix), prefix) == 0) return true;
+    }
+    return false;
+}
+
+static uint16_t callerSite(SoakStage stage) {
+    static std::unordered_map<uint64_t, uint16_t> cache;   // (return address, stage) -> site
+    void* frames[16];
+    int n = backtrace(frames, 16);
+    for (int i = 1; i < n; i++) {
+        uint64_t key = (uint64_t)(uintptr_t)frames[i] * STAGE_COUNT + stage;
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            if (it->second != UINT16_MAX) return it->second;
+            continue;
+        }
+        Dl_info info;
+        std::string fn;     // static functions have no dynamic symbol: treated as plumbing
+        if (dladdr(frames[i], &info) && info.dli_sname) {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            fn = status == 0 ? demangled : info.dli_sname;
+            ::free(demangled);
+        }
+        if (fn.empty() || isPlumbing(fn)) {
+            cache[key] = UINT16_MAX;
+            continue;
+        }
+        std::string name = std::string(STAGE_NAMES[stage]) + "/" + fn.substr(0, fn.find('('));
+        auto found = std::find(siteNames.begin(), siteNames.end(), name);
+        uint16_t site = (uint16_t)(found - siteNames.begin());
+        if (found == siteNames.end()) siteNames.push_back(name);
+        cache[key] = site;
+        return site;
+    }
+    return stage;
+}
+
+// Runs firmware code with its allocations served by the model heap, tagged with the stage
+static SoakStage currentStage = STAGE_BOOT;
+
+struct DeviceScope {
+    explicit DeviceScope(SoakStage stage) {
+        currentStage = stage;
+        hostAllocHeapActive(true);
+    }
+    ~DeviceScope() { hostAllocHeapActive(false); }
+};
+
+class SoakHeap : public FirstFitHeap {
+public:
+    using FirstFitHeap::FirstFitHeap;
+    void* alloc(size_t size) override {
+        site = resolveCallers ? callerSite(currentStage) : currentStage;
+        return FirstFitHeap::alloc(size);
+    }
+};
+
+// Payload source: a /capture download (looping) or a synthetic day
+static std::vector<std::string> captureBodies;
+
+static bool loadCapture(const char* path) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        DynamicJsonDocument doc(line.size() + 256);
+        if (deserializeJson(doc, line) || !doc["body"].is<const char*>() || (doc["truncated"] | false)) continue;
+        captureBodies.push_back(doc["body"].as<const char*>());
+    }
+    return !captureBodies.empty();
+}
+
+static std::string synthPayload(uint64_t cycle, std::mt19937& rng) {
+    std::uniform_real_distribution<float> noise(0.85f, 1.0f);
+    float hour = (float)(cycle % SOAK_CYCLES_PER_DAY) * 24.0f / SOAK_CYCLES_PER_DAY;
+    float pv = (hour > 6.5f && hour < 20.0f) ? 8200.0f * sinf(3.14159f * (hour - 6.5f) / 13.5f) * noise(rng) : 0.0f;
+    float home = 350.0f + 250.0f * (noise(rng) - 0.85f) / 0.15f + (hour >= 18 && hour < 20 ? 900.0f : 0.0f);
+    bool charging = hour >= 10 && hour < 15;
+    float charge = charging ? std::min(11000.0f, std::max(1400.0f, pv - home)) : 0.0f;
+    float battery = std::max(-3000.0f, std::min(3000.0f, home + charge - pv));
+    int soc = 40 + (int)(std::max(0.0f, std::min(hour, 15.0f) - 10.0f) * 9);
+    float amps = charge / 690.0f;
+    char buf[1400];
+    snprintf(buf, sizeof(buf),
+             "{\"gridPower\":%.1f,\"pvPower\":%.1f,\"batterySoc\":%d,\"homePower\":%.1f,\"batteryPower\":%.1f,"
+             "\"solar\":{\"scale\":0.94,\"todayEnergy\":38125.6},\"loadpoints\":["
+             "{\"chargePower\":%.1f,\"soc\":%d,\"charging\":%s,\"plugged\":true,\"title\":\"Garage\",\"vehicletitle\":\"ID.3\","
+             "\"vehicleRange\":%d,\"effectivePlanTime\":%s,\"effectivePlanSoc\":80,\"effectiveLimitSoc\":90,"
+             "\"planProjectedStart\":null,\"chargeCurrents\":[%.1f,%.1f,%.1f],\"maxCurrent\":16,\"offeredCurrent\":%.1f,"
+             "\"phasesActive\":%d,\"chargeRemainingDuration\":%d,\"chargedEnergy\":%.1f},"
+             "{\"chargePower\":0,\"soc\":41,\"charging\":false,\"plugged\":%s,\"title\":\"Carport\",\"vehicletitle\":\"Zoe\","
+             "\"vehicleRange\":132,\"effectivePlanTime\":null,\"effectivePlanSoc\":0,\"effectiveLimitSoc\":100,"
+             "\"planProjectedStart\":null,\"chargeCurrents\":[0,0,0],\"maxCurrent\":32,\"offeredCurrent\":0,"
+             "\"phasesActive\":0,\"chargeRemainingDuration\":0,\"chargedEnergy\":0}]}",
+             home + charge - pv - battery, pv, 20 + (int)(70 * std::max(0.0f, std::min(1.0f, (hour - 8) / 8))),
+             home, battery, charge, soc, charging ? "true" : "false", soc * 4,
+             hour < 6 ? "\"2026-10-18T05:00:00Z\"" : "null", amps, amps, amps, amps, charging ? 3 : 0,
+             charging ? (int)((15 - hour) * 3600) : 0, std::max(0.0f, std::min(hour, 15.0f) - 10.0f) * 7000.0f,
+             hour < 22 ? "true" : "false");
+    return buf;
+}
+
+// Network stack and web server objects, by typical ESP32 size (lwIP pbuf for a full segment,
+// AsyncTCP client, ESPAsyncWebServer request/response and header list entries)
+#define MODEL_PBUF 1600
+#define MODEL_TCP_SEGMENT 1436
+#define MODEL_WIFI_CLIENT 64
+#define MODEL_ASYNC_CLIENT 180
+#define MODEL_WEB_REQUEST 290
+#define MODEL_WEB_RESPONSE 140
+#define MODEL_WEB_HEADER 48         // list node + name/value Strings
+#define MODEL_WEB_HEADERS 6
+#define MODEL_STATUS_BYTES 2200     // /status body sent from the static buffer
+
+struct WebRequest {
+    std::vector<void*> blocks;
+    uint64_t closeStage;
+};
+
+// Called inside a DeviceScope: the block comes from the model heap, its bookkeeping does not
+static void* modelAlloc(std::vector<void*>& blocks, size_t size) {
+    void* p = malloc(size);
+    hostAllocHeapActive(false);
+    if (p) blocks.push_back(p);
+    hostAllocHeapActive(true);
+    return p;
+}
+
+static void modelFreeAll(std::vector<void*>& blocks) {
+    for (void* p : blocks) free(p);
+    blocks.clear();
+}
+
+// httpGet(): URL and request strings, client, TX/RX segments, then getString()
+static void modelHttpGet(const std::string& body, String& response) {
+    std::vector<void*> transient;
+    String url = String("http://") + "192.168.1.100" + ":" + String(7070) + String(EVCC_API_PATH);
+    String host("192.168.1.100");
+    String uri(EVCC_API_PATH);
+    modelAlloc(transient, MODEL_WIFI_CLIENT);
+    {
+        String request = "GET " + uri + " HTTP/1.1\r\nHost: " + host + "\r\nUser-Agent: ESP32HTTPClient\r\nConnection: close\r\n\r\n";
+        modelAlloc(transient, MODEL_PBUF);
+    }
+    for (size_t off = 0; off < body.size(); off += MODEL_TCP_SEGMENT) modelAlloc(transient, MODEL_PBUF);
+    String received;
+    received.concat(body.c_str(), body.size());
+    response = received;
+    modelFreeAll(transient);
+}
+
+struct SiteStats {
+    size_t holes = 0;
+    size_t bytes = 0;
+    size_t peakBytes = 0;
+    double ageSum = 0;
+};
+
+int main(int argc, char** argv) {
+    uint64_t cycles = 30 * SOAK_CYCLES_PER_DAY;
+    size_t heapSize = 200000;
+    uint64_t reportEvery = SOAK_CYCLES_PER_DAY;
+    const char* capturePath = nullptr;
+    unsigned seed = 1;
+    double webRate = 0.3;
+    uint32_t renderEvery = 1;
+    uint32_t pinAge = 3600000UL / POLL_INTERVAL;
+    double maxFrag = -1;
+    long minLargest = -1;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--cycles" && hasValue) cycles = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--heap" && hasValue) heapSize = strtoul(argv[++i], nullptr, 10);
+        else if (a == "--report-every" && hasValue) reportEvery = std::max(1ULL, strtoull(argv[++i], nullptr, 10));
+        else if (a == "--capture" && hasValue) capturePath = argv[++i];
+        else if (a == "--seed" && hasValue) seed = atoi(argv[++i]);
+        else if (a == "--web-rate" && hasValue) webRate = atof(argv[++i]);
+        else if (a == "--render-every" && hasValue) renderEvery = std::max(1, atoi(argv[++i]));
+        else if (a == "--pin-age" && hasValue) pinAge = atoi(argv[++i]);
+        else if (a == "--max-frag" && hasValue) maxFrag = atof(argv[++i]);
+        else if (a == "--min-largest" && hasValue) minLargest = atol(argv[++i]);
+        else if (a == "--callers") resolveCallers = true;
+        else {
+            fprintf(stderr, "usage: %s [--cycles N] [--heap BYTES] [--report-every N] [--capture FILE] [--seed N]\n"
+                            "       [--web-rate P] [--render-every N] [--pin-age CYCLES] [--callers]\n"
+                            "       [--max-frag PCT] [--min-largest BYTES]\n"
+                            "  --cycles N          polls to simulate (default 30 days)\n"
+                            "  --heap BYTES        model heap size (default 200000)\n"
+                            "  --report-every N    polls per report row (default one day)\n"
+                            "  --capture FILE      /capture NDJSON bodies instead of synthetic payloads\n"
+                            "  --seed N            random seed for payloads and web requests\n"
+                            "  --web-rate P        chance of a web request per poll (default 0.3)\n"
+                            "  --render-every N    LVGL refresh every N polls (default 1)\n"
+                            "  --pin-age CYCLES    age from which a block counts as pinning a hole (default 1 h)\n"
+                            "  --callers           attribute pinning blocks to the allocating function\n"
+                            "  --max-frag PCT      fail when fragmentation exceeds PCT\n"
+                            "  --min-largest BYTES fail when the largest free block drops below BYTES\n", argv[0]);
+            return 2;
+        }
+    }
+    if (capturePath && !loadCapture(capturePath)) {
+        fprintf(stderr, "%s: no usable capture records\n", capturePath);
+        return 1;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    setenv("TZ", TIMEZONE, 1);
+    tzset();
+    hostClockSetVirtual(0);
+    time_t epoch = 1790000000;  // any fixed start keeps runs comparable
+    headlessSetEpoch(epoch);
+
+    // Never deleted: globals such as data's Strings hold blocks of it until exit
+    SoakHeap& model = *new SoakHeap(heapSize);
+    hostAllocInstallHeap(&model);
+    {
+        DeviceScope scope(STAGE_BOOT);
+        headlessDisplayInit();
+        initStripeStyle();
+        createUI();
+        lv_timer_handler();
+    }
+    printf("heap %zu bytes, %zu free after UI creation; %llu cycles (%.1f days)\n\n", heapSize, model.freeBytes(),
+           (unsigned long long)cycles, (double)cycles / SOAK_CYCLES_PER_DAY);
+    printf("%7s %10s %9s %9s %6s %6s %9s %6s %9s %7s %9s\n", "day", "cycle", "free", "largest", "frag%", "holes",
+           "min free", "fails", "ui used", "ui frag", "trend B/h");
+
+    std::vector<WebRequest> web;
+    std::vector<FirstFitHeap::Hole> holes;
+    std::map<uint16_t, SiteStats> pinned;
+    uint64_t stage = 0;
+    size_t worstLargest = SIZE_MAX;
+    double worstFrag = 0;
+    const int STAGES_PER_CYCLE = 5;
+    const uint64_t HEALTH_EVERY = std::max(1UL, (unsigned long)(HEAP_SAMPLE_INTERVAL / POLL_INTERVAL));
+    uint32_t plannedRestarts = 0;
+
+    auto closeWeb = [&](bool all) {
+        for (size_t i = 0; i < web.size();) {
+            if (all || web[i].closeStage <= stage) {
+                modelFreeAll(web[i].blocks);
+                web[i] = std::move(web.back());
+                web.pop_back();
+            } else {
+                i++;
+            }
+        }
+    };
+    auto openWeb = [&]() {
+        WebRequest req;
+        DeviceScope scope(STAGE_WEB);
+        modelAlloc(req.blocks, MODEL_ASYNC_CLIENT);
+        modelAlloc(req.blocks, MODEL_WEB_REQUEST);
+        for (int h = 0; h < MODEL_WEB_HEADERS; h++) modelAlloc(req.blocks, MODEL_WEB_HEADER);
+        modelAlloc(req.blocks, MODEL_WEB_RESPONSE);
+        for (int s = 0; s < MODEL_STATUS_BYTES; s += MODEL_TCP_SEGMENT) modelAlloc(req.blocks, MODEL_PBUF);
+        hostAllocHeapActive(false);
+        req.closeStage = stage + 1 + rng() % (2 * STAGES_PER_CYCLE);
+        web.push_back(std::move(req));
+    };
+
+    for (uint64_t cycle = 1; cycle <= cycles; cycle++) {
+        model.cycle = (uint32_t)cycle;
+        hostClockAdvance(POLL_INTERVAL);
+        lv_tick_inc(POLL_INTERVAL);
+        epoch += POLL_INTERVAL / 1000;
+        headlessSetEpoch(epoch);
+        std::string body = captureBodies.empty() ? synthPayload(cycle, rng)
+                                                 : captureBodies[cycle % captureBodies.size()];
+        int webAt = uniform(rng) < webRate ? (int)(rng() % STAGES_PER_CYCLE) : -1;
+        auto nextStage = [&](int index) {
+            stage++;
+            closeWeb(false);
+            if (index == webAt) openWeb();
+        };
+
+        // pollEVCCData()
+        String response;
+        nextStage(0);
+        {
+            DeviceScope scope(STAGE_LOG);
+            LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, "Starting poll - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
+        }
+        {
+            DeviceScope scope(STAGE_HTTP);
+            response.reserve(2048);
+            modelHttpGet(body, response);
+        }
+        nextStage(1);
+        bool parsed;
+        {
+            DeviceScope scope(STAGE_PARSE);
+            parsed = parseCombinedData(response, data);
+        }
+        if (parsed) {
+            data.lastUpdate = clockMillis();
+            nextStage(2);
+            {
+                DeviceScope scope(STAGE_UI);
+                updateUI();
+            }
+            nextStage(3);
+            {
+                DeviceScope scope(STAGE_EVENTS);
+                eventsPublish(data);
+            }
+            DeviceScope scope(STAGE_UI);
+            updatePhaseHistory();
+        }
+        {
+            DeviceScope scope(STAGE_HTTP);
+            response = String();
+        }
+        nextStage(4);
+        if (cycle % renderEvery == 0) {
+            DeviceScope scope(STAGE_RENDER);
+            lv_timer_handler();
+        }
+
+        // loop(): heap health sample and planned restart
+        if (cycle % HEALTH_EVERY == 0) {
+            DeviceScope scope(STAGE_LOG);
+            heapHealthSample(ESP.getFreeHeap(), ESP.getMaxAllocHeap(), ESP.getMinFreeHeap(), epoch);
+            if (heapHealthRestartDue(epoch)) {
+                printf("  planned restart at day %.2f: largest block %u bytes, trend %.0f bytes/h\n",
+                       (double)cycle / SOAK_CYCLES_PER_DAY, (unsigned)heapHealth.last.largestBlock,
+                       heapHealth.largestTrend);
+                plannedRestarts++;
+                heapHealth = HeapHealth();
+            }
+        }
+
+        if (cycle % reportEvery == 0 || cycle == cycles) {
+            size_t freeBytes = model.freeBytes();
+            size_t largest = model.largestFreeBlock();
+            double frag = freeBytes ? 100.0 * (1.0 - (double)largest / freeBytes) : 100.0;
+            model.holes(holes);
+            lv_mem_monitor_t ui;
+            lv_mem_monitor(&ui);
+            printf("%7.2f %10llu %9zu %9zu %6.1f %6zu %9zu %6llu %9lu %6u%% %9.0f\n", (double)cycle / SOAK_CYCLES_PER_DAY,
+                   (unsigned long long)cycle, freeBytes, largest, frag, holes.size(), model.minFreeBytes(),
+                   (unsigned long long)model.failures, (unsigned long)(ui.total_size - ui.free_size), ui.frag_pct,
+                   heapHealth.largestTrend);
+            fflush(stdout);
+            worstLargest = std::min(worstLargest, largest);
+            worstFrag = std::max(worstFrag, frag);
+            for (auto& entry : pinned) {
+                entry.second.holes = entry.second.bytes = 0;
+                entry.second.ageSum = 0;
+            }
+            for (const FirstFitHeap::Hole& h : holes) {
+                uint32_t age = model.cycle - h.pinCycle;
+                if (age < pinAge) continue;
+                SiteStats& s = pinned[h.pinSite];
+                s.holes++;
+                s.bytes += h.size;
+                s.ageSum += age;
+            }
+            for (auto& entry : pinned) entry.second.peakBytes = std::max(entry.second.peakBytes, entry.second.bytes);
+        }
+    }
+    closeWeb(true);
+
+    std::vector<std::pair<uint16_t, SiteStats>> sites(pinned.begin(), pinned.end());
+    std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) { return a.second.peakBytes > b.second.peakBytes; });
+    printf("\nholes pinned by blocks older than %u cycles (%.1f h), by allocation site:\n", pinAge,
+           pinAge * (double)POLL_INTERVAL / 3600000.0);
+    printf("  %-40s %6s %9s %9s %9s\n", "site", "holes", "bytes", "peak", "avg age h");
+    for (const auto& entry : sites) {
+        const SiteStats& s = entry.second;
+        printf("  %-40s %6zu %9zu %9zu %9.1f\n", siteNames[entry.first].substr(0, 40).c_str(), s.holes, s.bytes,
+               s.peakBytes, s.holes ? s.ageSum / s.holes * POLL_INTERVAL / 3600000.0 : 0.0);
+    }
+    printf("\nworst: largest free block %zu bytes, fragmentation %.1f%%, minimum free %zu bytes, %llu failed allocations\n",
+           worstLargest, worstFrag, model.minFreeBytes(), (unsigned long long)model.failures);
+    printf("planned restarts: %u\n", plannedRestarts);
+
+    int status = 0;
+    if (maxFrag >= 0 && worstFrag > maxFrag) {
+        printf("FAIL: fragmentation %.1f%% > %.1f%%\n", worstFrag, maxFrag);
+        status = 1;
+    }
+    if (minLargest >= 0 && worstLargest < (size_t)minLargest) {
+        printf("FAIL: largest free block %zu < %ld bytes\n", worstLargest, minLargest);
+        status = 1;
+    }
+    if (model.failures) {
+        printf("FAIL: %llu allocations failed\n", (unsigned long long)model.failures);
+        status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,246 @@
+// timewarp_main.cpp - Checks the firmware's timing behaviour on a warped clock (pio run -e timewarp)
+//
+// Installs a ClockSource the checks move by hand and drives the loop() schedules, loadpoint
+// rotation, rate-limited logging, charge extrapolation and plan-time formatting through the
+// 49.7-day millis() wrap, both DST changes and a year end. Each check prints ok or FAIL with
+// the first violation; the exit status is the number of failed checks.
+#include <Arduino.h>
+#include <random>
+#include <vector>
+#include "clock.h"
+#include "config.h"
+#include "formatters.h"
+#include "logging.h"
+#include "rotation.h"
+#include "predict.h"
+
+static uint32_t warpMs = 0;
+static time_t warpEpoch = 0;
+
+static uint32_t warpMillis() { return warpMs; }
+static time_t warpTime() { return warpEpoch; }
+static const ClockSource warpClock = {warpMillis, warpTime};
+
+static void warpTo(uint32_t ms, time_t epoch) {
+    warpMs = ms;
+    warpEpoch = epoch;
+}
+
+static void warpAdvance(uint32_t ms) {
+    warpMs += ms;
+    // Whole seconds only, like the device's RTC between NTP syncs
+    static uint32_t carry = 0;
+    carry += ms;
+    warpEpoch += carry / 1000;
+    carry %= 1000;
+}
+
+static int failures = 0;
+
+static void report(const char* name, const String& problem) {
+    if (problem.isEmpty()) {
+        printf("ok    %s\n", name);
+    } else {
+        printf("FAIL  %s: %s\n", name, problem.c_str());
+        failures++;
+    }
+}
+
+// loop() schedules with a jittery loop period: every interval is kept, none fires early, and
+// none fires twice around the wrap
+static String checkSchedules() {
+    std::mt19937 rng(7);
+    static const uint32_t INTERVALS[] = {5, 1000, POLL_INTERVAL, 30000};
+    const uint32_t maxStep = 40;
+    for (uint32_t interval : INTERVALS) {
+        warpTo(0xFFFFFFFFu - 3 * POLL_INTERVAL, 1790000000);
+        uint32_t last = clockMillis();
+        uint64_t virtualMs = 0, lastFire = 0;
+        uint32_t fired = 0;
+        while (virtualMs < 6 * (uint64_t)POLL_INTERVAL + 3 * interval) {
+            uint32_t step = 1 + rng() % maxStep;
+            warpAdvance(step);
+            virtualMs += step;
+            if (!clockDue(last, interval)) continue;
+            uint64_t gap = virtualMs - lastFire;
+            if (gap < interval || gap >= interval + maxStep) {
+                return "interval " + String(interval) + " ms fired after " + String((unsigned long)gap) +
+                       " ms at millis " + String(clockMillis());
+            }
+            lastFire = virtualMs;
+            fired++;
+        }
+        uint32_t expected = virtualMs / (interval + maxStep);
+        if (fired < expected) return "interval " + String(interval) + " ms fired " + String(fired) + " times";
+    }
+    return "";
+}
+
+// Rotation flips every ROTATION_INTERVAL across the wrap, and loadpointRotationDue() predicts it
+static String checkRotation() {
+    data.lp1.charging = data.lp2.charging = false;
+    warpTo(0xFFFFFFFFu - ROTATION_INTERVAL / 2, 1790000000);
+    rotationState.lastRotation = clockMillis();
+    bool current = getActiveLoadpoint() == &data.lp1;
+    uint32_t sinceFlip = 0;
+    for (uint32_t t = 0; t < 5 * ROTATION_INTERVAL; t += 100) {
+        warpAdvance(100);
+        sinceFlip += 100;
+        bool due = loadpointRotationDue();
+        bool now = getActiveLoadpoint() == &data.lp1;
+        if (due != (now != current)) return "loadpointRotationDue() disagrees at millis " + String(clockMillis());
+        if (now != current) {
+            if (sinceFlip != ROTATION_INTERVAL) return "flipped after " + String(sinceFlip) + " ms";
+            sinceFlip = 0;
+            current = now;
+        }
+    }
+    return "";
+}
+
+// LOG_RATE_LIMITED lets one message through per interval across the wrap
+static String checkRateLimitedLog() {
+    warpTo(0xFFFFFFFFu - 150000, 1790000000);
+    uint32_t before = logTotal;
+    for (int i = 0; i < 600; i++) {
+        LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, "poll " + String(i));
+        warpAdvance(1000);
+    }
+    uint32_t logged = logTotal - before;
+    if (logged != 10) return String(logged) + " messages in 600 s with a 60 s limit";
+    return "";
+}
+
+// Between-poll extrapolation across the wrap: the countdown and SoC move monotonically at the
+// charge rate, and a poll with slightly different values blends in without a jump
+static String checkPrediction() {
+    LoadpointData lp;
+    lp.charging = true;
+    lp.soc = 50;
+    lp.chargePower = 11000;
+    lp.vehicleCapacity = 55;
+    lp.chargedEnergy = 2000;
+    lp.chargeRemainingDuration = 3600;
+    ChargePrediction p;
+    warpTo(0xFFFFFFFFu - 30000, 1790000000);
+    predictUpdate(p, lp, clockMillis());
+    float lastSoc = p.soc;
+    int lastRemaining = p.remaining;
+    for (int i = 0; i < 60; i++) {
+        warpAdvance(1000);
+        predictUpdate(p, lp, clockMillis());
+        if (p.soc < lastSoc || p.remaining > lastRemaining) return "went backwards at millis " + String(clockMillis());
+        lastSoc = p.soc;
+        lastRemaining = p.remaining;
+    }
+    // 11 kW for 60 s into 55 kWh: +0.33 %, +183 Wh, -60 s
+    if (fabs(p.soc - 50.333f) > 0.01f || fabs(p.chargedEnergy - 2183.3f) > 0.5f || p.remaining != 3540) {
+        return "after 60 s: soc " + String(p.soc, 3) + ", energy " + String(p.chargedEnergy, 1) + ", remaining " +
+               String(p.remaining);
+    }
+    // EVCC reports a little less progress: no jump now, its values (extrapolated) once faded in
+    lp.soc = 50.2;
+    lp.chargedEnergy = 2150;
+    lp.chargeRemainingDuration = 3600;
+    float shownSoc = p.soc;
+    predictUpdate(p, lp, clockMillis());
+    if (fabs(p.soc - shownSoc) > 0.001f) return "soc jumped from " + String(shownSoc, 3) + " to " + String(p.soc, 3);
+    warpAdvance(PREDICT_RECONCILE_MS);
+    predictUpdate(p, lp, clockMillis());
+    float expected = 50.2f + 11000.0f * PREDICT_RECONCILE_MS / 1000 / 3600 / (55 * 10.0f);
+    if (fabs(p.soc - expected) > 0.001f) return "soc " + String(p.soc, 3) + " after reconciling, expected " + String(expected, 3);
+    return "";
+}
+
+// Plan times: the target's own UTC offset and day differences across months and years
+struct PlanCase {
+    const char* now;        // local wall time "YYYY-MM-DD HH:MM" (Europe/Berlin)
+    const char* plan;       // EVCC effectivePlanTime (UTC)
+    const char* expected;
+};
+
+static time_t localEpoch(const char* text) {
+    struct tm t = {};
+    sscanf(text, "%d-%d-%d %d:%d", &t.tm_year, &t.tm_mon, &t.tm_mday, &t.tm_hour, &t.tm_min);
+    t.tm_year -= 1900;
+    t.tm_mon -= 1;
+    t.tm_isdst = -1;
+    return mktime(&t);
+}
+
+static String checkPlanTimes() {
+    static const PlanCase CASES[] = {
+        {"2026-10-19 10:00", "2026-10-19T15:00:00Z", "Heute 17:00"},
+        {"2026-10-19 10:00", "2026-10-22T05:00:00Z", "Donnerstag 07:00"},
+        {"2026-10-19 10:00", "2026-11-02T06:00:00Z", "2.11. 07:00"},
+        {"2026-03-28 21:00", "2026-03-29T05:00:00Z", "Morgen 07:00"},     // spring forward in between
+        {"2026-03-29 01:30", "2026-03-29T02:30:00Z", "Heute 04:30"},      // 02:00-03:00 does not exist
+        {"2026-10-24 21:00", "2026-10-25T06:00:00Z", "Morgen 07:00"},     // fall back in between
+        {"2026-10-25 02:30", "2026-10-25T01:30:00Z", "Heute 02:30"},      // second 02:30 (CET)
+        {"2026-12-31 20:00", "2026-12-31T23:30:00Z", "Morgen 00:30"},     // year end
+        {"2026-12-30 08:00", "2027-01-02T07:00:00Z", "Samstag 08:00"},
+        {"2028-02-28 12:00", "2028-02-29T23:15:00Z", "Mittwoch 00:15"},   // leap day
+        {"2026-10-19 10:00", "", "keiner"},
+    };
+    for (const PlanCase& c : CASES) {
+        warpTo(0, localEpoch(c.now));
+        String got = formatPlanTime(c.plan);
+        if (got != c.expected) {
+            return String(c.plan) + " at " + c.now + ": \"" + got + "\", expected \"" + c.expected + "\"";
+        }
+    }
+    return "";
+}
+
+// clockFromUtc() against known epochs, including the millennium and leap years
+static String checkCalendar() {
+    struct { int y, mo, d, h, mi, s; time_t epoch; } CASES[] = {
+        {1970, 1, 1, 0, 0, 0, 0},
+        {2000, 2, 29, 12, 0, 0, 951825600},
+        {2000, 3, 1, 0, 0, 0, 951868800},
+        {2026, 1, 1, 0, 0, 0, 1767225600},
+        {2038, 1, 19, 3, 14, 7, 2147483647},
+        {2100, 3, 1, 0, 0, 0, 4107542400},
+    };
+    for (const auto& c : CASES) {
+        time_t got = clockFromUtc(c.y, c.mo, c.d, c.h, c.mi, c.s);
+        if (got != c.epoch) {
+            return String(c.y) + "-" + String(c.mo) + "-" + String(c.d) + ": " + String((long)got) + ", expected " +
+                   String((long)c.epoch);
+        }
+    }
+    return "";
+}
+
+// clockParseIso() with the offsets EVCC's tariff slots carry
+static String checkIsoTimes() {
+    struct { const char* iso; time_t epoch; } CASES[] = {
+        {"2026-10-17T13:00:00Z", 1792242000},
+        {"2026-10-17T15:00:00+02:00", 1792242000},
+        {"2026-10-17T15:00:00.000+02:00", 1792242000},
+        {"2026-10-17T08:30:00-04:30", 1792242000},
+        {"2026-10-25T02:30:00+01:00", 1792891800},  // second 02:30 (CET)
+        {"2026-10-17", 0},
+    };
+    for (const auto& c : CASES) {
+        time_t got = clockParseIso(c.iso);
+        if (got != c.epoch) return String(c.iso) + ": " + String((long)got) + ", expected " + String((long)c.epoch);
+    }
+    return "";
+}
+
+int main() {
+    setenv("TZ", TIMEZONE, 1);
+    tzset();
+    clockInstall(&warpClock);
+
+    report("schedules across the millis() wrap", checkSchedules());
+    report("loadpoint rotation across the millis() wrap", checkRotation());
+    report("rate-limited logging across the millis() wrap", checkRateLimitedLog());
+    report("charge extrapolation across the millis() wrap", checkPrediction());
+    report("plan times across DST changes and year ends", checkPlanTimes());
+    report("UTC calendar conversion", checkCalendar());
+    report("ISO 8601 timestamps with offsets", checkIsoTimes());
+    printf("\n%d failed\n", failures);
+    return failures;
+}
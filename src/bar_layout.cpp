@@ -0,0 +1,20 @@
+// bar_layout.cpp - Composite bar geometry
+#include "bar_layout.h"
+
+bool compositeBarLayout(const float* values, int count, int barWidth, BarSegmentLayout* out) {
+    float totalPower = 0;
+    for (int i = 0; i < count; i++) if (values[i] > 0) totalPower += values[i];
+    if (totalPower < 1.0f) return false;
+    int currentX = 0;
+    for (int i = 0; i < count; i++) {
+        out[i].x = currentX;
+        out[i].width = 0;
+        if (values[i] > 0) {
+            int segmentWidth = (int)((values[i] / totalPower) * barWidth);
+            if (segmentWidth < 1) segmentWidth = 1;
+            out[i].width = segmentWidth;
+            currentX += segmentWidth;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,11 @@
+// bar_layout.h - Composite bar geometry (pure math, shared by the UI and the native benchmarks)
+#pragma once
+
+struct BarSegmentLayout {
+    int x;          // offset from the bar's left edge
+    int width;      // 0 = segment hidden (value not positive)
+};
+
+// Split barWidth proportionally between the positive values, left to right. Returns false
+// when the total is below 1 W and the whole bar should be hidden.
+bool compositeBarLayout(const float* values, int count, int barWidth, BarSegmentLayout* out);
@@ -0,0 +1,72 @@
+// boot_profile.cpp - RTC-resident ring of boot phase profiles
+#include "boot_profile.h"
+#include "logging.h"
+
+#define BOOT_PROFILE_MAGIC 0x424F4F54UL // "BOOT"
+
+struct BootProfileStore {
+    uint32_t magic;
+    uint32_t head;      // slot of the current boot
+    BootProfile profiles[BOOT_PROFILE_HISTORY];
+};
+
+RTC_NOINIT_ATTR static BootProfileStore rtcBootProfiles;
+static bool bootProfileReady = false;
+
+static uint32_t profileChecksum(const BootProfile& p) { return fnv1a(&p, offsetof(BootProfile, checksum)); }
+
+static bool profileValid(const BootProfile& p) { return p.boot != 0 && p.checksum == profileChecksum(p); }
+
+void bootProfileBegin() {
+    BootProfileStore& s = rtcBootProfiles;
+    if (s.magic != BOOT_PROFILE_MAGIC || s.head >= BOOT_PROFILE_HISTORY) {
+        memset(&s, 0, sizeof(s));
+        s.magic = BOOT_PROFILE_MAGIC;
+        s.head = BOOT_PROFILE_HISTORY - 1;
+    }
+    s.head = (s.head + 1) % BOOT_PROFILE_HISTORY;
+    BootProfile& cur = s.profiles[s.head];
+    memset(&cur, 0, sizeof(cur));
+    cur.boot = rtcLogBoot();
+    cur.checksum = profileChecksum(cur);
+    bootProfileReady = true;
+}
+
+void bootPhaseDone(BootPhase phase) {
+    if (!bootProfileReady || phase >= BOOT_PHASE_COUNT) return;
+    BootProfile& cur = rtcBootProfiles.profiles[rtcBootProfiles.head];
+    BootPhaseMark& mark = cur.phases[phase];
+    if (mark.us != 0) return;
+    mark.us = (uint32_t)micros();
+    mark.freeHeap = ESP.getFreeHeap();
+    cur.checksum = profileChecksum(cur);
+    char msg[80];
+    snprintf(msg, sizeof(msg), "Boot phase %s at %lu.%03lu ms - Free heap: %lu bytes", bootPhaseName(phase),
+             (unsigned long)(mark.us / 1000), (unsigned long)(mark.us % 1000), (unsigned long)mark.freeHeap);
+    logMessage(String(msg));
+}
+
+int bootProfileHistory(BootProfile* out, int maxProfiles) {
+    if (!bootProfileReady) return 0;
+    int n = 0;
+    for (int i = 1; i <= BOOT_PROFILE_HISTORY && n < maxProfiles; i++) {
+        const BootProfile& p = rtcBootProfiles.profiles[(rtcBootProfiles.head + i) % BOOT_PROFILE_HISTORY];
+        if (profileValid(p)) out[n++] = p;
+    }
+    return n;
+}
+
+const BootProfile& bootProfileCurrent() { return rtcBootProfiles.profiles[rtcBootProfiles.head]; }
+
+const char* bootPhaseName(BootPhase phase) {
+    switch (phase) {
+        case BOOT_PHASE_DISPLAY:     return "display";
+        case BOOT_PHASE_LVGL:        return "lvgl";
+        case BOOT_PHASE_UI:          return "ui";
+        case BOOT_PHASE_FIRST_FLUSH: return "first_flush";
+        case BOOT_PHASE_WIFI:        return "wifi";
+        case BOOT_PHASE_NTP:         return "ntp";
+        case BOOT_PHASE_FIRST_HTTP:  return "first_http";
+        default:                     return "unknown";
+    }
+}
@@ -0,0 +1,41 @@
+// boot_profile.h - Boot phase timings with heap at each boundary, kept for the last boots
+//
+// Each phase is stamped once with micros() since reset and the free heap at that moment. The
+// phases overlap since WiFi associates while the display comes up, so the stamps are absolute
+// rather than durations. Profiles live in RTC memory (like the reset history in logging.cpp)
+// and appear in /status ("bootProfiles") and /metrics.
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+enum BootPhase : uint8_t {
+    BOOT_PHASE_DISPLAY,     // TFT init and backlight
+    BOOT_PHASE_LVGL,        // lv_init, draw buffer, display driver
+    BOOT_PHASE_UI,          // createUI() and the initial updateUI()
+    BOOT_PHASE_FIRST_FLUSH, // first frame pushed to the display
+    BOOT_PHASE_WIFI,        // associated, IP assigned
+    BOOT_PHASE_NTP,         // first time sync
+    BOOT_PHASE_FIRST_HTTP,  // first successful EVCC fetch
+    BOOT_PHASE_COUNT
+};
+
+struct BootPhaseMark {
+    uint32_t us;        // micros() since reset when the phase completed, 0 = not reached
+    uint32_t freeHeap;
+};
+
+struct BootProfile {
+    uint32_t boot;      // boot counter shared with the reset history
+    BootPhaseMark phases[BOOT_PHASE_COUNT];
+    uint32_t checksum;
+};
+
+// Opens this boot's profile; call after logRestoreFromRtc()
+void bootProfileBegin();
+// Stamps `phase` (first call only) and logs its time and heap
+void bootPhaseDone(BootPhase phase);
+// Profiles oldest first, the current boot last
+int bootProfileHistory(BootProfile* out, int maxProfiles);
+const BootProfile& bootProfileCurrent();
+const char* bootPhaseName(BootPhase phase);
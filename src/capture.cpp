@@ -0,0 +1,293 @@
+// capture.cpp - Ring of recent raw EVCC responses, delta-encoded in a fixed RAM budget
+//
+// Consecutive responses differ in a few numbers, so most records are stored as a delta
+// against the previous body: COPY runs taken from the previous body and LITERAL runs of new
+// bytes. Every CAPTURE_KEYFRAME_INTERVAL records (and whenever the chain would break) the body
+// is stored raw. Eviction drops whole chains, so the ring always starts at a keyframe.
+//
+// Op stream: varint(len << 1 | isCopy), then for COPY varint(zigzag(skip)) where skip moves
+// the read position in the previous body, for LITERAL `len` raw bytes.
+#include "capture.h"
+#include "clock.h"
+#include "mem_policy.h"
+
+#define CAPTURE_HEADER_SIZE sizeof(CaptureHeader)
+#define CAPTURE_MIN_MATCH 4       // shorter matches cost more than the literal bytes
+#define CAPTURE_SYNC_BACK 32      // resync search window in the previous body, behind ...
+#define CAPTURE_SYNC_AHEAD 96     // ... and ahead of the expected position
+
+struct CaptureHeader {
+    uint32_t seq;
+    uint32_t ms;
+    uint32_t epoch;
+    uint16_t rawLen;
+    uint16_t encLen;
+    uint8_t keyframe;
+    uint8_t truncated;
+    uint8_t reserved[2];
+};
+
+static_assert(CAPTURE_BUFFER_SIZE >= sizeof(CaptureHeader) + CAPTURE_MAX_PAYLOAD, "capture ring must hold one keyframe");
+// Virtual offsets wrap at 2^32, which only a power-of-two ring size follows
+static_assert((CAPTURE_BUFFER_SIZE & (CAPTURE_BUFFER_SIZE - 1)) == 0, "capture ring size must be a power of two");
+static_assert((CAPTURE_BUFFER_SIZE_PSRAM & (CAPTURE_BUFFER_SIZE_PSRAM - 1)) == 0, "capture ring size must be a power of two");
+
+static uint8_t* capRing = nullptr;  // captureInit()
+static uint32_t capSize = 0;
+static uint32_t capHead = 0;      // virtual offset of the next record
+static uint32_t capTail = 0;      // virtual offset of the oldest record (always a keyframe)
+static uint32_t capSeq = 0;
+static uint32_t capRecords = 0;
+static uint32_t capRawBytes = 0;
+static portMUX_TYPE capMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Writer state (loop task only)
+static uint8_t capPrev[CAPTURE_MAX_PAYLOAD];
+static uint16_t capPrevLen = 0;
+static uint8_t capEnc[CAPTURE_MAX_PAYLOAD];
+static uint32_t capSinceKeyframe = 0;
+
+static void ringWrite(uint32_t v, const void* src, size_t n) {
+    const uint8_t* s = (const uint8_t*)src;
+    size_t off = v % capSize;
+    size_t first = n < capSize - off ? n : capSize - off;
+    memcpy(capRing + off, s, first);
+    memcpy(capRing, s + first, n - first);
+}
+
+static void ringRead(uint32_t v, void* dst, size_t n) {
+    uint8_t* d = (uint8_t*)dst;
+    size_t off = v % capSize;
+    size_t first = n < capSize - off ? n : capSize - off;
+    memcpy(d, capRing + off, first);
+    memcpy(d + first, capRing, n - first);
+}
+
+static size_t putVarint(uint8_t* out, size_t pos, size_t cap, uint32_t v) {
+    do {
+        if (pos >= cap) return SIZE_MAX;
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        out[pos++] = v ? (b | 0x80) : b;
+    } while (v);
+    return pos;
+}
+
+static bool getVarint(const uint8_t* in, size_t& pos, size_t len, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= len) return false;
+        uint8_t b = in[pos++];
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static size_t matchLen(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen) {
+    size_t n = 0;
+    while (n < aLen && n < bLen && a[n] == b[n]) n++;
+    return n;
+}
+
+// Emit pending literal bytes; SIZE_MAX if out is full
+static size_t flushLiteral(uint8_t* out, size_t pos, size_t cap, const uint8_t* lit, size_t n) {
+    if (n == 0) return pos;
+    pos = putVarint(out, pos, cap, (uint32_t)n << 1);
+    if (pos == SIZE_MAX || pos + n > cap) return SIZE_MAX;
+    memcpy(out + pos, lit, n);
+    return pos + n;
+}
+
+// Delta-encode cur against prev; returns the encoded size, or 0 if it is not smaller than cur
+static size_t encodeDelta(const uint8_t* prev, size_t prevLen, const uint8_t* cur, size_t curLen, uint8_t* out, size_t cap) {
+    if (cap > curLen) cap = curLen; // only worth it when smaller than a keyframe
+    size_t pos = 0;
+    size_t i = 0, j = 0;            // position in cur / expected position in prev
+    size_t readPos = 0;             // decoder's read position in prev
+    size_t litStart = 0;
+    while (i < curLen) {
+        size_t m = j < prevLen ? matchLen(cur + i, curLen - i, prev + j, prevLen - j) : 0;
+        if (m < CAPTURE_MIN_MATCH) {
+            // Look for the nearest place in prev where cur continues (numbers change width)
+            size_t lo = j > CAPTURE_SYNC_BACK ? j - CAPTURE_SYNC_BACK : 0;
+            size_t hi = j + CAPTURE_SYNC_AHEAD < prevLen ? j + CAPTURE_SYNC_AHEAD : prevLen;
+            size_t best = SIZE_MAX;
+            for (size_t p = lo; p < hi; p++) {
+                if (matchLen(cur + i, curLen - i, prev + p, prevLen - p) >= CAPTURE_MIN_MATCH &&
+                    (best == SIZE_MAX || (p > j ? p - j : j - p) < (best > j ? best - j : j - best))) {
+                    best = p;
+                }
+            }
+            if (best == SIZE_MAX) { i++; j++; continue; } // literal byte
+            j = best;
+            m = matchLen(cur + i, curLen - i, prev + j, prevLen - j);
+        }
+        pos = flushLiteral(out, pos, cap, cur + litStart, i - litStart);
+        if (pos == SIZE_MAX) return 0;
+        pos = putVarint(out, pos, cap, ((uint32_t)m << 1) | 1);
+        if (pos == SIZE_MAX) return 0;
+        int32_t skip = (int32_t)j - (int32_t)readPos;
+        pos = putVarint(out, pos, cap, ((uint32_t)skip << 1) ^ (uint32_t)(skip >> 31));
+        if (pos == SIZE_MAX) return 0;
+        i += m;
+        j += m;
+        readPos = j;
+        litStart = i;
+    }
+    pos = flushLiteral(out, pos, cap, cur + litStart, i - litStart);
+    return (pos == SIZE_MAX || pos >= curLen) ? 0 : pos;
+}
+
+static bool decodeDelta(const uint8_t* prev, size_t prevLen, const uint8_t* in, size_t inLen, uint8_t* out, size_t outLen) {
+    size_t pos = 0, o = 0, readPos = 0;
+    while (pos < inLen) {
+        uint32_t op;
+        if (!getVarint(in, pos, inLen, op)) return false;
+        size_t n = op >> 1;
+        if (o + n > outLen) return false;
+        if (op & 1) {
+            uint32_t zz;
+            if (!getVarint(in, pos, inLen, zz)) return false;
+            int32_t skip = (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1);
+            readPos += skip;
+            if (readPos > prevLen || n > prevLen - readPos) return false;
+            memcpy(out + o, prev + readPos, n);
+            readPos += n;
+        } else {
+            if (n > inLen - pos) return false;
+            memcpy(out + o, in + pos, n);
+            pos += n;
+        }
+        o += n;
+    }
+    return o == outLen;
+}
+
+// Drop the oldest record; caller holds capMux
+static void evictOldest() {
+    CaptureHeader h;
+    ringRead(capTail, &h, CAPTURE_HEADER_SIZE);
+    capTail += CAPTURE_HEADER_SIZE + h.encLen;
+    capRecords--;
+    capRawBytes -= h.rawLen;
+}
+
+static bool keyframeAtTail() {
+    CaptureHeader h;
+    ringRead(capTail, &h, CAPTURE_HEADER_SIZE);
+    return h.keyframe;
+}
+
+void captureInit() {
+    capSize = memPsramAvailable() ? CAPTURE_BUFFER_SIZE_PSRAM : CAPTURE_BUFFER_SIZE;
+    capRing = (uint8_t*)memAllocLarge("capture ring", capSize);
+    if (!capRing && capSize != CAPTURE_BUFFER_SIZE) {
+        capSize = CAPTURE_BUFFER_SIZE;
+        capRing = (uint8_t*)memAllocLarge("capture ring", capSize);
+    }
+    if (!capRing) capSize = 0;
+}
+
+void captureRecord(const String& payload) {
+    if (!capRing) return;
+    size_t len = payload.length();
+    bool truncated = len > CAPTURE_MAX_PAYLOAD;
+    if (truncated) len = CAPTURE_MAX_PAYLOAD;
+    const uint8_t* body = (const uint8_t*)payload.c_str();
+
+    CaptureHeader h = {};
+    h.seq = capSeq++;
+    h.ms = clockMillis();
+    h.epoch = (uint32_t)clockEpoch();
+    h.rawLen = len;
+    h.truncated = truncated;
+    size_t encLen = 0;
+    if (capPrevLen > 0 && capSinceKeyframe < CAPTURE_KEYFRAME_INTERVAL) {
+        encLen = encodeDelta(capPrev, capPrevLen, body, len, capEnc, sizeof(capEnc));
+    }
+
+    portENTER_CRITICAL(&capMux);
+    size_t need = CAPTURE_HEADER_SIZE + (encLen ? encLen : len);
+    while (capSize - (capHead - capTail) < need) evictOldest();
+    while (capTail != capHead && !keyframeAtTail()) evictOldest(); // keep whole chains only
+    if (capTail == capHead && encLen) {
+        // The record this delta refers to is gone; store a keyframe instead
+        encLen = 0;
+        need = CAPTURE_HEADER_SIZE + len;
+    }
+    portEXIT_CRITICAL(&capMux);
+
+    // The space past capHead is not visible to readers until capHead moves
+    h.keyframe = encLen == 0;
+    h.encLen = encLen ? encLen : len;
+    ringWrite(capHead, &h, CAPTURE_HEADER_SIZE);
+    ringWrite(capHead + CAPTURE_HEADER_SIZE, encLen ? capEnc : body, h.encLen);
+    capSinceKeyframe = h.keyframe ? 1 : capSinceKeyframe + 1;
+    memcpy(capPrev, body, len);
+    capPrevLen = len;
+
+    portENTER_CRITICAL(&capMux);
+    capHead += need;
+    capRecords++;
+    capRawBytes += len;
+    portEXIT_CRITICAL(&capMux);
+}
+
+void captureGetStats(CaptureStats& out) {
+    portENTER_CRITICAL(&capMux);
+    out.records = capRecords;
+    out.bytesUsed = capHead - capTail;
+    out.rawBytes = capRawBytes;
+    out.recorded = capSeq;
+    portEXIT_CRITICAL(&capMux);
+}
+
+CaptureReader::CaptureReader() {
+    portENTER_CRITICAL(&capMux);
+    pos = capTail;
+    portEXIT_CRITICAL(&capMux);
+    enc = (uint8_t*)memAllocLarge("capture reader", 3 * CAPTURE_MAX_PAYLOAD);
+    prev = enc ? enc + CAPTURE_MAX_PAYLOAD : nullptr;
+    cur = enc ? enc + 2 * CAPTURE_MAX_PAYLOAD : nullptr;
+}
+
+CaptureReader::~CaptureReader() {
+    free(enc);  // prev and cur share its allocation
+}
+
+bool CaptureReader::next(CaptureInfo& info, const char*& body) {
+    while (true) {
+        CaptureHeader h;
+        portENTER_CRITICAL(&capMux);
+        if ((int32_t)(pos - capTail) < 0) {
+            pos = capTail;      // overtaken by the writer: resume at the oldest keyframe
+            synced = false;
+        }
+        bool more = pos != capHead;
+        if (more) {
+            ringRead(pos, &h, CAPTURE_HEADER_SIZE);
+            ringRead(pos + CAPTURE_HEADER_SIZE, enc, h.encLen);
+            pos += CAPTURE_HEADER_SIZE + h.encLen;
+        }
+        portEXIT_CRITICAL(&capMux);
+        if (!more) return false;
+
+        if (h.keyframe) {
+            memcpy(cur, enc, h.rawLen);
+        } else if (!synced || !decodeDelta(prev, prevLen, enc, h.encLen, cur, h.rawLen)) {
+            synced = false;     // skip to the next keyframe
+            continue;
+        }
+        synced = true;
+        uint8_t* t = prev; prev = cur; cur = t;
+        prevLen = h.rawLen;
+        info.seq = h.seq;
+        info.ms = h.ms;
+        info.epoch = h.epoch;
+        info.len = h.rawLen;
+        info.truncated = h.truncated;
+        body = (const char*)prev;
+        return true;
+    }
+}
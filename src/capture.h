@@ -0,0 +1,49 @@
+// capture.h - Ring of recent raw EVCC responses, delta-encoded in a fixed RAM budget (/capture)
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+// Allocates the ring (CAPTURE_BUFFER_SIZE_PSRAM on boards with PSRAM); once in setup()
+void captureInit();
+
+// Record one response body (loop task). Bodies longer than CAPTURE_MAX_PAYLOAD are truncated.
+void captureRecord(const String& payload);
+
+struct CaptureInfo {
+    uint32_t seq;       // capture sequence number (gaps = evicted or never kept)
+    uint32_t ms;        // clockMillis() when recorded
+    uint32_t epoch;     // wall clock (0 if not synced yet)
+    uint16_t len;       // decoded body length
+    bool truncated;
+};
+
+struct CaptureStats {
+    uint32_t records;   // currently held
+    uint32_t bytesUsed; // encoded size in the ring
+    uint32_t rawBytes;  // decoded size of the held records
+    uint32_t recorded;  // total since boot
+};
+void captureGetStats(CaptureStats& out);
+
+// Decodes the ring oldest-first for /capture (async_tcp task). Holds three payload-sized
+// work buffers; check ok() after construction. Records evicted while reading are skipped,
+// decoding resumes at the next keyframe.
+class CaptureReader {
+public:
+    CaptureReader();
+    ~CaptureReader();
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    bool ok() const { return enc && prev && cur; }
+    bool next(CaptureInfo& info, const char*& body); // body stays valid until the next call
+
+private:
+    uint32_t pos;       // virtual ring offset of the next record
+    bool synced = false;
+    uint8_t* enc = nullptr;
+    uint8_t* prev = nullptr;
+    uint8_t* cur = nullptr;
+    uint16_t prevLen = 0;
+};
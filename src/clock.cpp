@@ -0,0 +1,49 @@
+// clock.cpp - Time sources (see clock.h)
+#include "clock.h"
+
+static const ClockSource* clockSource = nullptr;
+
+void clockInstall(const ClockSource* source) {
+    clockSource = source;
+}
+
+uint32_t clockMillis() {
+    return clockSource ? clockSource->millis() : (uint32_t)millis();
+}
+
+time_t clockEpoch() {
+    return clockSource ? clockSource->epoch() : time(nullptr);
+}
+
+bool clockDue(uint32_t& last, uint32_t interval) {
+    uint32_t now = clockMillis();
+    if (now - last < interval) return false;
+    last = now;
+    return true;
+}
+
+int32_t clockDayNumber(int year, int month, int day) {
+    // Days from civil (proleptic Gregorian), counting years from March so leap days come last
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    int32_t yoe = year - era * 400;
+    int32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+time_t clockFromUtc(int year, int month, int day, int hour, int minute, int second) {
+    return (time_t)clockDayNumber(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+time_t clockParseIso(const char* iso) {
+    if (!iso || strlen(iso) < 19 || iso[4] != '-' || iso[7] != '-' || iso[10] != 'T' || iso[13] != ':') return 0;
+    time_t t = clockFromUtc(atoi(iso), atoi(iso + 5), atoi(iso + 8), atoi(iso + 11), atoi(iso + 14), atoi(iso + 17));
+    const char* p = iso + 19;
+    while (*p == '.' || (*p >= '0' && *p <= '9')) p++; // fractional seconds
+    if ((*p == '+' || *p == '-') && strlen(p) >= 6) {
+        int offset = atoi(p + 1) * 3600 + atoi(p + 4) * 60;
+        t += *p == '+' ? -offset : offset;
+    }
+    return t;
+}
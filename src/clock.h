@@ -0,0 +1,39 @@
+// clock.h - Time sources for scheduling, rotation, logging and time formatting
+//
+// Firmware code reads time through here instead of calling millis()/time() directly, so host
+// programs can install their own clock and warp through the 49.7-day millis() wrap, DST changes
+// and year ends. Elapsed times are uint32_t differences, which stay correct across the wrap for
+// intervals below 49.7 days; never compare two clockMillis() values with < or >.
+#pragma once
+
+#include <Arduino.h>
+#include <time.h>
+
+struct ClockSource {
+    uint32_t (*millis)();   // monotonic, wraps at 2^32
+    time_t (*epoch)();      // wall clock, small values until NTP has synced
+};
+
+// nullptr = the hardware clock (millis(), time())
+void clockInstall(const ClockSource* source);
+
+uint32_t clockMillis();
+time_t clockEpoch();
+
+// Wall clock has been set by NTP (anything before 2020 is the unsynced boot time)
+inline bool clockSynced(time_t epoch) { return epoch > 1600000000; }
+
+// ms since `since` (a clockMillis() value), wrap-safe
+inline uint32_t clockElapsed(uint32_t since) { return clockMillis() - since; }
+
+// Periodic schedule: true once `interval` ms have passed since `last`, which is then set to now
+bool clockDue(uint32_t& last, uint32_t interval);
+
+// UTC calendar time -> epoch (timegm(), which newlib lacks); month 1-12
+time_t clockFromUtc(int year, int month, int day, int hour, int minute, int second);
+
+// ISO 8601 "YYYY-MM-DDTHH:MM:SS[.fff](Z|+HH:MM|-HH:MM)" -> epoch; 0 when malformed
+time_t clockParseIso(const char* iso);
+
+// Days since 1970-01-01 of a calendar date, for day differences across months and years
+int32_t clockDayNumber(int year, int month, int day);
@@ -25,9 +25,32 @@
 #define COLUMN_WIDTH ((SCREEN_WIDTH - (3 * PADDING)) / 2)
 
 // Timing configuration
-#define POLL_INTERVAL 10000     // 10 seconds
+#ifndef POLL_INTERVAL
+#define POLL_INTERVAL 10000     // 10 seconds (SoC and countdowns are extrapolated in between, predict.h)
+#endif
 #define HTTP_TIMEOUT 8000       // 8 seconds
 #define ROTATION_INTERVAL 10000 // 10 seconds for loadpoint rotation
+#define PREDICT_TICK_MS 1000            // Car section refresh from the extrapolation (predict.h)
+#define PREDICT_RECONCILE_MS 3000       // New poll values blend in over this instead of jumping
+#define PREDICT_MAX_AGE_MS 900000       // Unchanged poll values stop being extrapolated after this
+#define PHASE_HISTORY_SAMPLES 60        // Phase current samples per loadpoint (phase_history.h)
+#define PHASE_HISTORY_INTERVAL 60000    // Polls averaged into one sample
+#define PHASE_HISTORY_STEP_A 0.25f      // Quantization step (uint8 -> up to 63.75 A)
+#define PHASE_CHART_HEIGHT 14           // Car section strip chart: 3 lanes of 4 px with 1 px gaps
+#define PHASE_CHART_WIDTH (2 * PHASE_HISTORY_SAMPLES) // two 4-bit pixels (one byte) per sample
+#define TARIFF_API_PATH "/api/tariff/grid" // Dynamic grid price forecast (tariff.h)
+#define TARIFF_POLL_INTERVAL 900000     // 15 minutes, independent of POLL_INTERVAL
+#define TARIFF_MAX_SLOTS 96             // Slots kept (24 h at 15 min, 4 days hourly); the rest is skipped while streaming
+#define TARIFF_SLOT_DOC_CAPACITY 192    // ArduinoJson pool for one slot object
+#define TARIFF_STREAM_TIMEOUT 2000      // Per read while streaming slots; well inside the 8 s task watchdog
+#define TARIFF_PRICE_SCALE 1000         // Fixed-point price units per currency unit (0.1 ct)
+#define TARIFF_CHEAP_WINDOW_MINUTES 180 // Cheapest window highlighted in the chart
+#define TARIFF_CHART_WIDTH 120          // In column price chart, two pixels per slot
+#define TARIFF_CHART_HEIGHT 14
+#define TIMEZONE "CET-1CEST,M3.5.0,M10.5.0/3" // POSIX TZ, Europe/Berlin
+#define BOOT_WIFI_TIMEOUT 20000 // Boot strip reports WiFi trouble after this (association keeps retrying)
+#define BOOT_TIME_TIMEOUT 10000 // First NTP sync expected within this after WiFi (logged when late)
+#define BOOT_STRIP_HEIGHT 20    // Progress strip at the bottom of the screen while booting
 
 // Threshold below which a power flow is considered inactive (used for dimming text)
 #ifndef POWER_ACTIVE_THRESHOLD
@@ -37,7 +60,35 @@
 // Debug configuration
 #define DEBUG_MODE false        // Enable debug logging (Serial + Web) (default off)
 #define WEB_SERVER_PORT 80      // HTTP server port for status/logs
+#define STATUS_DOC_CAPACITY 6144  // ArduinoJson pool used while rendering /status
+#define STATUS_JSON_CAPACITY 4096 // Size of each serialized /status cache buffer (double-buffered)
 #define LOG_BUFFER_SIZE 100     // Maximum number of log entries to keep
+#define LOG_BUFFER_SIZE_PSRAM 1000      // Log ring size on boards with PSRAM (mem_policy.h)
+#define LOG_STREAM_MAX_CLIENTS 3        // Concurrent /logs/stream (SSE) viewers
+#define LOG_STREAM_HEARTBEAT_MS 15000   // Idle SSE keep-alive comment interval
+#define EVENTS_RING_SIZE 8      // EVCCData deltas kept for /events clients (bounds each client's backlog)
+#define EVENTS_SLOT_SIZE 384    // Largest serialized delta; bigger ones make clients resync from a snapshot
+#define EVENTS_MAX_CLIENTS 4    // Concurrent /events (SSE) subscribers
+#define EVENTS_HEARTBEAT_MS 15000
+#define CAPTURE_BUFFER_SIZE 8192       // RAM budget for recent raw EVCC responses (/capture), power of two
+#define CAPTURE_BUFFER_SIZE_PSRAM 131072 // Same with PSRAM, power of two
+#define CAPTURE_MAX_PAYLOAD 2048       // Longer responses are captured truncated
+#define CAPTURE_KEYFRAME_INTERVAL 16   // Store a full body after this many deltas
+#define RTC_LOG_ENTRIES 16      // Newest log entries mirrored to RTC memory (survive resets)
+#define RTC_RESET_HISTORY 8     // Boots kept in the reset-reason/uptime history
+#define BOOT_PROFILE_HISTORY 4  // Boots whose phase timings are kept (RTC memory, /status)
+#define HEAP_SAMPLE_INTERVAL 60000      // Heap health sample period (ms)
+#define HEAP_TREND_HOURS 24             // Hourly heap minima kept for the trend (/status)
+#define HEAP_TREND_MIN_HOURS 6          // History needed before a trend is projected (also the earliest planned restart)
+#define HEAP_LARGEST_BLOCK_FLOOR 12288  // Largest free block the HTTP client + response + JSON parse need
+#define HEAP_RESTART_HORIZON_HOURS 48   // Plan a restart when the floor is projected within this many hours
+#ifndef HEAP_RESTART_HOUR
+#define HEAP_RESTART_HOUR 3             // Local hour of the quiet window for planned restarts (-1 = never)
+#endif
+#ifndef PSRAM_FRAMEBUFFER
+#define PSRAM_FRAMEBUFFER 0     // 1 = full-screen LVGL draw buffer in PSRAM when the board has it
+#endif
+#define SCREENSHOT_BAND_ROWS 10 // Rows rendered per /screenshot.bmp band (matches the LVGL draw buffer)
 
 // Logging levels
 #define LOG_LEVEL_ERROR   ((uint8_t)0)
@@ -108,7 +159,7 @@
 #define CONTAINER_RADIUS 0
 
 // EVCC API endpoint path  
-#define EVCC_API_PATH "/api/state?jq={gridPower:.grid.power,pvPower:.pvPower,batterySoc:.batterySoc,homePower:.homePower,batteryPower:.batteryPower,solar:{scale:(.forecast.solar.scale),todayEnergy:(.forecast.solar.today.energy)},loadpoints:[.loadpoints[0],.loadpoints[1]]|map(select(.!=null)|{chargePower:.chargePower,soc:(.vehicleSoc//.soc),charging:.charging,plugged:(.connected//.plugged),title:.title,vehicletitle:.vehicleTitle,vehicleRange:.vehicleRange,effectivePlanTime:.effectivePlanTime,effectivePlanSoc:.effectivePlanSoc,effectiveLimitSoc:.effectiveLimitSoc,planProjectedStart:.planProjectedStart,chargeCurrents:.chargeCurrents,maxCurrent:.maxCurrent,offeredCurrent:.chargeCurrent,phasesActive:.phasesActive,chargeRemainingDuration:.chargeRemainingDuration,chargedEnergy:.chargedEnergy})}"
+#define EVCC_API_PATH "/api/state?jq={gridPower:.grid.power,pvPower:.pvPower,batterySoc:.batterySoc,homePower:.homePower,batteryPower:.batteryPower,solar:{scale:(.forecast.solar.scale),todayEnergy:(.forecast.solar.today.energy)},loadpoints:[.loadpoints[0],.loadpoints[1]]|map(select(.!=null)|{chargePower:.chargePower,soc:(.vehicleSoc//.soc),charging:.charging,plugged:(.connected//.plugged),title:.title,vehicletitle:.vehicleTitle,vehicleRange:.vehicleRange,effectivePlanTime:.effectivePlanTime,effectivePlanSoc:.effectivePlanSoc,effectiveLimitSoc:.effectiveLimitSoc,planProjectedStart:.planProjectedStart,chargeCurrents:.chargeCurrents,maxCurrent:.maxCurrent,offeredCurrent:.chargeCurrent,phasesActive:.phasesActive,chargeRemainingDuration:.chargeRemainingDuration,chargedEnergy:.chargedEnergy,vehicleCapacity:.vehicleCapacity})}"
 
 // Data structure for EVCC loadpoint values
 struct LoadpointData {
@@ -129,6 +180,7 @@ struct LoadpointData {
     int phasesActive = 0;
     int chargeRemainingDuration = 0; // Remaining charge duration in seconds
     float chargedEnergy = 0.0;       // Energy charged in current session (Wh)
+    float vehicleCapacity = 0.0;     // Vehicle battery capacity (kWh), 0 = unknown
     
     // Constructor with string reservation
     LoadpointData() {
@@ -154,14 +206,14 @@ struct EVCCData {
     // Loadpoint data
     LoadpointData lp1, lp2;
     
-    unsigned long lastUpdate = 0;
+    uint32_t lastUpdate = 0;      // clockMillis() of the last applied poll
     int consecutiveFailures = 0;
 };
 
 // Loadpoint rotation state structure
 struct RotationState {
     bool currentLoadpoint = true; // true = LP1, false = LP2
-    unsigned long lastRotation = 0;
+    uint32_t lastRotation = 0;    // clockMillis()
 };
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+// data_parser.cpp - EVCC API response -> EVCCData (no LVGL dependency; also built for the native env)
+#include "data_parser.h"
+#include <ArduinoJson.h>
+#include "logging.h"
+
+bool parseCombinedData(const String& json, EVCCData& data) {
+    DynamicJsonDocument doc(1536);
+    DeserializationError error = deserializeJson(doc, json);
+    
+    if (error) {
+    logMessage((uint8_t)LOG_LEVEL_ERROR, "Combined parse error: " + String(error.c_str()));
+        return false;
+    }
+    
+    // Parse energy data
+    data.gridPower = doc["gridPower"] | 0.0;
+    data.pvPower = doc["pvPower"] | 0.0;
+    data.batterySoc = doc["batterySoc"] | -1.0;
+    data.homePower = doc["homePower"] | 0.0;
+    data.batteryPower = doc["batteryPower"] | 0.0;
+    
+    // Parse solar forecast data
+    JsonObject solar = doc["solar"];
+    if (!solar.isNull()) {
+        data.solarForecastScale = solar["scale"] | 1.0;
+        data.solarForecastTodayEnergy = solar["todayEnergy"] | 0.0;
+    } else {
+        data.solarForecastScale = 1.0;
+        data.solarForecastTodayEnergy = 0.0;
+    }
+    
+    // Reset loadpoint data
+    data.lp1.soc = -1.0;
+    data.lp1.chargePower = 0.0;
+    data.lp1.vehicleRange = -1.0;
+    data.lp1.effectivePlanTime = "";
+    data.lp1.effectivePlanSoc = -1.0;
+    data.lp1.effectiveLimitSoc = -1.0;
+    data.lp1.planProjectedStart = "";
+    data.lp2.soc = -1.0;
+    data.lp2.chargePower = 0.0;
+    data.lp2.vehicleRange = -1.0;
+    data.lp2.effectivePlanTime = "";
+    data.lp2.effectivePlanSoc = -1.0;
+    data.lp2.effectiveLimitSoc = -1.0;
+    data.lp2.planProjectedStart = "";
+    
+    // Parse loadpoint data
+    JsonArray loadpoints = doc["loadpoints"];
+    if (loadpoints.size() > 0 && !loadpoints[0].isNull()) {
+        JsonObject lp1 = loadpoints[0];
+        data.lp1.soc = lp1["soc"] | -1.0;
+        data.lp1.chargePower = lp1["chargePower"] | 0.0;
+        data.lp1.title = lp1["title"] | "LP1";
+        data.lp1.vehicleTitle = lp1["vehicletitle"] | "";
+        data.lp1.charging = lp1["charging"] | false;
+        data.lp1.plugged = lp1["plugged"] | false;
+        data.lp1.vehicleRange = lp1["vehicleRange"] | -1.0;
+        data.lp1.effectivePlanTime = lp1["effectivePlanTime"] | "";
+        data.lp1.effectivePlanSoc = lp1["effectivePlanSoc"] | -1.0;
+        data.lp1.effectiveLimitSoc = lp1["effectiveLimitSoc"] | -1.0;
+        data.lp1.planProjectedStart = lp1["planProjectedStart"] | "";
+        data.lp1.maxCurrent = lp1["maxCurrent"] | 0.0;
+        data.lp1.offeredCurrent = lp1["offeredCurrent"] | 0.0;
+        data.lp1.phasesActive = lp1["phasesActive"] | 0;
+        data.lp1.chargeRemainingDuration = lp1["chargeRemainingDuration"] | 0;
+        data.lp1.chargedEnergy = lp1["chargedEnergy"] | 0.0;
+        data.lp1.vehicleCapacity = lp1["vehicleCapacity"] | 0.0;
+        JsonArray currents = lp1["chargeCurrents"];
+        for (int i = 0; i < 3 && i < currents.size(); i++) {
+            data.lp1.chargeCurrents[i] = currents[i] | 0.0;
+        }
+    }
+    
+    if (loadpoints.size() > 1 && !loadpoints[1].isNull()) {
+        JsonObject lp2 = loadpoints[1];
+        data.lp2.soc = lp2["soc"] | -1.0;
+        data.lp2.chargePower = lp2["chargePower"] | 0.0;
+        data.lp2.title = lp2["title"] | "LP2";
+        data.lp2.vehicleTitle = lp2["vehicletitle"] | "";
+        data.lp2.charging = lp2["charging"] | false;
+        data.lp2.plugged = lp2["plugged"] | false;
+        data.lp2.vehicleRange = lp2["vehicleRange"] | -1.0;
+        data.lp2.effectivePlanTime = lp2["effectivePlanTime"] | "";
+        data.lp2.effectivePlanSoc = lp2["effectivePlanSoc"] | -1.0;
+        data.lp2.effectiveLimitSoc = lp2["effectiveLimitSoc"] | -1.0;
+        data.lp2.planProjectedStart = lp2["planProjectedStart"] | "";
+        data.lp2.maxCurrent = lp2["maxCurrent"] | 0.0;
+        data.lp2.offeredCurrent = lp2["offeredCurrent"] | 0.0;
+        data.lp2.phasesActive = lp2["phasesActive"] | 0;
+        data.lp2.chargeRemainingDuration = lp2["chargeRemainingDuration"] | 0;
+        data.lp2.chargedEnergy = lp2["chargedEnergy"] | 0.0;
+        data.lp2.vehicleCapacity = lp2["vehicleCapacity"] | 0.0;
+        JsonArray currents = lp2["chargeCurrents"];
+        for (int i = 0; i < 3 && i < currents.size(); i++) {
+            data.lp2.chargeCurrents[i] = currents[i] | 0.0;
+        }
+    }
+    
+    // Calculate derived values
+    // float total_charge_power = data.lp1.chargePower + data.lp2.chargePower;
+    
+    
+    return true;
+}
@@ -0,0 +1,8 @@
+// data_parser.h - Parsing of the combined EVCC API response (EVCC_API_PATH)
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+// Fill `data` from the jq-filtered /api/state response; false (data untouched) on malformed JSON
+bool parseCombinedData(const String& json, EVCCData& data);
@@ -1,119 +1,232 @@
 // display_updates.cpp - Implements periodic UI update logic
 #include "display_updates.h"
 #include "logging.h"
+#include "clock.h"
+#include "predict.h"
+#include "phase_history.h"
+#include "tariff.h"
 
 // Internal stripe application state
 static bool stripe_applied = false;
 
-// Formatting utilities (only formatPower is exported via header; others local)
-String formatPower(float watts) {
-    if (abs(watts) < 1000) return String((int)watts) + "W";
-    if (abs(watts) < 10000) return String(watts / 1000.0, 1) + "kW";
-    return String(watts / 1000.0, 0) + "kW";
+// Apply / remove charging stripe pattern
+static void applyStripePattern(lv_obj_t* segment, bool charging) {
+    if (!segment) return;
+    if (charging && !stripe_applied) {
+        lv_obj_add_style(segment, &stripe_style, LV_PART_INDICATOR);
+        stripe_applied = true;
+        logMessage("Applied stripe pattern (charging)");
+    } else if (!charging && stripe_applied) {
+        lv_obj_remove_style(segment, &stripe_style, LV_PART_INDICATOR);
+        stripe_applied = false;
+        logMessage("Removed stripe pattern (not charging)");
+    }
 }
 
-static String formatEnergy(float wh) {
-    if (abs(wh) < 1000) return String((int)wh) + "Wh";
-    if (abs(wh) < 10000) return String(wh / 1000.0, 1) + "kWh";
-    return String(wh / 1000.0, 0) + "kWh";
+// Loadpoint the car section currently shows
+static const LoadpointData* shownLP = nullptr;
+
+// Extrapolated SoC / remaining time / charged energy per loadpoint (predict.h), refreshed by
+// a 1 s LVGL timer for the shown loadpoint
+static ChargePrediction predictions[2];
+static lv_timer_t* predictTimer = nullptr;
+
+static ChargePrediction& predictionFor(const LoadpointData* lp) {
+    return predictions[lp == &data.lp2 ? 1 : 0];
 }
 
-static String formatPercentage(float value) { return value >= 0 ? String((int)value) + "%" : "---"; }
-static String formatDistance(float value) { return value >= 0 ? String((int)value) + "km" : "-- km"; }
+uint32_t uiRedrawsSkipped = 0;
 
-static String formatDuration(int seconds) {
-    if (seconds <= 0) return "--:--";
-    int hours = seconds / 3600;
-    int minutes = (seconds % 3600) / 60;
-    char buf[8];
-    snprintf(buf, sizeof(buf), "%02d:%02d", hours, minutes);
-    return String(buf);
+// Labels are only touched when the text changes, so a tick that changes nothing visible
+// invalidates nothing
+static void setLabelIfChanged(lv_obj_t* label, const char* text) {
+    if (!label) return;
+    if (strcmp(lv_label_get_text(label), text) != 0) lv_label_set_text(label, text);
+    else uiRedrawsSkipped++;
 }
 
-static String formatPlanTime(const String& isoTime) {
-    if (isoTime.isEmpty() || isoTime.length() < 19) return "keiner";
-    int year = isoTime.substring(0, 4).toInt();
-    int month = isoTime.substring(5, 7).toInt();
-    int day = isoTime.substring(8, 10).toInt();
-    int hour = isoTime.substring(11, 13).toInt();
-    int minute = isoTime.substring(14, 16).toInt();
-    time_t now = time(nullptr);
-    struct tm* currentLocal = localtime(&now);
-    bool isDST = currentLocal && currentLocal->tm_isdst > 0;
-    int localHour = hour + (isDST ? 2 : 1);
-    int localDay = day;
-    int localMonth = month;
-    int localYear = year;
-    if (localHour >= 24) {
-        localHour -= 24; localDay++;
-        int daysInMonth[] = {31,28,31,30,31,30,31,31,30,31,30,31};
-        if (localYear % 4 == 0 && (localYear % 100 != 0 || localYear % 400 == 0)) daysInMonth[1] = 29;
-        if (localDay > daysInMonth[localMonth - 1]) { localDay = 1; localMonth++; if (localMonth > 12) { localMonth = 1; localYear++; } }
+// SoC bar/label, charged energy and (while charging) the remaining time
+static void showPredicted(const LoadpointData* lp, const ChargePrediction& pred) {
+    char buf[FORMAT_BUF_SIZE];
+    if (pred.soc >= 0) {
+        lv_bar_set_value(ui.car.soc_bar, (int)pred.soc, LV_ANIM_OFF);
+        setLabelIfChanged(ui.car.soc_value, formatPercentage(buf, sizeof(buf), pred.soc));
+    } else {
+        setLabelIfChanged(ui.car.soc_value, "---");
     }
-    int todayYear = currentLocal ? currentLocal->tm_year + 1900 : localYear;
-    int todayMonth = currentLocal ? currentLocal->tm_mon + 1 : localMonth;
-    int todayDay = currentLocal ? currentLocal->tm_mday : localDay;
-    int daysDiff = 0;
-    if (localYear == todayYear && localMonth == todayMonth) daysDiff = localDay - todayDay;
-    else if (localYear > todayYear || (localYear == todayYear && localMonth > todayMonth)) daysDiff = 7; else daysDiff = -7;
-    const char* germanDays[] = {"Sonntag","Montag","Dienstag","Mittwoch","Donnerstag","Freitag","Samstag"};
-    String dayString;
-    if (daysDiff == 0) dayString = "Heute"; else if (daysDiff == 1) dayString = "Morgen"; else if (daysDiff >= 2 && daysDiff < 7) {
-        struct tm targetDate = {0}; targetDate.tm_year = localYear - 1900; targetDate.tm_mon = localMonth - 1; targetDate.tm_mday = localDay; mktime(&targetDate);
-        dayString = String(germanDays[targetDate.tm_wday]);
-    } else dayString = String(localDay) + "." + String(localMonth) + ".";
-    char timeBuf[6]; snprintf(timeBuf, sizeof(timeBuf), "%02d:%02d", localHour, minute);
-    return dayString + " " + timeBuf;
+    setLabelIfChanged(ui.car.charged_value, formatEnergy(buf, sizeof(buf), pred.chargedEnergy));
+    if (lp->charging && pred.remaining > 0) {
+        setLabelIfChanged(ui.car.ladedauer_value, formatDuration(buf, sizeof(buf), pred.remaining));
+    }
+}
+
+static void predictTick(lv_timer_t*) {
+    if (!shownLP || !shownLP->charging) return;
+    ChargePrediction& pred = predictionFor(shownLP);
+    predictUpdate(pred, *shownLP, clockMillis());
+    showPredicted(shownLP, pred);
+}
+
+// Phase current strip chart: three lanes, one byte (two 4-bit pixels) per sample, newest on
+// the right. A new sample scrolls the rows by one byte and paints only the newest column;
+// switching loadpoints repaints from the ring.
+static PhaseHistory phaseHistories[2];
+static const PhaseHistory* chartHistory = nullptr;
+static uint32_t chartTotal = 0; // history samples already on the canvas
+static const int CHART_STRIDE = (PHASE_CHART_WIDTH + 1) / 2;
+static const int CHART_COLUMNS = CHART_STRIDE;
+static const int CHART_LANE_ROWS = 4;
+
+static uint8_t* chartPixels() {
+    return (uint8_t*)lv_canvas_get_img(ui.car.phase_chart)->data + 4 * 16; // after the palette
+}
+
+static uint8_t chartLevel(uint8_t quantized, float maxCurrent) {
+    if (quantized == 0) return 1;
+    float ratio = phaseHistoryAmps(quantized) / (maxCurrent > 0 ? maxCurrent : 16.0f);
+    int level = 2 + (int)(ratio * 13 + 0.5f);
+    return level > 15 ? 15 : level;
 }
 
-// Loadpoint rotation logic
-LoadpointData* getActiveLoadpoint() {
-    bool lp1Charging = data.lp1.charging;
-    bool lp2Charging = data.lp2.charging;
-    if (lp1Charging && !lp2Charging) return &data.lp1;
-    if (lp2Charging && !lp1Charging) return &data.lp2;
-    unsigned long now = millis();
-    if (now - rotationState.lastRotation >= ROTATION_INTERVAL) {
-        rotationState.currentLoadpoint = !rotationState.currentLoadpoint;
-        rotationState.lastRotation = now;
-        logMessage("Rotating to loadpoint " + String(rotationState.currentLoadpoint ? 1 : 2));
+static void chartColumn(uint8_t* px, int col, const uint8_t* amps, float maxCurrent) {
+    for (int lane = 0; lane < 3; lane++) {
+        uint8_t level = amps ? chartLevel(amps[lane], maxCurrent) : 0;
+        uint8_t pair = (uint8_t)(level << 4 | level);
+        for (int r = 0; r < CHART_LANE_ROWS; r++) px[(lane * (CHART_LANE_ROWS + 1) + r) * CHART_STRIDE + col] = pair;
     }
-    return rotationState.currentLoadpoint ? &data.lp1 : &data.lp2;
 }
 
-// Apply / remove charging stripe pattern
-static void applyStripePattern(lv_obj_t* segment, bool charging) {
-    if (!segment) return;
-    if (charging && !stripe_applied) {
-        lv_obj_add_style(segment, &stripe_style, LV_PART_INDICATOR);
-        stripe_applied = true;
-        logMessage("Applied stripe pattern (charging)");
-    } else if (!charging && stripe_applied) {
-        lv_obj_remove_style(segment, &stripe_style, LV_PART_INDICATOR);
-        stripe_applied = false;
-        logMessage("Removed stripe pattern (not charging)");
+static void chartRedraw(const PhaseHistory& h, float maxCurrent) {
+    uint8_t* px = chartPixels();
+    memset(px, 0, CHART_STRIDE * PHASE_CHART_HEIGHT);
+    uint8_t amps[3];
+    for (int col = 0; col < CHART_COLUMNS; col++) {
+        bool have = phaseHistorySample(h, CHART_COLUMNS - 1 - col, amps);
+        chartColumn(px, col, have ? amps : nullptr, maxCurrent);
     }
+    chartTotal = h.total;
+}
+
+static void chartScroll(const PhaseHistory& h, float maxCurrent) {
+    uint32_t added = h.total - chartTotal;
+    if (added >= (uint32_t)CHART_COLUMNS) {
+        chartRedraw(h, maxCurrent);
+        return;
+    }
+    uint8_t* px = chartPixels();
+    for (int row = 0; row < PHASE_CHART_HEIGHT; row++) {
+        uint8_t* line = px + row * CHART_STRIDE;
+        memmove(line, line + added, CHART_COLUMNS - added);
+    }
+    uint8_t amps[3];
+    for (uint32_t i = 0; i < added; i++) {
+        phaseHistorySample(h, added - 1 - i, amps);
+        chartColumn(px, CHART_COLUMNS - added + i, amps, maxCurrent);
+    }
+    chartTotal = h.total;
+}
+
+// Shows the shown loadpoint's history, repainting when it changed loadpoints
+static void showPhaseChart(const LoadpointData* lp) {
+    if (!ui.car.phase_chart) return;
+    const PhaseHistory& h = phaseHistories[lp == &data.lp2 ? 1 : 0];
+    if (h.count == 0) {
+        lv_obj_add_flag(ui.car.phase_chart, LV_OBJ_FLAG_HIDDEN);
+        chartHistory = nullptr;
+        return;
+    }
+    if (chartHistory != &h) {
+        chartRedraw(h, lp->maxCurrent);
+        chartHistory = &h;
+    } else if (h.total != chartTotal) {
+        chartScroll(h, lp->maxCurrent);
+    } else {
+        uiRedrawsSkipped++;
+        return;
+    }
+    lv_obj_clear_flag(ui.car.phase_chart, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_invalidate(ui.car.phase_chart);
+}
+
+void updatePhaseHistory() {
+    uint32_t now = clockMillis();
+    bool changed = phaseHistoryRecord(phaseHistories[0], data.lp1, now);
+    changed |= phaseHistoryRecord(phaseHistories[1], data.lp2, now);
+    if (changed && shownLP) showPhaseChart(shownLP);
+}
+
+// Price chart: one byte (two 4-bit pixels) per slot from the current slot on, bar heights
+// scaled between zero (or the lowest negative price) and the highest shown price
+static int tariffChartSlot = -2;       // current slot the chart was painted for
+static time_t tariffChartFetched = 0;
+
+void updateTariffChart() {
+    if (!ui.tariff.chart) return;
+    time_t now = clockEpoch();
+    int current = clockSynced(now) ? tariffCurrentSlot(tariff, now) : -1;
+    if (current == tariffChartSlot && tariff.fetchedAt == tariffChartFetched) {
+        uiRedrawsSkipped++;
+        return;
+    }
+    tariffChartSlot = current;
+    tariffChartFetched = tariff.fetchedAt;
+    lv_obj_t* parts[] = {ui.tariff.desc, ui.tariff.chart, ui.tariff.value};
+    if (current < 0) {
+        for (lv_obj_t* o : parts) lv_obj_add_flag(o, LV_OBJ_FLAG_HIDDEN);
+        return;
+    }
+
+    const int stride = (TARIFF_CHART_WIDTH + 1) / 2;
+    int shown = tariff.count - current;
+    if (shown > stride) shown = stride;
+    int32_t lo = 0, hi = 1;
+    for (int i = current; i < current + shown; i++) {
+        if (tariff.price[i] < lo) lo = tariff.price[i];
+        if (tariff.price[i] > hi) hi = tariff.price[i];
+    }
+    int window = tariffWindowSlots(tariff);
+    int cheapest = tariffCheapestWindow(tariff, current, window);
+
+    uint8_t* px = (uint8_t*)lv_canvas_get_img(ui.tariff.chart)->data + 4 * 16; // after the palette
+    memset(px, 0, stride * TARIFF_CHART_HEIGHT);
+    for (int col = 0; col < shown; col++) {
+        int slot = current + col;
+        int height = 1 + (int)((tariff.price[slot] - lo) * (TARIFF_CHART_HEIGHT - 1) / (hi - lo));
+        uint8_t index = col == 0 ? 3 : (cheapest >= 0 && slot >= cheapest && slot < cheapest + window) ? 2 : 1;
+        uint8_t pair = (uint8_t)(index << 4 | index);
+        for (int row = TARIFF_CHART_HEIGHT - height; row < TARIFF_CHART_HEIGHT; row++) px[row * stride + col] = pair;
+    }
+    lv_obj_invalidate(ui.tariff.chart);
+
+    // Whole cents, like the app's price display
+    char buf[FORMAT_BUF_SIZE];
+    int32_t price = tariff.price[current];
+    int32_t cents = (price + (price < 0 ? -5 : 5)) / 10;
+    snprintf(buf, sizeof(buf), "%ld ct", (long)cents);
+    lv_label_set_text(ui.tariff.value, buf);
+    for (lv_obj_t* o : parts) lv_obj_clear_flag(o, LV_OBJ_FLAG_HIDDEN);
 }
 
 // Core UI update (mirrors original logic with minor encapsulation)
 void updateUI() {
+    char buf[FORMAT_BUF_SIZE];  // number formatting; lv_label_set_text() copies the text
     int barMaxWidth = ui.in_bar.container ? lv_obj_get_width(ui.in_bar.container) : 360;
-    lv_label_set_text(ui.generation.value2, formatPower(data.pvPower).c_str());
+    lv_label_set_text(ui.generation.value2, formatPower(buf, sizeof(buf), data.pvPower));
     float scaledSolarForecastEnergy = data.solarForecastTodayEnergy * data.solarForecastScale;
-    lv_label_set_text(ui.generation.value1, formatEnergy(scaledSolarForecastEnergy).c_str());
+    lv_label_set_text(ui.generation.value1, formatEnergy(buf, sizeof(buf), scaledSolarForecastEnergy));
     lv_color_t genColor = (fabs(data.pvPower) < POWER_ACTIVE_THRESHOLD) ? lv_color_hex(COLOR_TEXT_SECONDARY) : lv_color_hex(COLOR_TEXT_VALUE);
     lv_obj_set_style_text_color(ui.generation.desc, genColor, 0);
     lv_obj_set_style_text_color(ui.generation.value1, genColor, 0);
     lv_obj_set_style_text_color(ui.generation.value2, genColor, 0);
-    lv_label_set_text(ui.consumption.value2, formatPower(data.homePower).c_str());
+    lv_label_set_text(ui.consumption.value2, formatPower(buf, sizeof(buf), data.homePower));
     lv_color_t consColor = (fabs(data.homePower) < POWER_ACTIVE_THRESHOLD) ? lv_color_hex(COLOR_TEXT_SECONDARY) : lv_color_hex(COLOR_TEXT_VALUE);
     lv_obj_set_style_text_color(ui.consumption.desc, consColor, 0);
     lv_obj_set_style_text_color(ui.consumption.value2, consColor, 0);
     if (data.batteryPower > POWER_ACTIVE_THRESHOLD) {
-        lv_label_set_text(ui.battery_discharge.value1, formatPercentage(data.batterySoc).c_str());
-        lv_label_set_text(ui.battery_discharge.value2, formatPower(data.batteryPower).c_str());
-        lv_label_set_text(ui.battery_charge.value1, formatPercentage(data.batterySoc).c_str());
-        lv_label_set_text(ui.battery_charge.value2, formatPower(0).c_str());
+        lv_label_set_text(ui.battery_discharge.value1, formatPercentage(buf, sizeof(buf), data.batterySoc));
+        lv_label_set_text(ui.battery_discharge.value2, formatPower(buf, sizeof(buf), data.batteryPower));
+        lv_label_set_text(ui.battery_charge.value1, formatPercentage(buf, sizeof(buf), data.batterySoc));
+        lv_label_set_text(ui.battery_charge.value2, formatPower(buf, sizeof(buf), 0));
         lv_obj_set_style_text_color(ui.battery_discharge.desc, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.battery_discharge.value1, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.battery_discharge.value2, lv_color_hex(COLOR_TEXT_VALUE), 0);
@@ -122,10 +235,10 @@ void updateUI() {
         lv_obj_set_style_text_color(ui.battery_charge.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
     } else if (data.batteryPower < -POWER_ACTIVE_THRESHOLD) {
         float chargePower = -data.batteryPower;
-        lv_label_set_text(ui.battery_charge.value1, formatPercentage(data.batterySoc).c_str());
-        lv_label_set_text(ui.battery_charge.value2, formatPower(chargePower).c_str());
-        lv_label_set_text(ui.battery_discharge.value1, formatPercentage(data.batterySoc).c_str());
-        lv_label_set_text(ui.battery_discharge.value2, formatPower(0).c_str());
+        lv_label_set_text(ui.battery_charge.value1, formatPercentage(buf, sizeof(buf), data.batterySoc));
+        lv_label_set_text(ui.battery_charge.value2, formatPower(buf, sizeof(buf), chargePower));
+        lv_label_set_text(ui.battery_discharge.value1, formatPercentage(buf, sizeof(buf), data.batterySoc));
+        lv_label_set_text(ui.battery_discharge.value2, formatPower(buf, sizeof(buf), 0));
         lv_obj_set_style_text_color(ui.battery_charge.desc, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.battery_charge.value1, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.battery_charge.value2, lv_color_hex(COLOR_TEXT_VALUE), 0);
@@ -133,10 +246,10 @@ void updateUI() {
         lv_obj_set_style_text_color(ui.battery_discharge.value1, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.battery_discharge.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
     } else {
-        lv_label_set_text(ui.battery_discharge.value1, formatPercentage(data.batterySoc).c_str());
-        lv_label_set_text(ui.battery_discharge.value2, formatPower(0).c_str());
-        lv_label_set_text(ui.battery_charge.value1, formatPercentage(data.batterySoc).c_str());
-        lv_label_set_text(ui.battery_charge.value2, formatPower(0).c_str());
+        lv_label_set_text(ui.battery_discharge.value1, formatPercentage(buf, sizeof(buf), data.batterySoc));
+        lv_label_set_text(ui.battery_discharge.value2, formatPower(buf, sizeof(buf), 0));
+        lv_label_set_text(ui.battery_charge.value1, formatPercentage(buf, sizeof(buf), data.batterySoc));
+        lv_label_set_text(ui.battery_charge.value2, formatPower(buf, sizeof(buf), 0));
         lv_obj_set_style_text_color(ui.battery_discharge.desc, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.battery_discharge.value1, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.battery_discharge.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
@@ -145,30 +258,30 @@ void updateUI() {
         lv_obj_set_style_text_color(ui.battery_charge.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
     }
     if (data.gridPower > POWER_ACTIVE_THRESHOLD) {
-        lv_label_set_text(ui.grid_feed.value2, formatPower(data.gridPower).c_str());
-        lv_label_set_text(ui.grid_feedin.value2, formatPower(0).c_str());
+        lv_label_set_text(ui.grid_feed.value2, formatPower(buf, sizeof(buf), data.gridPower));
+        lv_label_set_text(ui.grid_feedin.value2, formatPower(buf, sizeof(buf), 0));
         lv_obj_set_style_text_color(ui.grid_feed.desc, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.grid_feed.value2, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.grid_feedin.desc, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.grid_feedin.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
     } else if (data.gridPower < -POWER_ACTIVE_THRESHOLD) {
         float feedinPower = -data.gridPower;
-        lv_label_set_text(ui.grid_feedin.value2, formatPower(feedinPower).c_str());
-        lv_label_set_text(ui.grid_feed.value2, formatPower(0).c_str());
+        lv_label_set_text(ui.grid_feedin.value2, formatPower(buf, sizeof(buf), feedinPower));
+        lv_label_set_text(ui.grid_feed.value2, formatPower(buf, sizeof(buf), 0));
         lv_obj_set_style_text_color(ui.grid_feedin.desc, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.grid_feedin.value2, lv_color_hex(COLOR_TEXT_VALUE), 0);
         lv_obj_set_style_text_color(ui.grid_feed.desc, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.grid_feed.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
     } else {
-        lv_label_set_text(ui.grid_feed.value2, formatPower(0).c_str());
-        lv_label_set_text(ui.grid_feedin.value2, formatPower(0).c_str());
+        lv_label_set_text(ui.grid_feed.value2, formatPower(buf, sizeof(buf), 0));
+        lv_label_set_text(ui.grid_feedin.value2, formatPower(buf, sizeof(buf), 0));
         lv_obj_set_style_text_color(ui.grid_feed.desc, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.grid_feed.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.grid_feedin.desc, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
         lv_obj_set_style_text_color(ui.grid_feedin.value2, lv_color_hex(COLOR_TEXT_SECONDARY), 0);
     }
     float total_lp_power = data.lp1.chargePower + data.lp2.chargePower;
-    lv_label_set_text(ui.loadpoint.value2, formatPower(total_lp_power).c_str());
+    lv_label_set_text(ui.loadpoint.value2, formatPower(buf, sizeof(buf), total_lp_power));
     lv_color_t lpColor = (fabs(total_lp_power) < POWER_ACTIVE_THRESHOLD) ? lv_color_hex(COLOR_TEXT_SECONDARY) : lv_color_hex(COLOR_TEXT_VALUE);
     lv_obj_set_style_text_color(ui.loadpoint.desc, lpColor, 0);
     lv_obj_set_style_text_color(ui.loadpoint.value2, lpColor, 0);
@@ -203,6 +316,14 @@ void updateUI() {
         updateCompositeBar(ui.overlay_bar.container, overlaySegments, overlayLabels, overlayValues, 4, barMaxWidth);
     }
     auto* activeLP = getActiveLoadpoint();
+    // Rebase both predictions on this poll, so the other loadpoint starts from fresh values
+    // when rotation brings it back
+    uint32_t now = clockMillis();
+    predictUpdate(predictions[0], data.lp1, now);
+    predictUpdate(predictions[1], data.lp2, now);
+    const ChargePrediction& pred = predictionFor(activeLP);
+    shownLP = activeLP;
+    if (!predictTimer) predictTimer = lv_timer_create(predictTick, PREDICT_TICK_MS, nullptr);
     // Show lightning icon only while actively charging
     if (ui.car.lightning_icon) {
         if (activeLP->charging) lv_obj_clear_flag(ui.car.lightning_icon, LV_OBJ_FLAG_HIDDEN);
@@ -217,16 +338,10 @@ void updateUI() {
             lv_obj_add_flag(ui.car.limit_indicator, LV_OBJ_FLAG_HIDDEN);
         }
     }
-    if (activeLP->charging) lv_label_set_text(ui.car.power_label, formatPower(activeLP->chargePower).c_str());
+    if (activeLP->charging) lv_label_set_text(ui.car.power_label, formatPower(buf, sizeof(buf), activeLP->chargePower));
     else if (activeLP->plugged) lv_label_set_text(ui.car.power_label, "Verbunden");
     else lv_label_set_text(ui.car.power_label, "Nicht verbunden");
-    if (activeLP->soc >= 0) {
-        lv_bar_set_value(ui.car.soc_bar, (int)activeLP->soc, LV_ANIM_OFF);
-        lv_label_set_text(ui.car.soc_value, formatPercentage(activeLP->soc).c_str());
-        applyStripePattern(ui.car.soc_bar, activeLP->charging);
-    } else {
-        lv_label_set_text(ui.car.soc_value, "---");
-    }
+    if (activeLP->soc >= 0) applyStripePattern(ui.car.soc_bar, activeLP->charging);
     int phaseBarWidth = 30;
     if (activeLP->charging) {
         for (int i = 0; i < 3; i++) {
@@ -268,25 +383,23 @@ void updateUI() {
         lv_obj_set_pos(ui.car.limit_soc_marker, markerX, 61);
         lv_obj_clear_flag(ui.car.limit_soc_marker, LV_OBJ_FLAG_HIDDEN);
     } else lv_obj_add_flag(ui.car.limit_soc_marker, LV_OBJ_FLAG_HIDDEN);
-    if (activeLP->vehicleRange >= 0) lv_label_set_text(ui.car.range_value, formatDistance(activeLP->vehicleRange).c_str());
-    else lv_label_set_text(ui.car.range_value, formatDistance(-1).c_str());
+    if (activeLP->vehicleRange >= 0) lv_label_set_text(ui.car.range_value, formatDistance(buf, sizeof(buf), activeLP->vehicleRange));
+    else lv_label_set_text(ui.car.range_value, formatDistance(buf, sizeof(buf), -1));
     if (!activeLP->vehicleTitle.isEmpty()) lv_label_set_text(ui.car.car_label, activeLP->vehicleTitle.c_str());
     if (!activeLP->title.isEmpty()) lv_label_set_text(ui.car.title_label, activeLP->title.c_str());
     if (!activeLP->effectivePlanTime.isEmpty()) {
         lv_label_set_text(ui.car.plan_value, formatPlanTime(activeLP->effectivePlanTime).c_str());
-        if (activeLP->effectivePlanSoc >= 0) lv_label_set_text(ui.car.plan_soc_value, formatPercentage(activeLP->effectivePlanSoc).c_str());
+        if (activeLP->effectivePlanSoc >= 0) lv_label_set_text(ui.car.plan_soc_value, formatPercentage(buf, sizeof(buf), activeLP->effectivePlanSoc));
         else lv_label_set_text(ui.car.plan_soc_value, "");
     } else {
         lv_label_set_text(ui.car.plan_value, "keiner");
         lv_label_set_text(ui.car.plan_soc_value, "");
     }
-    if (activeLP->effectiveLimitSoc >= 0) lv_label_set_text(ui.car.ladelimit_value, formatPercentage(activeLP->effectiveLimitSoc).c_str());
+    if (activeLP->effectiveLimitSoc >= 0) lv_label_set_text(ui.car.ladelimit_value, formatPercentage(buf, sizeof(buf), activeLP->effectiveLimitSoc));
     else lv_label_set_text(ui.car.ladelimit_value, "---");
-    // Show remaining charge duration if charging, otherwise projected start time or --:--
-    if (ui.car.ladedauer_value) {
-        if (activeLP->charging && activeLP->chargeRemainingDuration > 0) {
-            lv_label_set_text(ui.car.ladedauer_value, formatDuration(activeLP->chargeRemainingDuration).c_str());
-        } else if (!activeLP->planProjectedStart.isEmpty()) {
+    // Remaining charge duration while charging (showPredicted), otherwise projected start time or --:--
+    if (ui.car.ladedauer_value && !(activeLP->charging && pred.remaining > 0)) {
+        if (!activeLP->planProjectedStart.isEmpty()) {
             String formattedTime = formatPlanTime(activeLP->planProjectedStart);
             char projectedDisplay[64]; snprintf(projectedDisplay, sizeof(projectedDisplay), "|--> %s", formattedTime.c_str());
             lv_label_set_text(ui.car.ladedauer_value, projectedDisplay);
@@ -294,8 +407,7 @@ void updateUI() {
             lv_label_set_text(ui.car.ladedauer_value, "--:--");
         }
     }
-    // Update charged energy display
-    if (ui.car.charged_value) {
-        lv_label_set_text(ui.car.charged_value, formatEnergy(activeLP->chargedEnergy).c_str());
-    }
+    // SoC, charged energy and remaining time, extrapolated between polls
+    showPredicted(activeLP, pred);
+    showPhaseChart(activeLP);
 }
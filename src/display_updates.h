@@ -5,6 +5,8 @@
 #include <lvgl.h>
 #include "config.h"
 #include "ui_helpers.h"
+#include "formatters.h"
+#include "rotation.h"
 
 // Extern data & UI provided by main / other modules
 extern EVCCData data;
@@ -12,11 +14,17 @@ extern UIElements ui;
 extern RotationState rotationState;
 extern lv_style_t stripe_style;
 
-// Accessor for current active loadpoint (rotation-aware)
-LoadpointData* getActiveLoadpoint();
-
 // Core periodic UI update
 void updateUI();
 
-// Formatting utility exposed (required by ui_helpers for segment labels)
-String formatPower(float watts);
+// Label and chart updates skipped because nothing visible changed (exported on /metrics)
+extern uint32_t uiRedrawsSkipped;
+
+// Adds the latest poll to both loadpoints' phase current history (phase_history.h) and scrolls
+// the car section's chart when a sample completes; call after every successful poll
+void updatePhaseHistory();
+
+// Repaints the In column's price chart when the tariff forecast or the current slot changed;
+// call after each tariff fetch and periodically (cheap when nothing changed)
+void updateTariffChart();
+
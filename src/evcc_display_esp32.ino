@@ -15,14 +15,24 @@
 #include <ESPAsyncWebServer.h>
 #include "wifi_config.h"
 #include "config.h"
+#include "clock.h"
 #include "logging.h"
+#include "metrics.h"
+#include "screenshot.h"
+#include "events.h"
+#include "capture.h"
+#include "heap_health.h"
+#include "mem_policy.h"
+#include "snapshot.h"
+#include "boot_profile.h"
+#include "tariff.h"
 #include "webserver.h"
 #include "ui_helpers.h"
 #include "display_updates.h"
+#include "data_parser.h"
 
 // Forward declarations for functions defined later (ordering disruption after refactor)
 bool httpGet(const char* path, String& response);
-bool connectWiFi();
 void startWebServer();
 
 // Threshold (in Watts) below which values are considered inactive for dimming
@@ -30,8 +40,6 @@ void startWebServer();
 #define POWER_ACTIVE_THRESHOLD 10.0f
 #endif
 
-// Declare the stripe pattern image
-LV_IMG_DECLARE(img_skew_strip);
 
 
 
@@ -47,7 +55,7 @@ const char* combined_path = EVCC_API_PATH;
 
 // Display and LVGL setup
 TFT_eSPI tft = TFT_eSPI();
-static lv_color_t buf[SCREEN_WIDTH * 10];
+static lv_color_t* buf = nullptr;  // draw buffer, placed in setup()
 static lv_disp_draw_buf_t draw_buf;
 static lv_disp_drv_t disp_drv;
 
@@ -68,13 +76,16 @@ AsyncWebServer server(WEB_SERVER_PORT);
 bool demoMode = false;
 
 // Log buffer globals (definitions - declarations in logging.h)
-LogEntry logBuffer[LOG_BUFFER_SIZE];
+LogEntry* logBuffer = nullptr;  // logRingInit()
+int logCapacity = 0;
 int logHead = 0;
 int logCount = 0;
 bool debugEnabled = DEBUG_MODE;
 uint32_t logTotal = 0;
 uint32_t logOverwrites = 0;
 uint32_t logDropped = 0;
+uint32_t logCollapsed = 0;
+uint32_t logRateLimited = 0;
 portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED;
 
 // UI element references (moved struct to ui_helpers.h)
@@ -82,16 +93,32 @@ UIElements ui;
 
 // (Styling and UI creation helper implementations moved to ui_helpers.*)
 
+// Log where the large buffers went (also in /status "memory")
+static void logPlacements() {
+    String msg = memPsramAvailable() ? "PSRAM " + String(ESP.getPsramSize() / 1024) + " KB:" : String("No PSRAM:");
+    MemPlacement placed[MEM_MAX_PLACEMENTS];
+    int n = memPlacements(placed, MEM_MAX_PLACEMENTS);
+    for (int i = 0; i < n; i++) {
+        msg += String(i ? ", " : " ") + placed[i].name + " " + String(placed[i].size / 1024.0f, 1) + "K " +
+               memRegionName(placed[i].region);
+    }
+    logMessage(msg);
+}
+
 // LVGL display driver callback
 void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     uint32_t w = (area->x2 - area->x1 + 1);
     uint32_t h = (area->y2 - area->y1 + 1);
+    uint32_t start = micros();
     
     tft.startWrite();
     tft.setAddrWindow(area->x1, area->y1, w, h);
     tft.pushColors((uint16_t*)&color_p->full, w * h, true);
     tft.endWrite();
     
+    perfRecordFlush(micros() - start, w * h);
+    screenshotCaptureFlush(area, color_p);
+    
     lv_disp_flush_ready(disp);
 }
 
@@ -104,51 +131,23 @@ void startWebServer() {
     logMessage("Web server started on port " + String(WEB_SERVER_PORT));
 }
 
-bool connectWiFi() {
-    logMessage("Connecting to WiFi...");
-    updateWiFiStatus("Connecting to WiFi...", ssid, "");
-    WiFi.begin(ssid, password);
-    int attempts = 0;
-    const int maxAttempts = 40; // ~20s (500ms steps)
-    while (WiFi.status() != WL_CONNECTED && attempts < maxAttempts) {
-        delay(500);
-        esp_task_wdt_reset();
-        lv_task_handler();
-        yield();
-        char progressText[56];
-        snprintf(progressText, sizeof(progressText), "Connecting to WiFi, attempt %d/%d", attempts + 1, maxAttempts);
-        updateWiFiStatus(progressText, ssid, "");
-        attempts++;
-    }
-    if (WiFi.status() == WL_CONNECTED) {
-        logMessage("Connected! IP: " + WiFi.localIP().toString());
-        updateWiFiStatus("WiFi Connected!", ssid, WiFi.localIP().toString());
-        delay(1000);
-        return true;
-    }
-    logMessage("Failed to connect to WiFi");
-    updateWiFiStatus("WiFi Connection Failed", ssid, "Check credentials");
-    delay(2000);
-    return false;
+static String evccUrl(const char* path) {
+    if (demoMode) return String("https://demo.evcc.io") + String(path);
+    return String("http://") + evcc_host + ":" + String(evcc_port) + String(path);
 }
 
 bool httpGet(const char* path, String& response) {
     HTTPClient http;
-    String url;
-    if (demoMode) {
-        url = String("https://demo.evcc.io") + String(path);
-    } else {
-        url = String("http://") + evcc_host + ":" + String(evcc_port) + String(path);
-    }
-    logMessage(String("Requesting [") + (demoMode?"DEMO":"LIVE") + "]: " + url);
+    String url = evccUrl(path);
+    LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, String("Requesting [") + (demoMode?"DEMO":"LIVE") + "]: " + url);
     http.begin(url);
     http.setTimeout(HTTP_TIMEOUT);
     int httpCode = http.GET();
     bool success = false;
     if (httpCode == HTTP_CODE_OK) {
         response = http.getString();
-        logMessage("HTTP success: " + String(response.length()) + " chars");
-        logMessage(LOG_LEVEL_DEBUG, "HTTP Response: " + response);
+        LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, "HTTP success: " + String(response.length()) + " chars");
+        LOG_LAZY(LOG_LEVEL_DEBUG, "HTTP Response: " + response);
         success = true;
     } else {
         logMessage((uint8_t)LOG_LEVEL_ERROR, "HTTP error: " + String(httpCode));
@@ -157,15 +156,60 @@ bool httpGet(const char* path, String& response) {
     return success;
 }
 
-// Initialize stripe pattern style  
-void initStripeStyle() {
-    lv_style_init(&stripe_style);
-    lv_style_set_bg_img_src(&stripe_style, &img_skew_strip);
-    lv_style_set_bg_img_tiled(&stripe_style, true);
-    lv_style_set_bg_img_opa(&stripe_style, LV_OPA_30);
-    lv_style_set_bg_img_recolor_opa(&stripe_style, 0);
+// Tariff forecast: streamed from the socket one slot object at a time, so neither the body
+// nor a document for the whole "rates" array is ever held in memory. Works for both
+// {"result":{"rates":[...]}} and {"rates":[...]}, with the price in "value" or "price".
+// Every find/deserializeJson call may wait TARIFF_STREAM_TIMEOUT on a stalled body, and the
+// watchdog is fed between slots, so a slow server cannot reset the board from this fetch.
+bool fetchTariff() {
+    static TariffForecast incoming; // a failed fetch keeps the previous forecast
+    HTTPClient http;
+    http.useHTTP10(true); // no chunked transfer encoding in the raw stream
+    http.begin(evccUrl(TARIFF_API_PATH));
+    http.setTimeout(TARIFF_STREAM_TIMEOUT);
+    esp_task_wdt_reset();
+    int httpCode = http.GET();
+    esp_task_wdt_reset();
+    bool complete = false;
+    if (httpCode == HTTP_CODE_OK) {
+        Stream& in = *http.getStreamPtr();
+        in.setTimeout(TARIFF_STREAM_TIMEOUT);
+        StaticJsonDocument<64> filter;
+        filter["start"] = true;
+        filter["end"] = true;
+        filter["value"] = true;
+        filter["price"] = true;
+        StaticJsonDocument<TARIFF_SLOT_DOC_CAPACITY> slot;
+        time_t now = clockEpoch();
+        tariffBegin(incoming);
+        if (in.find("\"rates\"") && in.find("[")) {
+            do {
+                esp_task_wdt_reset();
+                if (deserializeJson(slot, in, DeserializationOption::Filter(filter))) break;
+                JsonVariantConst price = slot["value"];
+                if (price.isNull()) price = slot["price"];
+                if (price.isNull()) continue;
+                tariffAddSlot(incoming, clockParseIso(slot["start"] | ""), clockParseIso(slot["end"] | ""), price.as<float>(), now);
+            } while (in.findUntil(",", "]"));
+            complete = incoming.count > 0;
+        }
+        if (complete) {
+            incoming.fetchedAt = now;
+            tariff = incoming;
+            LOG_RATE_LIMITED(3600000, LOG_LEVEL_INFO, "Tariff: " + String(tariff.count) + " slots" +
+                             (tariff.dropped ? " (" + String(tariff.dropped) + " beyond the limit skipped)" : String()));
+        } else {
+            logMessage((uint8_t)LOG_LEVEL_WARN, "Tariff: no rates in response");
+        }
+    } else {
+        logMessage((uint8_t)LOG_LEVEL_WARN, "Tariff HTTP error: " + String(httpCode));
+    }
+    http.end();
+    return complete;
 }
 
+// (Stripe style and createUI moved to ui_helpers.cpp)
+
 // Stripe pattern state tracking
 bool stripe_applied = false;
 
@@ -174,248 +218,22 @@ bool stripe_applied = false;
 
 
 // (Composite bar / energy row / column / car section helpers now implemented in ui_helpers.cpp)
-// Parse combined data
-bool parseCombinedData(const String& json) {
-    DynamicJsonDocument doc(1536);
-    DeserializationError error = deserializeJson(doc, json);
-    
-    if (error) {
-    logMessage((uint8_t)LOG_LEVEL_ERROR, "Combined parse error: " + String(error.c_str()));
-        return false;
-    }
-    
-    // Parse energy data
-    data.gridPower = doc["gridPower"] | 0.0;
-    data.pvPower = doc["pvPower"] | 0.0;
-    data.batterySoc = doc["batterySoc"] | -1.0;
-    data.homePower = doc["homePower"] | 0.0;
-    data.batteryPower = doc["batteryPower"] | 0.0;
-    
-    // Parse solar forecast data
-    JsonObject solar = doc["solar"];
-    if (!solar.isNull()) {
-        data.solarForecastScale = solar["scale"] | 1.0;
-        data.solarForecastTodayEnergy = solar["todayEnergy"] | 0.0;
-    } else {
-        data.solarForecastScale = 1.0;
-        data.solarForecastTodayEnergy = 0.0;
-    }
-    
-    // Reset loadpoint data
-    data.lp1.soc = -1.0;
-    data.lp1.chargePower = 0.0;
-    data.lp1.vehicleRange = -1.0;
-    data.lp1.effectivePlanTime = "";
-    data.lp1.effectivePlanSoc = -1.0;
-    data.lp1.effectiveLimitSoc = -1.0;
-    data.lp1.planProjectedStart = "";
-    data.lp2.soc = -1.0;
-    data.lp2.chargePower = 0.0;
-    data.lp2.vehicleRange = -1.0;
-    data.lp2.effectivePlanTime = "";
-    data.lp2.effectivePlanSoc = -1.0;
-    data.lp2.effectiveLimitSoc = -1.0;
-    data.lp2.planProjectedStart = "";
-    
-    // Parse loadpoint data
-    JsonArray loadpoints = doc["loadpoints"];
-    if (loadpoints.size() > 0 && !loadpoints[0].isNull()) {
-        JsonObject lp1 = loadpoints[0];
-        data.lp1.soc = lp1["soc"] | -1.0;
-        data.lp1.chargePower = lp1["chargePower"] | 0.0;
-        data.lp1.title = lp1["title"] | "LP1";
-        data.lp1.vehicleTitle = lp1["vehicletitle"] | "";
-        data.lp1.charging = lp1["charging"] | false;
-        data.lp1.plugged = lp1["plugged"] | false;
-        data.lp1.vehicleRange = lp1["vehicleRange"] | -1.0;
-        data.lp1.effectivePlanTime = lp1["effectivePlanTime"] | "";
-        data.lp1.effectivePlanSoc = lp1["effectivePlanSoc"] | -1.0;
-        data.lp1.effectiveLimitSoc = lp1["effectiveLimitSoc"] | -1.0;
-        data.lp1.planProjectedStart = lp1["planProjectedStart"] | "";
-        data.lp1.maxCurrent = lp1["maxCurrent"] | 0.0;
-        data.lp1.offeredCurrent = lp1["offeredCurrent"] | 0.0;
-        data.lp1.phasesActive = lp1["phasesActive"] | 0;
-        data.lp1.chargeRemainingDuration = lp1["chargeRemainingDuration"] | 0;
-        data.lp1.chargedEnergy = lp1["chargedEnergy"] | 0.0;
-        JsonArray currents = lp1["chargeCurrents"];
-        for (int i = 0; i < 3 && i < currents.size(); i++) {
-            data.lp1.chargeCurrents[i] = currents[i] | 0.0;
-        }
-    }
-    
-    if (loadpoints.size() > 1 && !loadpoints[1].isNull()) {
-        JsonObject lp2 = loadpoints[1];
-        data.lp2.soc = lp2["soc"] | -1.0;
-        data.lp2.chargePower = lp2["chargePower"] | 0.0;
-        data.lp2.title = lp2["title"] | "LP2";
-        data.lp2.vehicleTitle = lp2["vehicletitle"] | "";
-        data.lp2.charging = lp2["charging"] | false;
-        data.lp2.plugged = lp2["plugged"] | false;
-        data.lp2.vehicleRange = lp2["vehicleRange"] | -1.0;
-        data.lp2.effectivePlanTime = lp2["effectivePlanTime"] | "";
-        data.lp2.effectivePlanSoc = lp2["effectivePlanSoc"] | -1.0;
-        data.lp2.effectiveLimitSoc = lp2["effectiveLimitSoc"] | -1.0;
-        data.lp2.planProjectedStart = lp2["planProjectedStart"] | "";
-        data.lp2.maxCurrent = lp2["maxCurrent"] | 0.0;
-        data.lp2.offeredCurrent = lp2["offeredCurrent"] | 0.0;
-        data.lp2.phasesActive = lp2["phasesActive"] | 0;
-        data.lp2.chargeRemainingDuration = lp2["chargeRemainingDuration"] | 0;
-        data.lp2.chargedEnergy = lp2["chargedEnergy"] | 0.0;
-        JsonArray currents = lp2["chargeCurrents"];
-        for (int i = 0; i < 3 && i < currents.size(); i++) {
-            data.lp2.chargeCurrents[i] = currents[i] | 0.0;
-        }
-    }
-    
-    // Calculate derived values
-    // float total_charge_power = data.lp1.chargePower + data.lp2.chargePower;
-    
-    
-    return true;
-}
+// (parseCombinedData moved to data_parser.cpp)
 
 
 // (Car section creation now implemented in ui_helpers.cpp)
 
-// Create UI
-void createUI() {
-    // Main screen
-    ui.screen = lv_obj_create(NULL);
-    lv_obj_set_size(ui.screen, SCREEN_WIDTH, SCREEN_HEIGHT);
-    lv_obj_set_style_bg_color(ui.screen, lv_color_hex(COLOR_GRID_BG), 0);
-    lv_obj_set_style_pad_all(ui.screen, 0, 0);
-    lv_obj_set_scrollbar_mode(ui.screen, LV_SCROLLBAR_MODE_OFF);
-    
-    // Upper container
-    ui.upper_container = lv_obj_create(ui.screen);
-    lv_obj_set_pos(ui.upper_container, 0, 0);
-    lv_obj_set_size(ui.upper_container, SCREEN_WIDTH, UPPER_SECTION_HEIGHT);
-    styleContainerWithBorder(ui.upper_container);
-    lv_obj_set_style_pad_all(ui.upper_container, PADDING, 0);
-    
-    // Create columns (IN with header, OUT without - we'll add OUT label separately)
-    lv_obj_t* in_column = createColumn(ui.upper_container, "In", PADDING, true);
-    lv_obj_t* out_column = createColumn(ui.upper_container, "Out", COLUMN_WIDTH + (2 * PADDING), false);
-    
-    // Calculate bar dimensions - center bars horizontally
-    // Total usable width minus padding on both sides
-    int totalUsableWidth = SCREEN_WIDTH - (4 * PADDING);
-    int barWidth = 360; // Fixed width for centered bars
-    int barStartX = (SCREEN_WIDTH - barWidth) / 2; // Center horizontally
-    
-    // OUT label position (right side, aligned with value columns)
-    int outLabelX = SCREEN_WIDTH - (3 * PADDING) - 60; // Right-aligned
-    
-    // Create IN bar centered at top
-    ui.in_bar.container = createCompositeBar(ui.upper_container, barStartX, 2, barWidth, 20);
-    ui.in_bar.generation_segment = createBarSegment(ui.in_bar.container, lv_color_hex(COLOR_BAR_GENERATION), &ui.in_bar.generation_label);
-    ui.in_bar.battery_out_segment = createBarSegment(ui.in_bar.container, lv_color_hex(COLOR_BAR_BATTERY_OUT), &ui.in_bar.battery_out_label);
-    ui.in_bar.grid_in_segment = createBarSegment(ui.in_bar.container, lv_color_hex(COLOR_BAR_GRID_IN), &ui.in_bar.grid_in_label);
-    // Remove background for IN bar container
-    lv_obj_set_style_bg_opa(ui.in_bar.container, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_bg_color(ui.in_bar.container, lv_color_hex(0x000000), 0); // color irrelevant when transparent
-    
-    // Create OUT bar below IN bar (offset by bar height + gap)
-    int outBarY = 2 + 20 + 4; // IN bar Y + height + gap
-    ui.out_bar.container = createCompositeBar(ui.upper_container, barStartX, outBarY, barWidth, 20);
-    ui.out_bar.consumption_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_CONSUMPTION), &ui.out_bar.consumption_label);
-    ui.out_bar.loadpoint_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_LOADPOINT), &ui.out_bar.loadpoint_label);
-    ui.out_bar.battery_in_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_BATTERY_IN), &ui.out_bar.battery_in_label);
-    ui.out_bar.grid_out_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_GRID_OUT), &ui.out_bar.grid_out_label);
-    // Remove background for OUT bar container
-    lv_obj_set_style_bg_opa(ui.out_bar.container, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_bg_color(ui.out_bar.container, lv_color_hex(0x000000), 0);
-    
-    // Create OUT label right-aligned, vertically aligned with OUT bar
-    lv_obj_t* out_header = lv_label_create(ui.upper_container);
-    lv_label_set_text(out_header, "Out");
-    styleLabelHeader(out_header);
-    positionAndAlign(out_header, outLabelX, outBarY, 60, LV_TEXT_ALIGN_RIGHT);
-
-    // Restyle IN and OUT segments to transparent frames with border
-    auto styleFrameSegment = [](lv_obj_t* seg, lv_obj_t* label){
-        if(!seg) return;
-        lv_obj_set_style_bg_opa(seg, LV_OPA_TRANSP, 0);
-        lv_obj_set_style_border_width(seg, 1, 0);
-        lv_obj_set_style_border_color(seg, lv_color_hex(BS_GRAY_MEDIUM), 0);
-        lv_obj_set_style_pad_all(seg, 0, 0);
-        lv_obj_set_style_radius(seg, 8, 0); // rounded edges
-        if(label){
-            // Override any previous contrast color to static dark text
-            lv_obj_set_style_text_color(label, lv_color_hex(BS_GRAY_DARK), 0);
-        }
-    };
-    styleFrameSegment(ui.in_bar.generation_segment, ui.in_bar.generation_label);
-    styleFrameSegment(ui.in_bar.battery_out_segment, ui.in_bar.battery_out_label);
-    styleFrameSegment(ui.in_bar.grid_in_segment, ui.in_bar.grid_in_label);
-    styleFrameSegment(ui.out_bar.consumption_segment, ui.out_bar.consumption_label);
-    styleFrameSegment(ui.out_bar.loadpoint_segment, ui.out_bar.loadpoint_label);
-    styleFrameSegment(ui.out_bar.battery_in_segment, ui.out_bar.battery_in_label);
-    styleFrameSegment(ui.out_bar.grid_out_segment, ui.out_bar.grid_out_label);
-
-    // ---------------------------------------------------------------------
-    // Overlay bar (aggregated self consumption / import / export flows)
-    // Positioned vertically centered across the space spanned by IN and OUT bars
-    // IN bar: y=2 height=20, gap=4, OUT bar: y=26 height=20
-    // Total span = 44px from y=2 to y=46. Choose overlay height 16px.
-    // Center Y = 2 + 44/2 = 24 -> top = 24 - 8 = 16
-    const int overlayHeight = 16;
-    int overlayY = 16; // computed as above
-    ui.overlay_bar.container = createCompositeBar(ui.upper_container, barStartX, overlayY, barWidth, overlayHeight);
-    if (ui.overlay_bar.container) {
-        // Bring to foreground so it visually overlaps both bars
-        lv_obj_move_foreground(ui.overlay_bar.container);
-        // Slight transparency so underlying bars can still be perceived
-        lv_obj_set_style_bg_opa(ui.overlay_bar.container, LV_OPA_TRANSP, 0);
-        // Create four segments using existing semantic colors
-        ui.overlay_bar.selfpv_segment       = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_GENERATION), &ui.overlay_bar.selfpv_label);
-        ui.overlay_bar.selfbattery_segment  = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_BATTERY_OUT), &ui.overlay_bar.selfbattery_label);
-        ui.overlay_bar.grid_import_segment  = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_GRID_IN), &ui.overlay_bar.grid_import_label);
-        ui.overlay_bar.pv_export_segment    = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_GRID_OUT), &ui.overlay_bar.pv_export_label);
-    }
-    
-    // Create energy rows (moved down by 30px: from 30/52/74/96 to 60/82/104/126)
-    createEnergyRow(in_column, "Erzeugung", "", "0W", 60, 
-                    &ui.generation.desc, &ui.generation.value1, &ui.generation.value2);
-    createEnergyRow(in_column, "Batterie entladen", "", "0W", 82, 
-                    &ui.battery_discharge.desc, &ui.battery_discharge.value1, &ui.battery_discharge.value2);
-    createEnergyRow(in_column, "Netzbezug", "", "0W", 104, 
-                    &ui.grid_feed.desc, &ui.grid_feed.value1, &ui.grid_feed.value2);
-
-    createEnergyRow(out_column, "Verbrauch", "", "0W", 60, 
-                    &ui.consumption.desc, &ui.consumption.value1, &ui.consumption.value2);
-    createEnergyRow(out_column, "Ladepunkt", "", "0W", 82, 
-                    &ui.loadpoint.desc, &ui.loadpoint.value1, &ui.loadpoint.value2);
-    createEnergyRow(out_column, "Batterie laden", "", "0W", 104, 
-                    &ui.battery_charge.desc, &ui.battery_charge.value1, &ui.battery_charge.value2);
-    createEnergyRow(out_column, "Einspeisung", "", "5W", 126, 
-                    &ui.grid_feedin.desc, &ui.grid_feedin.value1, &ui.grid_feedin.value2);
-    
-    // Lower container
-    ui.lower_container = lv_obj_create(ui.screen);
-    lv_obj_set_pos(ui.lower_container, 0, UPPER_SECTION_HEIGHT);
-    lv_obj_set_size(ui.lower_container, SCREEN_WIDTH, LOWER_SECTION_HEIGHT);
-    styleContainerWithBorder(ui.lower_container);
-    lv_obj_set_style_pad_all(ui.lower_container, PADDING, 0);
-    
-    // Create car section
-    createCarSection(ui.lower_container, "Gartenhaus", "NotAModelY");
-    
-    // Load screen
-    lv_scr_load(ui.screen);
-    
-    logMessage("UI created - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
-}
 
 // (updateUI moved)
 
 // Poll EVCC data
 bool pollEVCCData() {
-    logMessage("Starting poll - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
+    LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, "Starting poll - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
     
     // Check memory before HTTP request
     if (ESP.getFreeHeap() < 16000) {
     logMessage((uint8_t)LOG_LEVEL_WARN, "Insufficient memory for HTTP request");
+        perfCount(perf.pollFailures);
         return false;
     }
     
@@ -423,11 +241,22 @@ bool pollEVCCData() {
     response.reserve(2048); // Pre-allocate to avoid fragmentation
     
     // Get combined data in single request
-    if (httpGet(combined_path, response)) {
-        if (parseCombinedData(response)) {
-            data.lastUpdate = millis();
+    uint32_t start = micros();
+    bool fetched = httpGet(combined_path, response);
+    perfRecordPoll(micros() - start, fetched);
+    if (fetched) {
+        captureRecord(response);
+        
+        start = micros();
+        bool parsed = parseCombinedData(response, data);
+        perfRecord(perf.parse, micros() - start);
+        if (parsed) {
+            data.lastUpdate = clockMillis();
             data.consecutiveFailures = 0;
+            start = micros();
             updateUI();
+            perfRecord(perf.uiUpdate, micros() - start);
+            eventsPublish(data);
             
             // Force string cleanup
             response = String();
@@ -439,6 +268,7 @@ bool pollEVCCData() {
             
             return true;
         }
+        perfCount(perf.parseErrors);
     } else {
     logMessage((uint8_t)LOG_LEVEL_ERROR, "HTTP request failed");
     }
@@ -446,89 +276,93 @@ bool pollEVCCData() {
     return false;
 }
 
-// WiFi status display variables
-lv_obj_t* wifi_screen = nullptr;
-lv_obj_t* wifi_status_label = nullptr;
-lv_obj_t* wifi_ssid_label = nullptr;
-lv_obj_t* wifi_ip_label = nullptr;
-
-// Show initial WiFi connecting status screen
-void showWiFiConnectingStatus() {
-    // Create simple status screen
-    wifi_screen = lv_obj_create(NULL);
-    lv_obj_set_size(wifi_screen, SCREEN_WIDTH, SCREEN_HEIGHT);
-    lv_obj_set_style_bg_color(wifi_screen, lv_color_hex(0x000000), 0);
-    lv_obj_set_style_pad_all(wifi_screen, 20, 0);
-    lv_obj_set_scrollbar_mode(wifi_screen, LV_SCROLLBAR_MODE_OFF);
-    
-    // Main status label
-    wifi_status_label = lv_label_create(wifi_screen);
-    lv_label_set_text(wifi_status_label, "Initializing...");
-    lv_obj_set_style_text_font(wifi_status_label, &lv_font_montserrat_16, 0);
-    lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(0xFFFFFF), 0);
-    lv_obj_set_pos(wifi_status_label, 0, 100);
-    lv_obj_set_width(wifi_status_label, SCREEN_WIDTH - 40);
-    lv_obj_set_style_text_align(wifi_status_label, LV_TEXT_ALIGN_CENTER, 0);
-    
-    // SSID label
-    wifi_ssid_label = lv_label_create(wifi_screen);
-    lv_label_set_text(wifi_ssid_label, "");
-    lv_obj_set_style_text_font(wifi_ssid_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(wifi_ssid_label, lv_color_hex(0xCCCCCC), 0);
-    lv_obj_set_pos(wifi_ssid_label, 0, 140);
-    lv_obj_set_width(wifi_ssid_label, SCREEN_WIDTH - 40);
-    lv_obj_set_style_text_align(wifi_ssid_label, LV_TEXT_ALIGN_CENTER, 0);
-    
-    // IP/Status label
-    wifi_ip_label = lv_label_create(wifi_screen);
-    lv_label_set_text(wifi_ip_label, "");
-    lv_obj_set_style_text_font(wifi_ip_label, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_color(wifi_ip_label, lv_color_hex(0x999999), 0);
-    lv_obj_set_pos(wifi_ip_label, 0, 180);
-    lv_obj_set_width(wifi_ip_label, SCREEN_WIDTH - 40);
-    lv_obj_set_style_text_align(wifi_ip_label, LV_TEXT_ALIGN_CENTER, 0);
-    
-    // Load the screen
-    lv_scr_load(wifi_screen);
-    lv_task_handler(); // Process immediately
+// Boot runs as stages checked from loop(): setup() only starts the WiFi association and
+// brings up the display, so the dashboard (snapshot or placeholders) renders while the
+// radio associates. Once connected the web server starts, SNTP syncs in the background and
+// the first fetch runs straight away instead of waiting for the poll interval.
+enum BootStage : uint8_t { BOOT_WIFI, BOOT_FETCH, BOOT_WAIT_DATA, BOOT_DONE };
+static BootStage bootStage = BOOT_WIFI;
+static uint32_t bootStart = 0;
+static uint32_t bootOnlineAt = 0;
+static bool bootWifiSlow = false;
+static bool bootTimeSynced = false;
+
+static void bootProgress(const String& text, int percent) {
+    showBootProgress(text.c_str(), percent);
 }
 
-// Update WiFi status on screen
-void updateWiFiStatus(const String& status, const String& ssid_name, const String& ip_info) {
-    if (wifi_status_label) {
-        lv_label_set_text(wifi_status_label, status.c_str());
-    }
-    if (wifi_ssid_label && !ssid_name.isEmpty()) {
-        String ssid_text = "Network: " + ssid_name;
-        lv_label_set_text(wifi_ssid_label, ssid_text.c_str());
+static void bootService() {
+    if (bootStage == BOOT_WIFI) {
+        if (WiFi.status() == WL_CONNECTED) {
+            logMessage("Connected! IP: " + WiFi.localIP().toString());
+            bootPhaseDone(BOOT_PHASE_WIFI);
+            startWebServer();
+            statusCacheRender();
+            // configTzTime keeps the POSIX zone (configTime would reset TZ to a fixed offset)
+            configTzTime(TIMEZONE, "pool.ntp.org", "time.nist.gov");
+            bootOnlineAt = clockMillis();
+            bootStage = BOOT_FETCH;
+            bootProgress("Loading data from " + String(demoMode ? "demo.evcc.io" : evcc_host), 60);
+        } else if (!bootWifiSlow && clockElapsed(bootStart) > BOOT_WIFI_TIMEOUT) {
+            bootWifiSlow = true;
+            logMessage((uint8_t)LOG_LEVEL_WARN, "WiFi not connected after " + String(BOOT_WIFI_TIMEOUT / 1000) +
+                       " s, still trying");
+            bootProgress("WiFi " + String(ssid) + " not reachable - retrying", 10);
+        }
+        return;
     }
-    if (wifi_ip_label && !ip_info.isEmpty()) {
-        lv_label_set_text(wifi_ip_label, ip_info.c_str());
+
+    // Time syncs alongside the first fetch; plan times rendered before it are redrawn by the next poll
+    if (!bootTimeSynced && clockSynced(clockEpoch())) {
+        bootTimeSynced = true;
+        time_t now = clockEpoch();
+        logMessage("Time synchronized: " + String(ctime(&now)));
+        bootPhaseDone(BOOT_PHASE_NTP);
+    } else if (!bootTimeSynced && bootOnlineAt && clockElapsed(bootOnlineAt) > BOOT_TIME_TIMEOUT) {
+        bootOnlineAt = 0; // warn once, SNTP keeps retrying
+        logMessage((uint8_t)LOG_LEVEL_WARN, "Time not synchronized yet");
     }
-    lv_task_handler(); // Process immediately
 }
 
-// Clean up WiFi status screen and reset pointers
-void cleanupWiFiStatusScreen() {
-    if (wifi_screen) {
-        lv_obj_del(wifi_screen);
-        wifi_screen = nullptr;
-        wifi_status_label = nullptr;
-        wifi_ssid_label = nullptr;
-        wifi_ip_label = nullptr;
+// Result of a poll while booting: the strip goes away with the first live data
+static void bootPolled(bool polled) {
+    if (polled) {
+        bootPhaseDone(BOOT_PHASE_FIRST_HTTP);
+        hideBootProgress();
+        bootStage = BOOT_DONE;
+    } else if (bootStage == BOOT_FETCH) {
+        bootProgress("EVCC not reachable - retrying", 60);
+        bootStage = BOOT_WAIT_DATA;
     }
 }
 
 void setup() {
     Serial.begin(115200);
+    memPolicyInit();
+    logRingInit();
+    captureInit();
+    logRestoreFromRtc();
+    bootProfileBegin();
+    perfLoopTask = xTaskGetCurrentTaskHandle();
     logMessage("EVCC Display ESP32 - Starting...", true);
+    bootStart = clockMillis();
+    
+    // Associate in the background while the display comes up
+    logMessage("Connecting to WiFi " + String(ssid) + "...");
+    WiFi.begin(ssid, password);
+    setenv("TZ", TIMEZONE, 1);
+    tzset();
+    
+    if (snapshotRestore(data)) {
+        logMessage("Restored display data saved before the planned restart");
+    }
     
     // Initialize watchdog timer (8 seconds)
     esp_task_wdt_deinit(); // Clear any existing watchdog
     esp_task_wdt_init(8, true);
     esp_task_wdt_add(NULL);
     
-    // Initialize display FIRST for immediate feedback
+    // Initialize display
     tft.init();
     tft.setRotation(1); // Landscape
     tft.fillScreen(TFT_BLACK);
@@ -536,10 +370,21 @@ void setup() {
     // Configure backlight
     pinMode(TFT_BL, OUTPUT);
     digitalWrite(TFT_BL, HIGH);
+    bootPhaseDone(BOOT_PHASE_DISPLAY);
     
     // Initialize LVGL
     lv_init();
-    lv_disp_draw_buf_init(&draw_buf, buf, NULL, SCREEN_WIDTH * 10);
+    // 10 rows in DMA-capable internal RAM; optionally the whole frame in PSRAM (slower to
+    // push, but redraws in one pass)
+    uint32_t drawRows = 10;
+#if PSRAM_FRAMEBUFFER
+    if (memPsramAvailable()) {
+        buf = (lv_color_t*)memAllocLarge("framebuffer", sizeof(lv_color_t) * SCREEN_WIDTH * SCREEN_HEIGHT);
+        if (buf) drawRows = SCREEN_HEIGHT;
+    }
+#endif
+    if (!buf) buf = (lv_color_t*)memAllocDma("draw buffer", sizeof(lv_color_t) * SCREEN_WIDTH * drawRows);
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, SCREEN_WIDTH * drawRows);
     
     lv_disp_drv_init(&disp_drv);
     disp_drv.hor_res = SCREEN_WIDTH;
@@ -550,114 +395,66 @@ void setup() {
     
     // Initialize stripe pattern style
     initStripeStyle();
-    
-    logMessage("Display initialized - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
-    
-    // Show WiFi connecting status immediately
-    showWiFiConnectingStatus();
-    
-    // Connect to WiFi
-    if (connectWiFi()) {
-        logMessage("After WiFi - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
-        
-        // Start web server for status/logs
-        startWebServer();
-        
-        // Update status for time sync
-        updateWiFiStatus("Synchronizing time...", ssid, WiFi.localIP().toString());
-        
-        // Initialize time with proper timezone (CET/CEST for Germany)
-        configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-        setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1); // Europe/Berlin timezone
-        tzset();
-        logMessage("Waiting for time synchronization...");
-        time_t now = time(nullptr);
-        int attempts = 0;
-        while (now < 8 * 3600 * 2 && attempts < 20) {
-            delay(500);
-            now = time(nullptr);
-            attempts++;
-            // Feed watchdog and keep UI alive while waiting for time
-            esp_task_wdt_reset();
-            lv_task_handler();
-            yield();
-            // Provide a progress update every second attempt (~1s)
-            if (attempts % 2 == 0) {
-                char syncMsg[48];
-                snprintf(syncMsg, sizeof(syncMsg), "Synchronizing time (%d/20)", attempts);
-                updateWiFiStatus(syncMsg, ssid, WiFi.localIP().toString());
-            }
-        }
-    logMessage("Time synchronized: " + String(ctime(&now)));
-                
-        // Update status for HTTP test
-        updateWiFiStatus("Testing EVCC connection...", ssid, WiFi.localIP().toString());
-        
-        // Test HTTP before UI creation
-        logMessage("Testing HTTP before UI creation...");
-        String response;
-        if (httpGet(combined_path, response)) {
-            logMessage("✅ HTTP test successful before UI!");
-            parseCombinedData(response);
-        }
-        
-        logMessage("After HTTP test - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
-        
-        // Update status for UI creation
-        updateWiFiStatus("Creating interface...", ssid, WiFi.localIP().toString());
-        
-        // Create UI
-        createUI();
-        
-        // Clean up WiFi status screen
-        cleanupWiFiStatusScreen();
-        
-        logMessage("After UI creation - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
-        
-        // Update UI with initial data
-        updateUI();
-        logMessage("📊 UI updated with initial data");
-        
-        logMessage("Setup complete - Free heap: " + String(ESP.getFreeHeap()) + " bytes");
-    } else {
-        logMessage("WiFi failed - running in demo mode");
-        
-        // Keep error message visible for a moment, then switch to demo UI
-        delay(3000);
-        
-        // Create demo UI
-        createUI();
-        
-        // Clean up WiFi status screen
-        cleanupWiFiStatusScreen();
-    }
+    bootPhaseDone(BOOT_PHASE_LVGL);
+    logPlacements();
+    
+    // Dashboard right away (restored snapshot or placeholders), boot strip on top
+    createUI();
+    updateUI();
+    bootProgress("Connecting to WiFi " + String(ssid), 10);
+    bootPhaseDone(BOOT_PHASE_UI);
+    lv_refr_now(NULL);
+    bootPhaseDone(BOOT_PHASE_FIRST_FLUSH);
 }
 
 void loop() {
-    static unsigned long lastPoll = 0;
-    static unsigned long lastLVGL = 0;
-    
-    unsigned long now = millis();
-    
-    // Handle millis() overflow (every ~49 days)
-    if (now < lastPoll) {
-        lastPoll = 0;
-    }
-    if (now < lastLVGL) {
-        lastLVGL = 0;
-    }
+    // clockDue() measures wrap-safe differences, so the millis() overflow (every ~49 days)
+    // needs no special case
+    static uint32_t lastPoll = 0;
+    static uint32_t lastLVGL = 0;
+    static uint32_t lastHeartbeat = 0;
+    static uint32_t lastHeapSample = 0;
+    static uint32_t lastTariffPoll = 0;
+    static uint32_t lastTariffDraw = 0;
+    static bool tariffFetched = false;
     
     // Handle LVGL tasks (every 5ms)
-    if (now - lastLVGL >= 5) {
+    if (clockDue(lastLVGL, 5)) {
         lv_task_handler();
-        lastLVGL = now;
         esp_task_wdt_reset(); // Feed watchdog
     }
     
+    // Render bands requested by /screenshot.bmp
+    screenshotService();
+    
+    // Keep the reset history's uptime current (RTC memory, survives resets)
+    if (clockDue(lastHeartbeat, 1000)) {
+        rtcLogHeartbeat();
+    }
+    
+    // Heap trend; a projected exhaustion restarts the board in the next quiet window
+    if (clockDue(lastHeapSample, HEAP_SAMPLE_INTERVAL)) {
+        time_t now = clockEpoch();
+        heapHealthSample(ESP.getFreeHeap(), ESP.getMaxAllocHeap(), ESP.getMinFreeHeap(), now);
+        if (heapHealthRestartDue(now)) {
+            logMessage((uint8_t)LOG_LEVEL_WARN, "Planned restart: largest heap block " +
+                       String(heapHealth.last.largestBlock) + " bytes", true);
+            snapshotSave(data);
+            delay(1000);
+            ESP.restart();
+        }
+    }
+    
     // Poll EVCC data
-    if (WiFi.status() == WL_CONNECTED && now - lastPoll >= POLL_INTERVAL) {
-        lastPoll = now;
-        if (!pollEVCCData()) {
+    // (immediately once boot has WiFi, then every POLL_INTERVAL)
+    if (WiFi.status() == WL_CONNECTED && bootStage != BOOT_WIFI &&
+        (bootStage == BOOT_FETCH || clockDue(lastPoll, POLL_INTERVAL))) {
+        lastPoll = clockMillis();
+        bool polled = pollEVCCData();
+        statusCacheRender(); // once per poll, shared by all /status clients
+        if (bootStage != BOOT_DONE) bootPolled(polled);
+        if (polled) updatePhaseHistory();
+        if (!polled) {
             data.consecutiveFailures++;
             logMessage((uint8_t)LOG_LEVEL_WARN, "Poll failed (#" + String(data.consecutiveFailures) + ")");
             
@@ -670,15 +467,44 @@ void loop() {
         }
     }
     
+    // Tariff forecast on its own, slower schedule once the first data is in; the chart moves
+    // on by itself at slot boundaries
+    if (WiFi.status() == WL_CONNECTED && bootStage == BOOT_DONE &&
+        (!tariffFetched || clockDue(lastTariffPoll, TARIFF_POLL_INTERVAL))) {
+        lastTariffPoll = clockMillis();
+        tariffFetched = true;
+        if (fetchTariff()) statusCacheInvalidate();
+        updateTariffChart();
+    }
+    if (clockDue(lastTariffDraw, 60000)) {
+        updateTariffChart();
+    }
+    
+    // Settings changed via the web server
+    if (statusCacheDirty()) {
+        statusCacheRender();
+    }
+    
     // WiFi reconnection logic
-    if (WiFi.status() != WL_CONNECTED) {
-        static unsigned long lastReconnectAttempt = 0;
-        if (now - lastReconnectAttempt > 30000) { // Try every 30 seconds
+    static bool wifiWasConnected = WiFi.status() == WL_CONNECTED;
+    bool wifiConnected = WiFi.status() == WL_CONNECTED;
+    if (wifiConnected != wifiWasConnected) {
+        if (bootStage != BOOT_WIFI) perfCount(wifiConnected ? perf.wifiReconnects : perf.wifiDisconnects);
+        wifiWasConnected = wifiConnected;
+    }
+    // (the boot association gets until BOOT_WIFI_TIMEOUT before the first retry)
+    if (!wifiConnected && (bootStage != BOOT_WIFI || bootWifiSlow)) {
+        static uint32_t lastReconnectAttempt = 0;
+        if (clockDue(lastReconnectAttempt, 30000)) { // Try every 30 seconds
             logMessage((uint8_t)LOG_LEVEL_WARN, "WiFi disconnected, attempting reconnect...");
             WiFi.begin(ssid, password);
-            lastReconnectAttempt = now;
         }
     }
     
+    // Boot stages (WiFi up, time sync)
+    if (bootStage != BOOT_DONE || !bootTimeSynced) {
+        bootService();
+    }
+    
     delay(1);
 }
\ No newline at end of file
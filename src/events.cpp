@@ -0,0 +1,117 @@
+// events.cpp - Change feed of EVCCData updates
+//
+// Each applied update is diffed against a shadow copy of the previously published data and
+// only the changed fields are serialized, once, into a small ring. SSE clients read the ring
+// with their own sequence cursor, so the ring size bounds every client's queue.
+#include "events.h"
+#include <ArduinoJson.h>
+
+struct EventSlot {
+    uint16_t len;                   // 0 = delta did not fit, consumers resync from a snapshot
+    char json[EVENTS_SLOT_SIZE];
+};
+
+static EventSlot eventRing[EVENTS_RING_SIZE];
+static uint32_t eventTotal = 0;     // sequence number of the next delta
+static uint32_t eventOldest = 0;    // oldest delta still readable
+static portMUX_TYPE eventMux = portMUX_INITIALIZER_UNLOCKED;
+static EVCCData eventPrev;          // last published state
+static bool eventHavePrev = false;
+
+// Nested object that is only created once a field in it changed
+struct LazyObject {
+    JsonDocument& doc;
+    const char* key;
+    JsonObject obj;
+    LazyObject(JsonDocument& d, const char* k) : doc(d), key(k) {}
+    JsonObject get() {
+        if (obj.isNull()) obj = doc.createNestedObject(key);
+        return obj;
+    }
+};
+
+#define DIFF_FIELD(lazy, name, cur, prev) do { if ((cur) != (prev)) (lazy).get()[name] = (cur); } while (0)
+
+static void diffLoadpoint(JsonDocument& doc, const char* key, const LoadpointData& cur, const LoadpointData& prev) {
+    LazyObject lp(doc, key);
+    DIFF_FIELD(lp, "title", cur.title, prev.title);
+    DIFF_FIELD(lp, "vehicleTitle", cur.vehicleTitle, prev.vehicleTitle);
+    DIFF_FIELD(lp, "chargePower", cur.chargePower, prev.chargePower);
+    DIFF_FIELD(lp, "charging", cur.charging, prev.charging);
+    DIFF_FIELD(lp, "plugged", cur.plugged, prev.plugged);
+    DIFF_FIELD(lp, "soc", cur.soc, prev.soc);
+    DIFF_FIELD(lp, "vehicleRange", cur.vehicleRange, prev.vehicleRange);
+    DIFF_FIELD(lp, "effectivePlanSoc", cur.effectivePlanSoc, prev.effectivePlanSoc);
+    DIFF_FIELD(lp, "effectiveLimitSoc", cur.effectiveLimitSoc, prev.effectiveLimitSoc);
+    DIFF_FIELD(lp, "effectivePlanTime", cur.effectivePlanTime, prev.effectivePlanTime);
+    DIFF_FIELD(lp, "planProjectedStart", cur.planProjectedStart, prev.planProjectedStart);
+    DIFF_FIELD(lp, "phasesActive", cur.phasesActive, prev.phasesActive);
+    DIFF_FIELD(lp, "maxCurrent", cur.maxCurrent, prev.maxCurrent);
+    DIFF_FIELD(lp, "offeredCurrent", cur.offeredCurrent, prev.offeredCurrent);
+    DIFF_FIELD(lp, "chargeRemainingDuration", cur.chargeRemainingDuration, prev.chargeRemainingDuration);
+    DIFF_FIELD(lp, "chargedEnergy", cur.chargedEnergy, prev.chargedEnergy);
+    if (memcmp(cur.chargeCurrents, prev.chargeCurrents, sizeof(cur.chargeCurrents)) != 0) {
+        JsonArray currents = lp.get().createNestedArray("chargeCurrents");
+        for (int i = 0; i < 3; i++) currents.add(cur.chargeCurrents[i]);
+    }
+}
+
+void eventsSeed(const EVCCData& d) {
+    if (eventHavePrev) return;
+    eventPrev = d;
+    eventHavePrev = true;
+}
+
+void eventsPublish(const EVCCData& d) {
+    if (!eventHavePrev) {
+        // No snapshot rendered yet, so no subscriber either; consumers start from one
+        eventsSeed(d);
+        return;
+    }
+    StaticJsonDocument<1024> doc;
+    LazyObject evcc(doc, "evcc");
+    DIFF_FIELD(evcc, "gridPower", d.gridPower, eventPrev.gridPower);
+    DIFF_FIELD(evcc, "pvPower", d.pvPower, eventPrev.pvPower);
+    DIFF_FIELD(evcc, "homePower", d.homePower, eventPrev.homePower);
+    DIFF_FIELD(evcc, "batteryPower", d.batteryPower, eventPrev.batteryPower);
+    DIFF_FIELD(evcc, "batterySoc", d.batterySoc, eventPrev.batterySoc);
+    DIFF_FIELD(evcc, "solarForecastTodayEnergy", d.solarForecastTodayEnergy, eventPrev.solarForecastTodayEnergy);
+    DIFF_FIELD(evcc, "solarForecastScale", d.solarForecastScale, eventPrev.solarForecastScale);
+    diffLoadpoint(doc, "loadpoint1", d.lp1, eventPrev.lp1);
+    diffLoadpoint(doc, "loadpoint2", d.lp2, eventPrev.lp2);
+    eventPrev = d;
+    if (doc.size() == 0) return; // nothing changed
+
+    // Retire the delta this slot held, then serialize straight into it; readers only see
+    // the new one once eventTotal moves past it
+    uint32_t seq = eventTotal;
+    EventSlot& slot = eventRing[seq % EVENTS_RING_SIZE];
+    portENTER_CRITICAL(&eventMux);
+    if (seq - eventOldest >= EVENTS_RING_SIZE) eventOldest = seq - EVENTS_RING_SIZE + 1;
+    portEXIT_CRITICAL(&eventMux);
+    size_t n = doc.overflowed() ? 0 : serializeJson(doc, slot.json, sizeof(slot.json));
+    portENTER_CRITICAL(&eventMux);
+    slot.len = (n > 0 && n < sizeof(slot.json) - 1) ? (uint16_t)n : 0;
+    eventTotal = seq + 1;
+    portEXIT_CRITICAL(&eventMux);
+}
+
+void eventsSeqRange(uint32_t& oldest, uint32_t& next) {
+    portENTER_CRITICAL(&eventMux);
+    next = eventTotal;
+    oldest = eventOldest;
+    portEXIT_CRITICAL(&eventMux);
+}
+
+int eventsRead(uint32_t seq, char* out, size_t cap) {
+    int result = -1;
+    portENTER_CRITICAL(&eventMux);
+    if (seq >= eventOldest && seq < eventTotal) {
+        const EventSlot& slot = eventRing[seq % EVENTS_RING_SIZE];
+        if (slot.len == 0) result = 0;
+        else if (slot.len < cap) { memcpy(out, slot.json, slot.len); result = slot.len; }
+        else result = -2;
+    }
+    portEXIT_CRITICAL(&eventMux);
+    return result;
+}
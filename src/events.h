@@ -0,0 +1,22 @@
+// events.h - Change feed of EVCCData updates (served as Server-Sent Events on /events)
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+// Publish the fields that changed since the previous call as one delta (loop task only).
+// Deltas use the /status field names and nesting ({"evcc":{...},"loadpoint1":{...}}), so
+// a consumer deep-merges them into the last /status (or snapshot event) it has seen.
+void eventsPublish(const EVCCData& d);
+
+// Set the diff baseline to the data a /status snapshot is rendered from, once, so the first
+// poll after that is published as a delta even when it is the first eventsPublish() call
+void eventsSeed(const EVCCData& d);
+
+// Sequence numbers work like the log ring: delta N lives in slot N % EVENTS_RING_SIZE
+void eventsSeqRange(uint32_t& oldest, uint32_t& next);
+
+// Copy delta `seq` into out. Returns its length, 0 if the delta was too large to keep (the
+// consumer must resynchronize from a snapshot), -1 if it was overwritten / not written yet,
+// or -2 if it does not fit into cap (retry once the send buffer has drained).
+int eventsRead(uint32_t seq, char* out, size_t cap);
@@ -0,0 +1,151 @@
+// formatters.cpp - Display value formatting (no LVGL dependency; also built for the native env)
+#include "formatters.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include "clock.h"
+
+// Digits of v at p, returns the end
+static char* putUint(char* p, uint32_t v) {
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    while (n) *p++ = digits[--n];
+    return p;
+}
+
+static char* putText(char* p, const char* s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+// Copies the composed text into the caller's buffer
+static char* finish(char* out, size_t size, const char* text, const char* end) {
+    if (size == 0) return out;
+    size_t len = end - text;
+    if (len >= size) len = size - 1;
+    memcpy(out, text, len);
+    out[len] = '\0';
+    return out;
+}
+
+// Exact ties (1150, 11500) went through dtostrf()'s double steps in the String(value / 1000.0, n)
+// this replaces, and their representation errors round about half of them down ("1.1k",
+// "11k") in no integer pattern. Only exact ties replay those steps, so the output stays
+// identical; returns the value in units of 0.1k (decimals 1) or 1k (decimals 0).
+static uint32_t legacyTieRound(uint32_t whole, unsigned decimals) {
+    double number = whole / 1000.0 + 1.0 / (decimals ? 20.0 : 2.0);
+    double tenpow = 1.0;
+    int digits = 1;
+    while (number >= 10.0 * tenpow) { tenpow *= 10.0; digits++; }
+    number /= tenpow;
+    uint32_t result = 0;
+    for (int i = digits + decimals; i > 0; i--) {
+        int digit = (int)number;
+        if (digit > 9) digit = 9;
+        result = result * 10 + digit;
+        number -= digit;
+        number *= 10.0;
+    }
+    return result;
+}
+
+// "850W" below 1000, "4.2kW" below 10000, "12kW" above (unit "W" / "Wh")
+static char* formatKilo(char* out, size_t size, float value, const char* unit) {
+    char text[FORMAT_BUF_SIZE];
+    char* p = text;
+    float magnitude = fabsf(value);
+    if (magnitude < 1000) {
+        int whole = (int)value;     // truncates toward zero
+        if (whole < 0) *p++ = '-';
+        p = putUint(p, whole < 0 ? -whole : whole);
+    } else if (isnan(value) || isinf(value)) {
+        p = putText(p, isnan(value) ? "nan" : "inf");
+        *p++ = 'k';
+    } else {
+        if (value < 0) *p++ = '-';
+        // Whole units suffice: floor((x + 50) / 100) == floor((floor(x) + 50) / 100)
+        uint32_t whole = magnitude < 4e9f ? (uint32_t)magnitude : 4000000000u;
+        if (magnitude < 10000) {
+            uint32_t tenths = whole % 100 == 50 && magnitude == (float)whole ? legacyTieRound(whole, 1) : (whole + 50) / 100;
+            p = putUint(p, tenths / 10);
+            *p++ = '.';
+            *p++ = '0' + tenths % 10;
+        } else {
+            bool tie = whole % 1000 == 500 && magnitude == (float)whole;
+            p = putUint(p, tie ? legacyTieRound(whole, 0) : whole / 1000 + (whole % 1000 >= 500));
+        }
+        *p++ = 'k';
+    }
+    p = putText(p, unit);
+    return finish(out, size, text, p);
+}
+
+char* formatPower(char* out, size_t size, float watts) {
+    return formatKilo(out, size, watts, "W");
+}
+
+char* formatEnergy(char* out, size_t size, float wh) {
+    return formatKilo(out, size, wh, "Wh");
+}
+
+// Whole value with a suffix, or the placeholder when negative (unknown)
+static char* formatWhole(char* out, size_t size, float value, const char* suffix, const char* unknown) {
+    char text[FORMAT_BUF_SIZE];
+    char* p = text;
+    if (value >= 0) {
+        p = putUint(p, value < 4e9f ? (uint32_t)value : 4000000000u);
+        p = putText(p, suffix);
+    } else {
+        p = putText(p, unknown);
+    }
+    return finish(out, size, text, p);
+}
+
+char* formatPercentage(char* out, size_t size, float value) {
+    return formatWhole(out, size, value, "%", "---");
+}
+
+char* formatDistance(char* out, size_t size, float value) {
+    return formatWhole(out, size, value, "km", "-- km");
+}
+
+char* formatDuration(char* out, size_t size, int seconds) {
+    char text[FORMAT_BUF_SIZE];
+    char* p = text;
+    if (seconds <= 0) {
+        p = putText(p, "--:--");
+    } else {
+        uint32_t hours = seconds / 3600;
+        uint32_t minutes = (seconds % 3600) / 60;
+        if (hours < 10) *p++ = '0';
+        p = putUint(p, hours);
+        *p++ = ':';
+        *p++ = '0' + minutes / 10;
+        *p++ = '0' + minutes % 10;
+        if (p - text > 7) p = text + 7;    // "hhhh:mm" is the widest the label shows
+    }
+    return finish(out, size, text, p);
+}
+
+String formatPlanTime(const String& isoTime) {
+    time_t target = clockParseIso(isoTime.c_str());
+    if (target == 0) return "keiner";
+    time_t now = clockEpoch();
+    // The target's own offset, so plans across a DST change show the time they will start at
+    struct tm local, today;
+    localtime_r(&target, &local);
+    localtime_r(&now, &today);
+    int daysDiff = clockDayNumber(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) -
+                   clockDayNumber(today.tm_year + 1900, today.tm_mon + 1, today.tm_mday);
+    const char* germanDays[] = {"Sonntag","Montag","Dienstag","Mittwoch","Donnerstag","Freitag","Samstag"};
+    String dayString;
+    if (daysDiff == 0) dayString = "Heute"; else if (daysDiff == 1) dayString = "Morgen";
+    else if (daysDiff >= 2 && daysDiff < 7) dayString = String(germanDays[local.tm_wday]);
+    else dayString = String(local.tm_mday) + "." + String(local.tm_mon + 1) + ".";
+    char timeBuf[6]; snprintf(timeBuf, sizeof(timeBuf), "%02d:%02d", local.tm_hour, local.tm_min);
+    return dayString + " " + timeBuf;
+}
@@ -0,0 +1,16 @@
+// formatters.h - Display value formatting helpers
+#pragma once
+
+#include <Arduino.h>
+
+// Number formatters write into a caller buffer (FORMAT_BUF_SIZE fits every result, shorter
+// buffers truncate) and return it. Integer arithmetic only: kilo values round half away from
+// zero on the whole-unit value, no double division or String temporaries.
+#define FORMAT_BUF_SIZE 16
+
+char* formatPower(char* out, size_t size, float watts);         // "850W", "4.2kW", "12kW"
+char* formatEnergy(char* out, size_t size, float wh);           // "850Wh", "4.2kWh", "12kWh"
+char* formatPercentage(char* out, size_t size, float value);    // "80%", "---" when negative (unknown)
+char* formatDistance(char* out, size_t size, float value);      // "320km", "-- km" when negative (unknown)
+char* formatDuration(char* out, size_t size, int seconds);      // "01:35", "--:--" when not positive
+String formatPlanTime(const String& isoTime); // ISO 8601 time (Z or offset) -> "Heute 07:00", "Montag 07:00", "24.12. 07:00"
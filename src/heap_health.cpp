@@ -0,0 +1,108 @@
+// heap_health.cpp - Heap trend and restart planning (no LVGL dependency, runs in the soak harness)
+#include "heap_health.h"
+#include "clock.h"
+#include "logging.h"
+
+#define HEAP_SAMPLES_PER_HOUR (3600000UL / HEAP_SAMPLE_INTERVAL)
+
+HeapHealth heapHealth;
+
+int heapHealthHourly(HeapSample* out, int maxSamples) {
+    const HeapHealth& h = heapHealth;
+    int n = 0;
+    int first = h.hourCount < HEAP_TREND_HOURS ? 0 : h.hourHead;
+    for (int i = 0; i < h.hourCount && n < maxSamples; i++) out[n++] = h.hourly[(first + i) % HEAP_TREND_HOURS];
+    return n;
+}
+
+// Least-squares slope (per hour) of one field over the hourly minima
+static float trend(const HeapSample* s, int n, uint32_t HeapSample::*field) {
+    float sx = 0, sy = 0, sxy = 0, sxx = 0;
+    for (int i = 0; i < n; i++) {
+        float y = (float)(s[i].*field);
+        sx += i;
+        sy += y;
+        sxy += i * y;
+        sxx += (float)i * i;
+    }
+    float d = n * sxx - sx * sx;
+    return d > 0 ? (n * sxy - sx * sy) / d : 0.0f;
+}
+
+static void updateTrend() {
+    HeapHealth& h = heapHealth;
+    HeapSample s[HEAP_TREND_HOURS];
+    int n = heapHealthHourly(s, HEAP_TREND_HOURS);
+    h.largestTrend = trend(s, n, &HeapSample::largestBlock);
+    h.freeTrend = trend(s, n, &HeapSample::freeBytes);
+    h.hoursToFloor = -1;
+    if (n < HEAP_TREND_MIN_HOURS) return;
+    uint32_t latest = s[n - 1].largestBlock;
+    if (latest <= HEAP_LARGEST_BLOCK_FLOOR) {
+        h.hoursToFloor = 0;
+    } else if (h.largestTrend < 0) {
+        h.hoursToFloor = (int32_t)((latest - HEAP_LARGEST_BLOCK_FLOOR) / -h.largestTrend);
+    }
+}
+
+// Start of the next quiet window; `now` itself while inside one
+static time_t nextQuietWindow(time_t now) {
+    struct tm t;
+    localtime_r(&now, &t);
+    if (t.tm_hour == HEAP_RESTART_HOUR) return now;
+    if (t.tm_hour > HEAP_RESTART_HOUR) t.tm_mday++;
+    t.tm_hour = HEAP_RESTART_HOUR;
+    t.tm_min = 0;
+    t.tm_sec = 0;
+    t.tm_isdst = -1;
+    return mktime(&t);
+}
+
+static void plan(time_t now) {
+    HeapHealth& h = heapHealth;
+    if (HEAP_RESTART_HOUR < 0 || !clockSynced(now)) return;
+    bool degrading = h.hoursToFloor >= 0 && h.hoursToFloor <= HEAP_RESTART_HORIZON_HOURS;
+    if (degrading && h.restartAt == 0) {
+        h.restartAt = nextQuietWindow(now);
+        char when[8];
+        struct tm t;
+        localtime_r(&h.restartAt, &t);
+        strftime(when, sizeof(when), "%H:%M", &t);
+        logMessage(LOG_LEVEL_WARN, "Heap degrading: largest block " + String(h.last.largestBlock) + " B, trend " +
+                   String((long)h.largestTrend) + " B/h, floor in ~" + String(h.hoursToFloor) +
+                   " h; restart planned at " + when);
+    } else if (!degrading && h.restartAt != 0) {
+        h.restartAt = 0;
+        logMessage(LOG_LEVEL_INFO, "Heap trend recovered, planned restart cancelled");
+    }
+}
+
+void heapHealthSample(uint32_t freeBytes, uint32_t largestBlock, uint32_t minFree, time_t now) {
+    HeapHealth& h = heapHealth;
+    h.last.freeBytes = freeBytes;
+    h.last.largestBlock = largestBlock;
+    h.last.minFree = minFree;
+    if (h.hourSamples == 0) {
+        h.hourMin = h.last;
+    } else {
+        h.hourMin.freeBytes = std::min(h.hourMin.freeBytes, freeBytes);
+        h.hourMin.largestBlock = std::min(h.hourMin.largestBlock, largestBlock);
+        h.hourMin.minFree = minFree;
+    }
+    if (++h.hourSamples >= HEAP_SAMPLES_PER_HOUR) {
+        h.hourly[h.hourHead] = h.hourMin;
+        h.hourHead = (h.hourHead + 1) % HEAP_TREND_HOURS;
+        if (h.hourCount < HEAP_TREND_HOURS) h.hourCount++;
+        h.hourSamples = 0;
+        updateTrend();
+    }
+    plan(now);
+}
+
+bool heapHealthRestartDue(time_t now) {
+    HeapHealth& h = heapHealth;
+    if (h.restartAt == 0 || now < h.restartAt) return false;
+    if (now < h.restartAt + 3600) return true;
+    h.restartAt = nextQuietWindow(now);
+    return false;
+}
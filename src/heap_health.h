@@ -0,0 +1,43 @@
+// heap_health.h - Heap health tracker: largest-free-block trend and planned restarts
+//
+// Free heap alone hides fragmentation, which is what ends a long-running ESP32: the heap can
+// have 60 KB free in pieces too small for the HTTP client. The tracker keeps the lowest free
+// heap and largest free block of every hour, fits a trend to the largest block and, when it is
+// projected to fall below HEAP_LARGEST_BLOCK_FLOOR within HEAP_RESTART_HORIZON_HOURS, plans a
+// restart for the next quiet window (HEAP_RESTART_HOUR local time) instead of failing mid-day.
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+struct HeapSample {
+    uint32_t freeBytes = 0;
+    uint32_t largestBlock = 0;
+    uint32_t minFree = 0;       // lowest free heap since boot
+};
+
+struct HeapHealth {
+    HeapSample last;                    // newest sample
+    HeapSample hourly[HEAP_TREND_HOURS]; // per-hour minima, ring (oldest at hourHead once full)
+    uint8_t hourHead = 0;
+    uint8_t hourCount = 0;
+    HeapSample hourMin;                 // minima of the hour being collected
+    uint32_t hourSamples = 0;
+    float largestTrend = 0;             // bytes/hour (least squares over the hourly minima)
+    float freeTrend = 0;
+    int32_t hoursToFloor = -1;          // projected hours until the floor is reached, -1 = not degrading
+    time_t restartAt = 0;               // planned restart (epoch), 0 = none
+};
+
+extern HeapHealth heapHealth;
+
+// One sample every HEAP_SAMPLE_INTERVAL from the loop task; `now` is clockEpoch() (plans need
+// synced time)
+void heapHealthSample(uint32_t freeBytes, uint32_t largestBlock, uint32_t minFree, time_t now);
+
+// True once the planned restart's window has come; a window missed (clock jump, stalled loop)
+// moves the plan to the next one
+bool heapHealthRestartDue(time_t now);
+
+// Hourly minima oldest first; returns the number copied
+int heapHealthHourly(HeapSample* out, int maxSamples);
@@ -0,0 +1,165 @@
+// logging.cpp - RTC slow-memory mirror of the log ring and reset-reason history
+//
+// RTC_NOINIT memory keeps its contents across software resets, panics and watchdog
+// resets (not power loss). Every record carries its own checksum so a reset in the
+// middle of a write only loses that one record, and no global checksum has to be
+// recomputed on the logging hot path.
+#include "logging.h"
+#include <esp_system.h>
+#include "mem_policy.h"
+
+#define RTC_LOG_MAGIC 0x4C4F4732UL // "LOG2" (LogEntry with lastTimestamp)
+#define RESET_REASON_RUNNING 0xFF
+
+struct RtcLogRecord {
+    uint32_t boot;      // boot counter the entry was written in
+    uint32_t seq;       // log sequence number, orders records on restore
+    LogEntry entry;
+    uint32_t checksum;  // over everything above
+};
+
+struct RtcLogHeader {
+    uint32_t magic;
+    uint32_t boot;
+    uint32_t resetHead; // slot of the current boot in resets[]
+    uint32_t checksum;
+};
+
+struct RtcLogStore {
+    RtcLogHeader header;
+    RtcLogRecord records[RTC_LOG_ENTRIES];
+    ResetRecord resets[RTC_RESET_HISTORY];
+};
+
+RTC_NOINIT_ATTR static RtcLogStore rtcLog;
+static bool rtcLogReady = false; // mirroring is off until logRestoreFromRtc() has run
+
+// FNV-1a; cheap enough for ~120 bytes per log call
+static uint32_t rtcChecksum(const void* p, size_t len) { return fnv1a(p, len); }
+
+static void sealHeader() { rtcLog.header.checksum = rtcChecksum(&rtcLog.header, offsetof(RtcLogHeader, checksum)); }
+static void sealReset(ResetRecord& r) { r.checksum = rtcChecksum(&r, offsetof(ResetRecord, checksum)); }
+static bool resetValid(const ResetRecord& r) { return r.boot != 0 && r.checksum == rtcChecksum(&r, offsetof(ResetRecord, checksum)); }
+
+void rtcLogMirror(uint32_t seq, const LogEntry& entry) {
+    if (!rtcLogReady) return;
+    RtcLogRecord& rec = rtcLog.records[seq % RTC_LOG_ENTRIES];
+    rec.boot = rtcLog.header.boot;
+    rec.seq = seq;
+    rec.entry = entry;
+    rec.checksum = rtcChecksum(&rec, offsetof(RtcLogRecord, checksum));
+}
+
+void rtcLogHeartbeat() {
+    if (!rtcLogReady) return;
+    ResetRecord& cur = rtcLog.resets[rtcLog.header.resetHead];
+    cur.uptimeSec = clockMillis() / 1000;
+    if (cur.startEpoch == 0) {
+        time_t now = clockEpoch();
+        if (clockSynced(now)) cur.startEpoch = now - (time_t)cur.uptimeSec;
+    }
+    sealReset(cur);
+}
+
+uint32_t rtcLogBoot() { return rtcLogReady ? rtcLog.header.boot : 0; }
+
+const char* resetReasonToStr(uint8_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return "power-on";
+        case ESP_RST_EXT:       return "external";
+        case ESP_RST_SW:        return "software";
+        case ESP_RST_PANIC:     return "panic";
+        case ESP_RST_INT_WDT:   return "interrupt watchdog";
+        case ESP_RST_TASK_WDT:  return "task watchdog";
+        case ESP_RST_WDT:       return "watchdog";
+        case ESP_RST_DEEPSLEEP: return "deep sleep";
+        case ESP_RST_BROWNOUT:  return "brownout";
+        case ESP_RST_SDIO:      return "sdio";
+        case RESET_REASON_RUNNING: return "running";
+        default:                return "unknown";
+    }
+}
+
+int rtcResetHistory(ResetRecord* out, int maxRecords) {
+    if (!rtcLogReady) return 0;
+    int n = 0;
+    for (int i = 1; i <= RTC_RESET_HISTORY && n < maxRecords; i++) {
+        const ResetRecord& r = rtcLog.resets[(rtcLog.header.resetHead + i) % RTC_RESET_HISTORY];
+        if (resetValid(r)) out[n++] = r;
+    }
+    return n;
+}
+
+void logRingInit() {
+    int entries = memPsramAvailable() ? LOG_BUFFER_SIZE_PSRAM : LOG_BUFFER_SIZE;
+    logBuffer = (LogEntry*)memAllocLarge("log ring", entries * sizeof(LogEntry));
+    if (!logBuffer && entries != LOG_BUFFER_SIZE) {
+        entries = LOG_BUFFER_SIZE;
+        logBuffer = (LogEntry*)memAllocLarge("log ring", entries * sizeof(LogEntry));
+    }
+    logCapacity = logBuffer ? entries : 0;
+}
+
+// Append a previous-boot entry to the RAM ring without mirroring it back to RTC
+static void appendRestored(const LogEntry& e) {
+    if (logCapacity == 0) return;
+    portENTER_CRITICAL(&logMux);
+    logBuffer[logHead] = e;
+    logBuffer[logHead].flags |= LOG_FLAG_RESTORED;
+    logHead = (logHead + 1) % logCapacity;
+    if (logCount < logCapacity) logCount++; else logOverwrites++;
+    logTotal++;
+    portEXIT_CRITICAL(&logMux);
+}
+
+void logRestoreFromRtc() {
+    esp_reset_reason_t reason = esp_reset_reason();
+    bool valid = rtcLog.header.magic == RTC_LOG_MAGIC &&
+                 rtcLog.header.checksum == rtcChecksum(&rtcLog.header, offsetof(RtcLogHeader, checksum)) &&
+                 rtcLog.header.resetHead < RTC_RESET_HISTORY;
+    int restored = 0;
+    uint32_t prevUptime = 0;
+    if (valid) {
+        // Collect intact records of the previous boot, oldest first (insertion sort, N is tiny)
+        uint32_t prevBoot = rtcLog.header.boot;
+        const RtcLogRecord* order[RTC_LOG_ENTRIES];
+        for (int i = 0; i < RTC_LOG_ENTRIES; i++) {
+            const RtcLogRecord& rec = rtcLog.records[i];
+            if (rec.boot != prevBoot || rec.checksum != rtcChecksum(&rec, offsetof(RtcLogRecord, checksum))) continue;
+            int j = restored++;
+            while (j > 0 && order[j - 1]->seq > rec.seq) { order[j] = order[j - 1]; j--; }
+            order[j] = &rec;
+        }
+        for (int i = 0; i < restored; i++) appendRestored(order[i]->entry);
+
+        // Close the previous boot's history record with the reason it ended
+        ResetRecord& prev = rtcLog.resets[rtcLog.header.resetHead];
+        if (resetValid(prev)) {
+            prev.endReason = (uint8_t)reason;
+            prevUptime = prev.uptimeSec;
+            sealReset(prev);
+        }
+    } else {
+        memset(&rtcLog, 0, sizeof(rtcLog));
+        rtcLog.header.magic = RTC_LOG_MAGIC;
+        rtcLog.header.resetHead = RTC_RESET_HISTORY - 1;
+    }
+
+    // Open a history record for this boot
+    rtcLog.header.boot++;
+    rtcLog.header.resetHead = (rtcLog.header.resetHead + 1) % RTC_RESET_HISTORY;
+    sealHeader();
+    ResetRecord& cur = rtcLog.resets[rtcLog.header.resetHead];
+    memset(&cur, 0, sizeof(cur));
+    cur.boot = rtcLog.header.boot;
+    cur.endReason = RESET_REASON_RUNNING;
+    sealReset(cur);
+    rtcLogReady = true;
+
+    bool abnormal = reason == ESP_RST_PANIC || reason == ESP_RST_INT_WDT || reason == ESP_RST_TASK_WDT ||
+                    reason == ESP_RST_WDT || reason == ESP_RST_BROWNOUT;
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Boot #%lu, reset reason: %s (previous uptime %lus, %d entries restored)",
+             (unsigned long)rtcLog.header.boot, resetReasonToStr((uint8_t)reason), (unsigned long)prevUptime, restored);
+    logMessage(abnormal ? LOG_LEVEL_WARN : LOG_LEVEL_INFO, String(msg), true);
+}
@@ -8,25 +8,60 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "clock.h"
 
 // Log buffer structure (fixed-size ring buffer)
 struct LogEntry {
     unsigned long timestamp; // ms since boot
+    uint32_t lastTimestamp;  // ms since boot of the newest collapsed repeat (= timestamp if none)
     time_t epoch;            // epoch seconds (0 if not synced yet)
     uint8_t level;           // log level
+    uint8_t flags;           // LOG_FLAG_* bits
+    uint16_t repeat;         // identical consecutive messages collapsed into this entry
     char message[96];        // fixed-size message buffer
 };
 
+#define LOG_FLAG_RESTORED 0x01   // recovered from RTC memory after a reset (previous boot)
+
 // Global log state
-extern LogEntry logBuffer[LOG_BUFFER_SIZE];
+extern LogEntry* logBuffer;      // logCapacity entries, placed by logRingInit()
+extern int logCapacity;
 extern int logHead;
 extern int logCount;
 extern bool debugEnabled;
 extern uint32_t logTotal;
 extern uint32_t logOverwrites;
 extern uint32_t logDropped;
+extern uint32_t logCollapsed;   // consecutive duplicates folded into the previous entry
+extern uint32_t logRateLimited; // calls suppressed by LOG_RATE_LIMITED
 extern portMUX_TYPE logMux;
 
+// Crash-surviving mirror of the newest entries in RTC slow memory (logging.cpp)
+void rtcLogMirror(uint32_t seq, const LogEntry& entry); // called with logMux held
+void logRingInit();         // allocates the ring (PSRAM-sized when available); first thing in setup()
+void logRestoreFromRtc();   // call once at boot before the first logMessage()
+void rtcLogHeartbeat();     // refreshes the current boot's uptime in the reset history
+uint32_t rtcLogBoot();      // boot counter of the running boot (0 before logRestoreFromRtc())
+const char* resetReasonToStr(uint8_t reason);
+
+// Reset history record (one per boot, newest last)
+struct ResetRecord {
+    uint32_t boot;       // boot counter since RTC memory was last initialized
+    uint32_t uptimeSec;  // uptime reached (updated by rtcLogHeartbeat)
+    time_t startEpoch;   // wall clock of first heartbeat with synced time (0 if never)
+    uint8_t endReason;   // esp_reset_reason_t that ended this boot (0xFF while running)
+    uint32_t checksum;
+};
+int rtcResetHistory(ResetRecord* out, int maxRecords); // copies valid records, oldest first
+
+// FNV-1a over a byte range, used for the RTC record checksums and the /status ETag; pass a
+// previous result as `h` to continue hashing across several ranges
+inline uint32_t fnv1a(const void* data, size_t len, uint32_t h = 2166136261UL) {
+    const uint8_t* b = (const uint8_t*)data;
+    while (len--) { h ^= *b++; h *= 16777619UL; }
+    return h;
+}
+
 // Convert level to short string
 inline const char* levelToStr(uint8_t lvl) {
     switch(lvl) {
@@ -39,29 +74,53 @@ inline const char* levelToStr(uint8_t lvl) {
     }
 }
 
+// Levels up to LOG_MIN_LEVEL are stored; debug mode additionally stores DEBUG
+inline bool logLevelEnabled(uint8_t level) {
+    uint8_t maxLevel = (debugEnabled && LOG_MIN_LEVEL < LOG_LEVEL_DEBUG) ? LOG_LEVEL_DEBUG : LOG_MIN_LEVEL;
+    return level <= maxLevel;
+}
+
 // Core logging function
 inline void logMessage(uint8_t level, const String& msg, bool forceSerial = false) {
     if (level > LOG_LEVEL_VERBOSE) level = LOG_LEVEL_VERBOSE; // clamp
-    if (level < LOG_MIN_LEVEL) {
+    if (!logLevelEnabled(level) || logCapacity == 0) {
         // Considered dropped for display purposes
         logDropped++;
         return;
     }
-    unsigned long nowMs = millis();
-    time_t nowEpoch = time(nullptr);
+    uint32_t nowMs = clockMillis();
+    time_t nowEpoch = clockEpoch();
+    size_t len = msg.length();
+    if (len > sizeof(LogEntry::message) - 1) len = sizeof(LogEntry::message) - 1;
 
     portENTER_CRITICAL(&logMux);
+    // Collapse consecutive duplicates into the previous entry's repeat count
+    if (logCount > 0) {
+        LogEntry &last = logBuffer[(logHead + logCapacity - 1) % logCapacity];
+        if (last.level == level && !(last.flags & LOG_FLAG_RESTORED) &&
+            last.message[len] == '\0' && memcmp(last.message, msg.c_str(), len) == 0) {
+            if (last.repeat < UINT16_MAX) last.repeat++;
+            last.lastTimestamp = nowMs;
+            logCollapsed++;
+            rtcLogMirror(logTotal - 1, last);
+            portEXIT_CRITICAL(&logMux);
+            if (forceSerial) Serial.println(msg);
+            return;
+        }
+    }
     LogEntry &slot = logBuffer[logHead];
     slot.timestamp = nowMs;
+    slot.lastTimestamp = nowMs;
     slot.epoch = nowEpoch;
     slot.level = level;
+    slot.flags = 0;
+    slot.repeat = 0;
     // Copy message into fixed buffer
-    size_t len = msg.length();
-    if (len > sizeof(slot.message) - 1) len = sizeof(slot.message) - 1;
     memcpy(slot.message, msg.c_str(), len);
     slot.message[len] = '\0';
-    logHead = (logHead + 1) % LOG_BUFFER_SIZE;
-    if (logCount < LOG_BUFFER_SIZE) {
+    rtcLogMirror(logTotal, slot);
+    logHead = (logHead + 1) % logCapacity;
+    if (logCount < logCapacity) {
         logCount++;
     } else {
         logOverwrites++;
@@ -79,4 +138,71 @@ inline void logMessage(const String& message, bool forceSerial = false) {
     logMessage((uint8_t)LOG_LEVEL_INFO, message, forceSerial);
 }
 
+// Per-call-site rate limiting. The message expression is only evaluated (formatted) when the
+// level is enabled and the site's interval has elapsed; the next logged message reports how
+// many calls were suppressed in between. Usage: LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, "x" + String(y));
+struct LogRateLimit {
+    uint32_t last = 0;          // clockMillis()
+    uint32_t suppressed = 0;
+    bool primed = false;
+};
+
+inline bool logRateAllow(LogRateLimit& rl, uint32_t intervalMs, uint32_t& suppressedOut) {
+    uint32_t now = clockMillis();
+    if (rl.primed && now - rl.last < intervalMs) {
+        rl.suppressed++;
+        logRateLimited++;
+        return false;
+    }
+    suppressedOut = rl.suppressed;
+    rl.suppressed = 0;
+    rl.last = now;
+    rl.primed = true;
+    return true;
+}
+
+#define LOG_RATE_LIMITED(intervalMs, level, msgExpr) do { \
+    static LogRateLimit _logRl; \
+    uint32_t _logSup = 0; \
+    if (logLevelEnabled(level) && logRateAllow(_logRl, (intervalMs), _logSup)) { \
+        if (_logSup) logMessage((level), String(msgExpr) + " [+" + String(_logSup) + " suppressed]"); \
+        else logMessage((level), (msgExpr)); \
+    } \
+} while (0)
+
+// Level-gated logging: skips building expensive messages that would be dropped anyway
+#define LOG_LAZY(level, msgExpr) do { if (logLevelEnabled(level)) logMessage((level), (msgExpr)); } while (0)
+
+// Sequence numbers: entry N (0-based, counted by logTotal) lives in slot N % logCapacity.
+// Readers use them as cursors so they never need to snapshot the whole ring.
+inline void logSeqRange(uint32_t& oldest, uint32_t& next) {
+    portENTER_CRITICAL(&logMux);
+    next = logTotal;
+    oldest = logTotal - (uint32_t)logCount;
+    portEXIT_CRITICAL(&logMux);
+}
+
+// Copy a single entry by sequence number; false if it was overwritten or not written yet
+inline bool logReadEntry(uint32_t seq, LogEntry& out) {
+    bool ok = false;
+    portENTER_CRITICAL(&logMux);
+    uint32_t oldest = logTotal - (uint32_t)logCount;
+    if (seq >= oldest && seq < logTotal) {
+        out = logBuffer[seq % logCapacity];
+        ok = true;
+    }
+    portEXIT_CRITICAL(&logMux);
+    return ok;
+}
+
+// Wall clock of an entry's newest collapsed repeat; 0 when the entry predates the time sync
+inline time_t logLastEpoch(const LogEntry& e) {
+    return e.epoch ? e.epoch + (time_t)((uint32_t)(e.lastTimestamp - e.timestamp) / 1000) : 0;
+}
+
+// Shared level filter for /logs and /logs/stream: ?level=warn shows ERR and WRN, etc.
+inline bool logLevelVisible(uint8_t entryLevel, uint8_t filterLevel) {
+    return entryLevel <= filterLevel;
+}
+
 #endif // LOGGING_H
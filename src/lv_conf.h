@@ -47,12 +47,12 @@
 /* Default font */
 #define LV_FONT_DEFAULT &lv_font_montserrat_12
 
-/* Memory settings */
-#define LV_MEM_CUSTOM 1
-#if LV_MEM_CUSTOM == 1
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+/* Memory settings: LVGL allocates from its own static TLSF pool, so widgets, label texts and
+   styles never share (and fragment) the heap used by HTTP, JSON and Strings. Size it with
+   -D LV_MEM_SIZE=...; lv_mem_monitor() stats are published in /status ("lvglMem"). */
+#define LV_MEM_CUSTOM 0
+#ifndef LV_MEM_SIZE
+    #define LV_MEM_SIZE (48U * 1024U)
 #endif
 
 /* HAL settings */
@@ -71,12 +71,12 @@
 /* Animation */
 #define LV_USE_ANIMATION 1
 
-/* Widgets: keep only those actually used (obj, label, bar, img for stripe, maybe line). */
+/* Widgets: keep only those actually used (obj, label, bar, img for stripe, canvas for the phase chart). */
 #define LV_USE_ARC        1
 #define LV_USE_BAR        1
 #define LV_USE_BTN        1
 #define LV_USE_BTNMATRIX  1
-#define LV_USE_CANVAS     0
+#define LV_USE_CANVAS     1
 #define LV_USE_CHECKBOX   0
 #define LV_USE_DROPDOWN   0
 #define LV_USE_IMG        1
@@ -0,0 +1,63 @@
+// mem_policy.cpp - PSRAM detection and buffer placement
+#include "mem_policy.h"
+#include <esp_heap_caps.h>
+
+static bool memPsram = false;
+static MemPlacement placements[MEM_MAX_PLACEMENTS];
+static int placementCount = 0;
+static portMUX_TYPE memMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Same name again (e.g. the per-request /capture buffers) updates its entry
+static void record(const char* name, size_t size, MemRegion region) {
+    portENTER_CRITICAL(&memMux);
+    int i = 0;
+    while (i < placementCount && strcmp(placements[i].name, name) != 0) i++;
+    if (i < MEM_MAX_PLACEMENTS) {
+        placements[i] = {name, (uint32_t)size, region};
+        if (i == placementCount) placementCount++;
+    }
+    portEXIT_CRITICAL(&memMux);
+}
+
+void memPolicyInit() {
+    // psramFound() is only true when the core initialized it (board with PSRAM and
+    // -DBOARD_HAS_PSRAM); heap_caps then has a SPIRAM region to allocate from
+    memPsram = psramFound() && heap_caps_get_free_size(MALLOC_CAP_SPIRAM) > 0;
+}
+
+bool memPsramAvailable() { return memPsram; }
+
+void* memAllocLarge(const char* name, size_t size) {
+    void* p = nullptr;
+    if (memPsram) {
+        p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (p) record(name, size, MEM_PSRAM);
+    }
+    if (!p) {
+        p = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (p) record(name, size, MEM_INTERNAL);
+    }
+    return p;
+}
+
+void* memAllocDma(const char* name, size_t size) {
+    void* p = heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (p) record(name, size, MEM_DMA);
+    return p;
+}
+
+int memPlacements(MemPlacement* out, int maxPlacements) {
+    portENTER_CRITICAL(&memMux);
+    int n = placementCount < maxPlacements ? placementCount : maxPlacements;
+    memcpy(out, placements, n * sizeof(MemPlacement));
+    portEXIT_CRITICAL(&memMux);
+    return n;
+}
+
+const char* memRegionName(MemRegion region) {
+    switch (region) {
+        case MEM_PSRAM: return "psram";
+        case MEM_DMA:   return "dma";
+        default:        return "internal";
+    }
+}
@@ -0,0 +1,34 @@
+// mem_policy.h - Placement of the large buffers: PSRAM when the board has it, internal DRAM otherwise
+//
+// Buffers only touched by the CPU at poll or request rate (log ring, capture ring, /status
+// cache, /capture and screenshot work buffers, optional framebuffer) go to PSRAM on
+// WROVER-class boards and grow to the PSRAM sizes in config.h. Buffers the SPI driver reads
+// on every flush stay in DMA-capable internal RAM. Every placement is recorded for /status.
+#pragma once
+
+#include <Arduino.h>
+
+enum MemRegion : uint8_t { MEM_INTERNAL, MEM_DMA, MEM_PSRAM };
+
+struct MemPlacement {
+    const char* name;
+    uint32_t size;
+    MemRegion region;
+};
+
+#define MEM_MAX_PLACEMENTS 8
+
+// Detects PSRAM; call first in setup(), before any buffer is placed
+void memPolicyInit();
+bool memPsramAvailable();
+
+// Non-latency-critical buffer: PSRAM if available (internal heap when it is not, or full);
+// nullptr when neither has room. Release with free().
+void* memAllocLarge(const char* name, size_t size);
+
+// Buffer the display driver transfers from: internal, DMA-capable
+void* memAllocDma(const char* name, size_t size);
+
+// Buffers recorded so far (boot-time ones; transient ones update their entry), in order
+int memPlacements(MemPlacement* out, int maxPlacements);
+const char* memRegionName(MemRegion region);
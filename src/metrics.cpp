@@ -0,0 +1,54 @@
+// metrics.cpp - Pipeline timing and health counters
+//
+// Updates are a handful of integer adds under a spinlock, cheap enough for the
+// display flush path. The 64-bit sums are why readers take a snapshot under the
+// same lock instead of reading fields directly.
+#include "metrics.h"
+
+const float POLL_LATENCY_BUCKETS[POLL_LATENCY_BUCKET_COUNT] = {0.05f, 0.1f, 0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f};
+
+PerfStats perf;
+portMUX_TYPE perfMux = portMUX_INITIALIZER_UNLOCKED;
+TaskHandle_t perfLoopTask = nullptr;
+
+static void addTiming(PerfTiming& timing, uint32_t us) {
+    timing.count++;
+    timing.sumUs += us;
+    if (us > timing.maxUs) timing.maxUs = us;
+}
+
+void perfRecord(PerfTiming& timing, uint32_t us) {
+    portENTER_CRITICAL(&perfMux);
+    addTiming(timing, us);
+    portEXIT_CRITICAL(&perfMux);
+}
+
+void perfRecordPoll(uint32_t us, bool ok) {
+    float seconds = us / 1000000.0f;
+    int bucket = 0;
+    while (bucket < POLL_LATENCY_BUCKET_COUNT && seconds > POLL_LATENCY_BUCKETS[bucket]) bucket++;
+    portENTER_CRITICAL(&perfMux);
+    addTiming(perf.poll, us);
+    perf.pollBuckets[bucket]++;
+    if (!ok) perf.pollFailures++;
+    portEXIT_CRITICAL(&perfMux);
+}
+
+void perfRecordFlush(uint32_t us, uint32_t pixels) {
+    portENTER_CRITICAL(&perfMux);
+    addTiming(perf.flush, us);
+    perf.flushPixels += pixels;
+    portEXIT_CRITICAL(&perfMux);
+}
+
+void perfCount(uint32_t& counter, uint32_t n) {
+    portENTER_CRITICAL(&perfMux);
+    counter += n;
+    portEXIT_CRITICAL(&perfMux);
+}
+
+void perfSnapshot(PerfStats& out) {
+    portENTER_CRITICAL(&perfMux);
+    out = perf;
+    portEXIT_CRITICAL(&perfMux);
+}
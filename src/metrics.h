@@ -0,0 +1,41 @@
+// metrics.h - Pipeline timing and health counters (exported on /metrics)
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+// Upper bounds (seconds) of the poll latency histogram buckets; +Inf is implicit
+#define POLL_LATENCY_BUCKET_COUNT 8
+extern const float POLL_LATENCY_BUCKETS[POLL_LATENCY_BUCKET_COUNT];
+
+// Accumulated duration of one pipeline stage
+struct PerfTiming {
+    uint32_t count = 0;
+    uint64_t sumUs = 0;
+    uint32_t maxUs = 0;
+};
+
+// Written by the loop task, read (copied under perfMux) by the web server
+struct PerfStats {
+    uint32_t pollBuckets[POLL_LATENCY_BUCKET_COUNT + 1] = {0}; // per-bucket counts, last = +Inf
+    PerfTiming poll;          // HTTP request incl. body download
+    PerfTiming parse;         // JSON -> EVCCData
+    PerfTiming uiUpdate;      // updateUI() widget changes
+    PerfTiming flush;         // display flush callback (SPI transfer)
+    PerfTiming screenshot;    // full-screen re-render for /screenshot.bmp (sum of all bands)
+    uint64_t flushPixels = 0;
+    uint32_t pollFailures = 0;
+    uint32_t parseErrors = 0;
+    uint32_t wifiDisconnects = 0;
+    uint32_t wifiReconnects = 0;
+};
+
+extern PerfStats perf;
+extern portMUX_TYPE perfMux;
+extern TaskHandle_t perfLoopTask;   // for the loop task's stack high-water mark
+
+void perfRecord(PerfTiming& timing, uint32_t us);
+void perfRecordPoll(uint32_t us, bool ok);
+void perfRecordFlush(uint32_t us, uint32_t pixels);
+void perfCount(uint32_t& counter, uint32_t n = 1);
+void perfSnapshot(PerfStats& out);
@@ -0,0 +1,46 @@
+// phase_history.cpp - Averaging and quantizing phase currents into the per-loadpoint ring
+#include "phase_history.h"
+
+static uint8_t quantize(float amps) {
+    float steps = amps / PHASE_HISTORY_STEP_A + 0.5f;
+    if (steps <= 0) return 0;
+    return steps >= 255 ? 255 : (uint8_t)steps;
+}
+
+bool phaseHistoryRecord(PhaseHistory& h, const LoadpointData& lp, uint32_t now) {
+    bool session = lp.plugged && !h.plugged;
+    h.plugged = lp.plugged;
+    if (!lp.plugged) {
+        h.polls = 0; // a sample never spans an unplug
+        return false;
+    }
+    if (session) {
+        h.head = 0;
+        h.count = 0;
+        h.polls = 0;
+    }
+    if (h.polls == 0) {
+        h.started = now;
+        h.sum[0] = h.sum[1] = h.sum[2] = 0;
+    }
+    for (int i = 0; i < 3; i++) h.sum[i] += lp.chargeCurrents[i] > 0 ? lp.chargeCurrents[i] : 0;
+    h.polls++;
+    if (now - h.started < PHASE_HISTORY_INTERVAL) return session;
+
+    uint16_t slot = (h.head + h.count) % PHASE_HISTORY_SAMPLES;
+    if (h.count < PHASE_HISTORY_SAMPLES) h.count++;
+    else h.head = (h.head + 1) % PHASE_HISTORY_SAMPLES;
+    for (int i = 0; i < 3; i++) h.samples[slot][i] = quantize(h.sum[i] / h.polls);
+    h.total++;
+    h.polls = 0;
+    return true;
+}
+
+bool phaseHistorySample(const PhaseHistory& h, int age, uint8_t out[3]) {
+    if (age < 0 || age >= h.count) return false;
+    const uint8_t* s = h.samples[(h.head + h.count - 1 - age) % PHASE_HISTORY_SAMPLES];
+    out[0] = s[0];
+    out[1] = s[1];
+    out[2] = s[2];
+    return true;
+}
@@ -0,0 +1,32 @@
+// phase_history.h - Per-loadpoint ring of quantized phase currents (no LVGL)
+//
+// Polls are averaged into one sample per PHASE_HISTORY_INTERVAL while the vehicle is plugged
+// in, and plugging in starts a new session with an empty ring. Each sample stores the three
+// phase currents as uint8 in PHASE_HISTORY_STEP_A steps, so a loadpoint's whole ring is
+// 3 * PHASE_HISTORY_SAMPLES bytes. The car section draws it as a strip chart
+// (display_updates.cpp) that shows phase switching and current throttling.
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+struct PhaseHistory {
+    uint8_t samples[PHASE_HISTORY_SAMPLES][3]; // ring, oldest at head once full
+    uint16_t head = 0;
+    uint16_t count = 0;
+    uint32_t total = 0;         // samples ever pushed; lets the chart tell how far it is behind
+    // Polls collected for the sample being built
+    float sum[3] = {0, 0, 0};
+    uint16_t polls = 0;
+    uint32_t started = 0;       // clockMillis() of the first poll in the current sample
+    bool plugged = false;
+};
+
+// Adds one poll (ignored while unplugged); returns true when the ring changed: a sample was
+// pushed because the interval since its first poll elapsed, or a new session cleared it
+bool phaseHistoryRecord(PhaseHistory& h, const LoadpointData& lp, uint32_t now);
+
+// Sample `age` steps back from the newest (0 = newest); false when there is none
+bool phaseHistorySample(const PhaseHistory& h, int age, uint8_t out[3]);
+
+inline float phaseHistoryAmps(uint8_t quantized) { return quantized * PHASE_HISTORY_STEP_A; }
@@ -0,0 +1,58 @@
+// predict.cpp - Between-poll extrapolation of SoC, remaining time and charged energy
+#include "predict.h"
+
+static bool sameBase(const ChargePrediction& p, const LoadpointData& lp) {
+    return p.baseSoc == lp.soc && p.baseEnergy == lp.chargedEnergy && p.basePower == lp.chargePower &&
+           p.baseRemaining == lp.chargeRemainingDuration && p.baseCharging == lp.charging;
+}
+
+void predictUpdate(ChargePrediction& p, const LoadpointData& lp, uint32_t now) {
+    if (!sameBase(p, lp)) {
+        // Carry the currently shown values over as offsets, but only within one charging
+        // session: starting or stopping shows the polled values right away
+        bool continuing = p.baseCharging && lp.charging;
+        p.socOffset = continuing && p.soc >= 0 && lp.soc >= 0 ? p.soc - lp.soc : 0;
+        p.energyOffset = continuing ? p.chargedEnergy - lp.chargedEnergy : 0;
+        p.remainingOffset = continuing && p.remaining > 0 && lp.chargeRemainingDuration > 0
+                            ? p.remaining - lp.chargeRemainingDuration : 0;
+        p.baseAt = now;
+        p.baseSoc = lp.soc;
+        p.baseEnergy = lp.chargedEnergy;
+        p.basePower = lp.chargePower;
+        p.baseRemaining = lp.chargeRemainingDuration;
+        p.baseCharging = lp.charging;
+    }
+    if (!lp.charging) {
+        p.soc = lp.soc;
+        p.chargedEnergy = lp.chargedEnergy;
+        p.remaining = lp.chargeRemainingDuration;
+        return;
+    }
+
+    // Unchanged values for longer than PREDICT_MAX_AGE_MS mean EVCC itself is stale: hold
+    uint32_t elapsedMs = now - p.baseAt; // wrap-safe, like clockElapsed()
+    if (elapsedMs > PREDICT_MAX_AGE_MS) elapsedMs = PREDICT_MAX_AGE_MS;
+    float seconds = elapsedMs / 1000.0f;
+    float fade = elapsedMs >= PREDICT_RECONCILE_MS ? 0.0f : 1.0f - (float)elapsedMs / PREDICT_RECONCILE_MS;
+    float power = lp.chargePower > 0 ? lp.chargePower : 0;
+
+    // Wh charged so far; the SoC follows from it when the battery capacity (kWh) is known
+    float addedWh = power * seconds / 3600.0f;
+    p.chargedEnergy = p.baseEnergy + addedWh + p.energyOffset * fade;
+    if (p.baseSoc >= 0) {
+        float soc = p.baseSoc + p.socOffset * fade;
+        if (lp.vehicleCapacity > 0) soc += addedWh / (lp.vehicleCapacity * 10.0f); // Wh / (kWh * 1000) * 100
+        float ceiling = lp.effectiveLimitSoc > 0 ? lp.effectiveLimitSoc : 100.0f;
+        if (soc > ceiling) soc = ceiling > p.baseSoc ? ceiling : p.baseSoc;
+        p.soc = soc;
+    } else {
+        p.soc = -1.0;
+    }
+    // Counts down but never reaches zero while charging (zero reads as "unknown")
+    if (p.baseRemaining > 0) {
+        float remaining = p.baseRemaining - seconds + p.remainingOffset * fade;
+        p.remaining = remaining < 60 ? 60 : (int)remaining;
+    } else {
+        p.remaining = p.baseRemaining;
+    }
+}
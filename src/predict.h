@@ -0,0 +1,32 @@
+// predict.h - Between-poll extrapolation of the car section's charging values (no LVGL)
+//
+// EVCC reports SoC, remaining time and charged energy once per poll. In between they are
+// advanced locally from chargePower (and vehicleCapacity for the SoC), so the car section
+// keeps moving at a slow poll rate or while EVCC is slow to answer. New poll values do not
+// snap the display: the difference to what was shown fades out over PREDICT_RECONCILE_MS.
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+struct ChargePrediction {
+    // Poll values the extrapolation starts from; a change in any of them starts a new base
+    uint32_t baseAt = 0;          // clockMillis()
+    float baseSoc = -1.0;
+    float baseEnergy = 0.0;
+    float basePower = 0.0;
+    int baseRemaining = 0;
+    bool baseCharging = false;
+    // Shown minus polled at the last rebase, fading to zero
+    float socOffset = 0.0;
+    float energyOffset = 0.0;
+    float remainingOffset = 0.0;
+    // Values to display (valid after predictUpdate)
+    float soc = -1.0;
+    float chargedEnergy = 0.0;
+    int remaining = 0;            // seconds, 0 = unknown
+};
+
+// Rebases on new poll values and computes the values to show at `now`; call after each poll
+// and on every display tick. While not charging the polled values pass through unchanged.
+void predictUpdate(ChargePrediction& p, const LoadpointData& lp, uint32_t now);
@@ -0,0 +1,23 @@
+// rotation.cpp - Which loadpoint the car section shows (no LVGL dependency)
+#include "rotation.h"
+#include "clock.h"
+#include "logging.h"
+
+// Loadpoint rotation logic
+LoadpointData* getActiveLoadpoint() {
+    bool lp1Charging = data.lp1.charging;
+    bool lp2Charging = data.lp2.charging;
+    if (lp1Charging && !lp2Charging) return &data.lp1;
+    if (lp2Charging && !lp1Charging) return &data.lp2;
+    if (clockDue(rotationState.lastRotation, ROTATION_INTERVAL)) {
+        rotationState.currentLoadpoint = !rotationState.currentLoadpoint;
+        LOG_RATE_LIMITED(60000, LOG_LEVEL_INFO, "Rotating to loadpoint " + String(rotationState.currentLoadpoint ? 1 : 2));
+    }
+    return rotationState.currentLoadpoint ? &data.lp1 : &data.lp2;
+}
+
+// True when the next getActiveLoadpoint() call would switch to the other loadpoint
+bool loadpointRotationDue() {
+    if (data.lp1.charging != data.lp2.charging) return false;
+    return clockElapsed(rotationState.lastRotation) >= ROTATION_INTERVAL;
+}
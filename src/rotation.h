@@ -0,0 +1,14 @@
+// rotation.h - Loadpoint rotation for the car section
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+extern EVCCData data;
+extern RotationState rotationState;
+
+// Accessor for current active loadpoint (rotation-aware)
+LoadpointData* getActiveLoadpoint();
+
+// True when the next getActiveLoadpoint() call would switch to the other loadpoint
+bool loadpointRotationDue();
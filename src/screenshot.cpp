@@ -0,0 +1,166 @@
+// screenshot.cpp - Band-wise screen capture streamed as a BMP
+//
+// LVGL may only be driven from the loop task, while response fillers run on the async_tcp
+// task. The two hand one band buffer back and forth: the filler requests a band, the loop
+// task invalidates exactly those rows and forces a refresh (the flush callback copies the
+// rendered pixels out), and the filler streams the band before requesting the next one.
+// Peak memory is one band (SCREEN_WIDTH x SCREENSHOT_BAND_ROWS pixels), never a frame.
+#include "screenshot.h"
+#include <ESPAsyncWebServer.h>
+#include "logging.h"
+#include "mem_policy.h"
+#include "metrics.h"
+
+#define SCREENSHOT_BAND_BYTES ((size_t)SCREEN_WIDTH * SCREENSHOT_BAND_ROWS * 2)
+#define SCREENSHOT_BANDS ((SCREEN_HEIGHT + SCREENSHOT_BAND_ROWS - 1) / SCREENSHOT_BAND_ROWS)
+
+enum ShotState : uint8_t {
+    SHOT_IDLE,
+    SHOT_REQUEST,   // filler wants band `band`
+    SHOT_RENDERING, // loop task is rendering it
+    SHOT_READY,     // band buffer holds band `band`
+    SHOT_DONE,      // last band sent; loop task releases the buffer
+    SHOT_ABORT      // client disconnected; loop task releases the buffer
+};
+
+static volatile uint8_t shotState = SHOT_IDLE;
+static uint32_t shotId = 0;          // ties onDisconnect to the capture it started
+static int shotBand = 0;
+static uint16_t* shotBuf = nullptr;
+static uint32_t shotRenderUs = 0;
+static bool shotCapturing = false;   // set around lv_refr_now() so normal refreshes are not copied
+static portMUX_TYPE shotMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Move from -> to atomically; false if the state was something else
+static bool shotTransition(uint8_t from, uint8_t to) {
+    bool ok = false;
+    portENTER_CRITICAL(&shotMux);
+    if (shotState == from) { shotState = to; ok = true; }
+    portEXIT_CRITICAL(&shotMux);
+    return ok;
+}
+
+static int bandRows(int band) {
+    int rows = SCREEN_HEIGHT - band * SCREENSHOT_BAND_ROWS;
+    return rows < SCREENSHOT_BAND_ROWS ? rows : SCREENSHOT_BAND_ROWS;
+}
+
+static void put16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static void put32(uint8_t* p, uint32_t v) { put16(p, v & 0xFFFF); put16(p + 2, v >> 16); }
+
+static void writeHeader(uint8_t* h) {
+    memset(h, 0, SCREENSHOT_HEADER_SIZE);
+    h[0] = 'B'; h[1] = 'M';
+    put32(h + 2, SCREENSHOT_BMP_SIZE);
+    put32(h + 10, SCREENSHOT_HEADER_SIZE);          // pixel data offset
+    put32(h + 14, 40);                              // BITMAPINFOHEADER
+    put32(h + 18, SCREEN_WIDTH);
+    put32(h + 22, (uint32_t)(-SCREEN_HEIGHT));      // negative height: rows top-down, as rendered
+    put16(h + 26, 1);                               // planes
+    put16(h + 28, 16);                              // bpp
+    put32(h + 30, 3);                               // BI_BITFIELDS
+    put32(h + 34, SCREENSHOT_BMP_SIZE - SCREENSHOT_HEADER_SIZE);
+    put32(h + 38, 2835);                            // 72 dpi
+    put32(h + 42, 2835);
+    put32(h + 54, 0xF800);                          // RGB565 masks (LV_COLOR_16_SWAP 0 = native order)
+    put32(h + 58, 0x07E0);
+    put32(h + 62, 0x001F);
+}
+
+uint32_t screenshotBegin() {
+    if (!shotTransition(SHOT_IDLE, SHOT_RENDERING)) return 0; // reserve before allocating
+    shotBuf = (uint16_t*)memAllocLarge("screenshot band", SCREENSHOT_BAND_BYTES);
+    if (!shotBuf) {
+        shotState = SHOT_IDLE;
+        return 0;
+    }
+    if (++shotId == 0) shotId = 1;
+    shotBand = 0;
+    shotRenderUs = 0;
+    shotState = SHOT_REQUEST;
+    return shotId;
+}
+
+size_t screenshotFill(uint8_t* out, size_t maxLen, size_t index) {
+    size_t used = 0;
+    if (index < SCREENSHOT_HEADER_SIZE) {
+        uint8_t header[SCREENSHOT_HEADER_SIZE];
+        writeHeader(header);
+        used = SCREENSHOT_HEADER_SIZE - index;
+        if (used > maxLen) used = maxLen;
+        memcpy(out, header + index, used);
+        index += used;
+    }
+    while (used < maxLen && index < SCREENSHOT_BMP_SIZE) {
+        size_t pixelOff = index - SCREENSHOT_HEADER_SIZE;
+        int band = pixelOff / SCREENSHOT_BAND_BYTES;
+        if (shotState != SHOT_READY || shotBand != band) break;
+        size_t bandOff = pixelOff - (size_t)band * SCREENSHOT_BAND_BYTES;
+        size_t bandLen = (size_t)SCREEN_WIDTH * bandRows(band) * 2;
+        size_t n = bandLen - bandOff;
+        if (n > maxLen - used) n = maxLen - used;
+        memcpy(out + used, (uint8_t*)shotBuf + bandOff, n);
+        used += n;
+        index += n;
+        if (bandOff + n == bandLen) {
+            if (band + 1 < SCREENSHOT_BANDS) {
+                shotBand = band + 1;
+                shotTransition(SHOT_READY, SHOT_REQUEST);
+            } else {
+                shotTransition(SHOT_READY, SHOT_DONE);
+            }
+        }
+    }
+    return used ? used : RESPONSE_TRY_AGAIN;
+}
+
+void screenshotAbort(uint32_t id) {
+    portENTER_CRITICAL(&shotMux);
+    if (id == shotId && shotState != SHOT_IDLE && shotState != SHOT_DONE) shotState = SHOT_ABORT;
+    portEXIT_CRITICAL(&shotMux);
+}
+
+void screenshotCaptureFlush(const lv_area_t* area, const lv_color_t* pixels) {
+    if (!shotCapturing) return;
+    int top = shotBand * SCREENSHOT_BAND_ROWS;
+    int bottom = top + bandRows(shotBand) - 1;
+    int y1 = area->y1 > top ? area->y1 : top;
+    int y2 = area->y2 < bottom ? area->y2 : bottom;
+    int x1 = area->x1 > 0 ? area->x1 : 0;
+    int x2 = area->x2 < SCREEN_WIDTH - 1 ? area->x2 : SCREEN_WIDTH - 1;
+    int areaW = area->x2 - area->x1 + 1;
+    for (int y = y1; y <= y2 && x1 <= x2; y++) {
+        const lv_color_t* src = pixels + (y - area->y1) * areaW + (x1 - area->x1);
+        memcpy(shotBuf + (y - top) * SCREEN_WIDTH + x1, src, (x2 - x1 + 1) * sizeof(uint16_t));
+    }
+}
+
+void screenshotService() {
+    uint8_t state = shotState;
+    if (state == SHOT_REQUEST && shotTransition(SHOT_REQUEST, SHOT_RENDERING)) {
+        lv_area_t band;
+        band.x1 = 0;
+        band.x2 = SCREEN_WIDTH - 1;
+        band.y1 = shotBand * SCREENSHOT_BAND_ROWS;
+        band.y2 = band.y1 + bandRows(shotBand) - 1;
+        uint32_t start = micros();
+        lv_obj_invalidate_area(lv_scr_act(), &band);
+        shotCapturing = true;
+        lv_refr_now(NULL);
+        shotCapturing = false;
+        shotRenderUs += micros() - start;
+        shotTransition(SHOT_RENDERING, SHOT_READY); // fails if aborted meanwhile
+        return;
+    }
+    if (state == SHOT_DONE || state == SHOT_ABORT) {
+        free(shotBuf);
+        shotBuf = nullptr;
+        if (state == SHOT_DONE) {
+            perfRecord(perf.screenshot, shotRenderUs);
+            logMessage("Screenshot: " + String(SCREENSHOT_BANDS) + " bands rendered in " + String(shotRenderUs / 1000) + " ms");
+        } else {
+            logMessage((uint8_t)LOG_LEVEL_WARN, "Screenshot aborted at band " + String(shotBand));
+        }
+        shotState = SHOT_IDLE;
+    }
+}
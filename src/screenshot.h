@@ -0,0 +1,19 @@
+// screenshot.h - Band-wise screen capture streamed as a BMP (/screenshot.bmp)
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "config.h"
+
+// 16-bit BI_BITFIELDS BMP: file header + info header + RGB565 channel masks, then rows top-down
+#define SCREENSHOT_HEADER_SIZE 66
+#define SCREENSHOT_BMP_SIZE (SCREENSHOT_HEADER_SIZE + (size_t)SCREEN_WIDTH * SCREEN_HEIGHT * 2)
+
+// Web server side (async_tcp task)
+uint32_t screenshotBegin(); // capture id, 0 if one is already running or the band buffer can't be allocated
+size_t screenshotFill(uint8_t* out, size_t maxLen, size_t index); // response filler; RESPONSE_TRY_AGAIN while a band renders
+void screenshotAbort(uint32_t id); // client went away
+
+// Loop task side
+void screenshotService();   // renders requested bands, releases finished captures
+void screenshotCaptureFlush(const lv_area_t* area, const lv_color_t* pixels); // from the display flush callback
@@ -0,0 +1,112 @@
+// snapshot.cpp - RTC slow-memory copy of EVCCData for planned restarts
+//
+// Strings are stored truncated in fixed fields; RTC_NOINIT memory survives software resets
+// but not power loss, and the checksum rejects whatever a power-on leaves there.
+#include "snapshot.h"
+#include <esp_system.h>
+#include "logging.h"
+
+#define SNAPSHOT_MAGIC 0x534E4151UL // "SNAQ": layout with vehicleCapacity
+
+struct SnapshotLoadpoint {
+    float soc, chargePower, vehicleRange, effectivePlanSoc, effectiveLimitSoc;
+    float chargeCurrents[3];
+    float maxCurrent, offeredCurrent, chargedEnergy, vehicleCapacity;
+    int32_t phasesActive, chargeRemainingDuration;
+    uint8_t charging, plugged;
+    char title[24];
+    char vehicleTitle[32];
+    char effectivePlanTime[28];
+    char planProjectedStart[28];
+};
+
+struct Snapshot {
+    uint32_t magic;
+    float gridPower, pvPower, batterySoc, homePower, batteryPower;
+    float solarForecastScale, solarForecastTodayEnergy;
+    SnapshotLoadpoint lp[2];
+    uint32_t checksum;  // over everything above
+};
+
+RTC_NOINIT_ATTR static Snapshot rtcSnapshot;
+
+static uint32_t snapshotChecksum(const Snapshot& s) { return fnv1a(&s, offsetof(Snapshot, checksum)); }
+
+static void copyText(char* out, size_t size, const String& s) {
+    strncpy(out, s.c_str(), size - 1);
+    out[size - 1] = '\0';
+}
+
+static void saveLoadpoint(SnapshotLoadpoint& o, const LoadpointData& lp) {
+    o.soc = lp.soc;
+    o.chargePower = lp.chargePower;
+    o.vehicleRange = lp.vehicleRange;
+    o.effectivePlanSoc = lp.effectivePlanSoc;
+    o.effectiveLimitSoc = lp.effectiveLimitSoc;
+    memcpy(o.chargeCurrents, lp.chargeCurrents, sizeof(o.chargeCurrents));
+    o.maxCurrent = lp.maxCurrent;
+    o.offeredCurrent = lp.offeredCurrent;
+    o.chargedEnergy = lp.chargedEnergy;
+    o.vehicleCapacity = lp.vehicleCapacity;
+    o.phasesActive = lp.phasesActive;
+    o.chargeRemainingDuration = lp.chargeRemainingDuration;
+    o.charging = lp.charging;
+    o.plugged = lp.plugged;
+    copyText(o.title, sizeof(o.title), lp.title);
+    copyText(o.vehicleTitle, sizeof(o.vehicleTitle), lp.vehicleTitle);
+    copyText(o.effectivePlanTime, sizeof(o.effectivePlanTime), lp.effectivePlanTime);
+    copyText(o.planProjectedStart, sizeof(o.planProjectedStart), lp.planProjectedStart);
+}
+
+static void restoreLoadpoint(LoadpointData& lp, const SnapshotLoadpoint& o) {
+    lp.soc = o.soc;
+    lp.chargePower = o.chargePower;
+    lp.vehicleRange = o.vehicleRange;
+    lp.effectivePlanSoc = o.effectivePlanSoc;
+    lp.effectiveLimitSoc = o.effectiveLimitSoc;
+    memcpy(lp.chargeCurrents, o.chargeCurrents, sizeof(lp.chargeCurrents));
+    lp.maxCurrent = o.maxCurrent;
+    lp.offeredCurrent = o.offeredCurrent;
+    lp.chargedEnergy = o.chargedEnergy;
+    lp.vehicleCapacity = o.vehicleCapacity;
+    lp.phasesActive = o.phasesActive;
+    lp.chargeRemainingDuration = o.chargeRemainingDuration;
+    lp.charging = o.charging;
+    lp.plugged = o.plugged;
+    lp.title = o.title;
+    lp.vehicleTitle = o.vehicleTitle;
+    lp.effectivePlanTime = o.effectivePlanTime;
+    lp.planProjectedStart = o.planProjectedStart;
+}
+
+void snapshotSave(const EVCCData& d) {
+    Snapshot& s = rtcSnapshot;
+    s.magic = SNAPSHOT_MAGIC;
+    s.gridPower = d.gridPower;
+    s.pvPower = d.pvPower;
+    s.batterySoc = d.batterySoc;
+    s.homePower = d.homePower;
+    s.batteryPower = d.batteryPower;
+    s.solarForecastScale = d.solarForecastScale;
+    s.solarForecastTodayEnergy = d.solarForecastTodayEnergy;
+    saveLoadpoint(s.lp[0], d.lp1);
+    saveLoadpoint(s.lp[1], d.lp2);
+    s.checksum = snapshotChecksum(s);
+}
+
+bool snapshotRestore(EVCCData& d) {
+    Snapshot& s = rtcSnapshot;
+    bool valid = esp_reset_reason() == ESP_RST_SW && s.magic == SNAPSHOT_MAGIC && s.checksum == snapshotChecksum(s);
+    s.magic = 0;
+    if (!valid) return false;
+    d.gridPower = s.gridPower;
+    d.pvPower = s.pvPower;
+    d.batterySoc = s.batterySoc;
+    d.homePower = s.homePower;
+    d.batteryPower = s.batteryPower;
+    d.solarForecastScale = s.solarForecastScale;
+    d.solarForecastTodayEnergy = s.solarForecastTodayEnergy;
+    restoreLoadpoint(d.lp1, s.lp[0]);
+    restoreLoadpoint(d.lp2, s.lp[1]);
+    return true;
+}
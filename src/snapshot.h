@@ -0,0 +1,15 @@
+// snapshot.h - EVCCData kept in RTC memory across a planned restart
+//
+// Saved right before heapHealthRestartDue() restarts the board and restored once in setup(),
+// so the screen comes back with the last values instead of placeholders until WiFi, time and
+// the first poll are up.
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+void snapshotSave(const EVCCData& d);
+
+// Fills `d` and returns true when the previous boot ended in a planned restart with a valid
+// snapshot; the snapshot is consumed either way
+bool snapshotRestore(EVCCData& d);
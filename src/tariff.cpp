@@ -0,0 +1,59 @@
+// tariff.cpp - Tariff forecast slots, current slot and cheapest window
+#include "tariff.h"
+#include "clock.h"
+
+TariffForecast tariff;
+
+void tariffBegin(TariffForecast& t) {
+    t.count = 0;
+    t.dropped = 0;
+    t.slotSeconds = 0;
+}
+
+bool tariffAddSlot(TariffForecast& t, time_t start, time_t end, float price, time_t now) {
+    if (clockSynced(now) && end > 0 && end <= now) return true; // already over
+    if (t.count >= TARIFF_MAX_SLOTS) {
+        t.dropped++;
+        return false;
+    }
+    float scaled = price * TARIFF_PRICE_SCALE;
+    scaled += scaled < 0 ? -0.5f : 0.5f;
+    if (scaled > INT16_MAX) scaled = INT16_MAX;
+    if (scaled < INT16_MIN) scaled = INT16_MIN;
+    t.start[t.count] = start;
+    t.price[t.count] = (int16_t)scaled;
+    if (t.count == 1) t.slotSeconds = (uint32_t)(start - t.start[0]);
+    t.count++;
+    return true;
+}
+
+int tariffCurrentSlot(const TariffForecast& t, time_t now) {
+    if (t.count == 0) return -1;
+    uint32_t len = t.slotSeconds ? t.slotSeconds : 3600;
+    for (int i = 0; i < t.count; i++) {
+        if (t.start[i] + (time_t)len > now) return i;
+    }
+    return -1;
+}
+
+int tariffCheapestWindow(const TariffForecast& t, int from, int slots) {
+    if (from < 0 || slots <= 0 || from + slots > t.count) return -1;
+    int32_t sum = 0;
+    for (int i = from; i < from + slots; i++) sum += t.price[i];
+    int32_t best = sum;
+    int bestStart = from;
+    for (int i = from + slots; i < t.count; i++) {
+        sum += t.price[i] - t.price[i - slots];
+        if (sum < best) {
+            best = sum;
+            bestStart = i - slots + 1;
+        }
+    }
+    return bestStart;
+}
+
+int tariffWindowSlots(const TariffForecast& t) {
+    uint32_t len = t.slotSeconds ? t.slotSeconds : 3600;
+    int slots = (int)((TARIFF_CHEAP_WINDOW_MINUTES * 60UL + len - 1) / len);
+    return slots > 0 ? slots : 1;
+}
@@ -0,0 +1,36 @@
+// tariff.h - Dynamic grid tariff forecast in a fixed-size slot array (no LVGL, no network)
+//
+// The forecast is fetched separately from the main poll (TARIFF_POLL_INTERVAL) and streamed
+// in slot by slot (fetchTariff() in the sketch), so memory stays at TARIFF_MAX_SLOTS slots
+// however long EVCC's forecast is. Prices are fixed-point: TARIFF_PRICE_SCALE units per
+// currency unit and kWh, i.e. 0.1 ct/kWh.
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+struct TariffForecast {
+    time_t start[TARIFF_MAX_SLOTS];   // slot start (epoch), ascending
+    int16_t price[TARIFF_MAX_SLOTS];  // per kWh, TARIFF_PRICE_SCALE units
+    uint16_t count = 0;
+    uint16_t dropped = 0;             // slots past TARIFF_MAX_SLOTS in the last fetch
+    uint32_t slotSeconds = 0;         // from the first two slots, 0 with a single slot
+    time_t fetchedAt = 0;
+};
+
+extern TariffForecast tariff;
+
+// Ingest: clear, then add slots in the order they arrive. Slots that already ended (when the
+// clock is synced) are skipped; returns false once the array is full (counted in dropped).
+void tariffBegin(TariffForecast& t);
+bool tariffAddSlot(TariffForecast& t, time_t start, time_t end, float price, time_t now);
+
+// Slot containing `now`, or the first future slot; -1 when the forecast is over
+int tariffCurrentSlot(const TariffForecast& t, time_t now);
+
+// First slot of the cheapest run of `slots` consecutive slots from `from` on (lowest sum);
+// -1 when fewer remain
+int tariffCheapestWindow(const TariffForecast& t, int from, int slots);
+
+// Slots per TARIFF_CHEAP_WINDOW_MINUTES at the forecast's resolution (at least 1)
+int tariffWindowSlots(const TariffForecast& t);
@@ -1,9 +1,15 @@
 // ui_helpers.cpp - Implementation of UI helper functions
 #include "ui_helpers.h"
 #include "assets.h" // ICON_LIGHTNING
+#include "bar_layout.h"
+#include "logging.h"
 
 // Global UI instance defined elsewhere
 extern UIElements ui;
+extern lv_style_t stripe_style;
+
+// Stripe pattern image (img_skew_strip.c)
+LV_IMG_DECLARE(img_skew_strip);
 
 // Helper: Convert RGB565 to RGB888
 static void rgb565_to_rgb888(uint16_t rgb565, uint8_t& r, uint8_t& g, uint8_t& b) {
@@ -126,9 +132,9 @@ lv_obj_t* createBarSegment(lv_obj_t* parent, lv_color_t color, lv_obj_t** label_
 
 void updateCompositeBar(lv_obj_t* container, lv_obj_t** segments, lv_obj_t** labels, float* values, int segmentCount, int barWidth) {
     if (!container || !segments || !values) return;
-    float totalPower = 0;
-    for (int i = 0; i < segmentCount; i++) if (values[i] > 0) totalPower += values[i];
-    if (totalPower < 1.0f) {
+    BarSegmentLayout layout[8];
+    if (segmentCount > 8) segmentCount = 8;
+    if (!compositeBarLayout(values, segmentCount, barWidth, layout)) {
         lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
         for (int i = 0; i < segmentCount; i++) {
             if (segments[i]) lv_obj_add_flag(segments[i], LV_OBJ_FLAG_HIDDEN);
@@ -146,13 +152,11 @@ void updateCompositeBar(lv_obj_t* container, lv_obj_t** segments, lv_obj_t** lab
     const int minWidthForValueText = 40; // overlay numeric labels
     const char* inNames[4] = {"pv","bat","grid",""};
     const char* outNames[4] = {"home","chg","bat","grid"};
-    int currentX = 0;
     for (int i = 0; i < segmentCount; i++) {
         if (!segments[i]) continue;
-        if (values[i] > 0) {
-            int segmentWidth = (int)((values[i] / totalPower) * barWidth);
-            if (segmentWidth < 1) segmentWidth = 1;
-            lv_obj_set_pos(segments[i], currentX, 0);
+        if (layout[i].width > 0) {
+            int segmentWidth = layout[i].width;
+            lv_obj_set_pos(segments[i], layout[i].x, 0);
             lv_obj_set_size(segments[i], segmentWidth, containerHeight);
             lv_obj_clear_flag(segments[i], LV_OBJ_FLAG_HIDDEN);
             if (labels && labels[i]) {
@@ -179,7 +183,8 @@ void updateCompositeBar(lv_obj_t* container, lv_obj_t** segments, lv_obj_t** lab
                     }
                 } else {
                     if (segmentWidth >= minWidthForValueText) {
-                        lv_label_set_text(labels[i], formatPower(values[i]).c_str());
+                        char text[FORMAT_BUF_SIZE];
+                        lv_label_set_text(labels[i], formatPower(text, sizeof(text), values[i]));
                         lv_color_t segmentColor = lv_obj_get_style_bg_color(segments[i], 0);
                         uint32_t textColor = getContrastTextColor(segmentColor);
                         lv_obj_set_style_text_color(labels[i], lv_color_hex(textColor), 0);
@@ -190,7 +195,6 @@ void updateCompositeBar(lv_obj_t* container, lv_obj_t** segments, lv_obj_t** lab
                     }
                 }
             }
-            currentX += segmentWidth;
         } else {
             lv_obj_add_flag(segments[i], LV_OBJ_FLAG_HIDDEN);
             if (labels && labels[i]) lv_obj_add_flag(labels[i], LV_OBJ_FLAG_HIDDEN);
@@ -352,4 +356,218 @@ void createCarSection(lv_obj_t* parent, const char* title, const char* car_name)
     lv_label_set_text(ui.car.ladelimit_value, "---");
     styleLabelPrimary(ui.car.ladelimit_value);
     positionAndAlign(ui.car.ladelimit_value, SCREEN_WIDTH-(4*PADDING)-16-120, 110, 120, LV_TEXT_ALIGN_RIGHT);
+    // Phase current history below the limit: palette 0 = background/no sample, 1 = phase
+    // idle, 2..15 = current relative to maxCurrent. updateUI() paints the buffer directly.
+    static uint8_t phaseChartBuf[LV_CANVAS_BUF_SIZE_INDEXED_4BIT(PHASE_CHART_WIDTH, PHASE_CHART_HEIGHT)];
+    ui.car.phase_chart = lv_canvas_create(container);
+    lv_canvas_set_buffer(ui.car.phase_chart, phaseChartBuf, PHASE_CHART_WIDTH, PHASE_CHART_HEIGHT, LV_IMG_CF_INDEXED_4BIT);
+    lv_canvas_set_palette(ui.car.phase_chart, 0, lv_color_hex(COLOR_PANEL_BG));
+    lv_canvas_set_palette(ui.car.phase_chart, 1, lv_color_hex(0xE0E0E0));
+    for (int i = 2; i < 16; i++) {
+        lv_opa_t mix = (lv_opa_t)((i - 2) * 255 / 13);
+        lv_canvas_set_palette(ui.car.phase_chart, i, lv_color_mix(lv_color_hex(COLOR_BAR_GENERATION), lv_color_hex(0xC5E1A5), mix));
+    }
+    lv_obj_set_pos(ui.car.phase_chart, SCREEN_WIDTH-(4*PADDING)-16-PHASE_CHART_WIDTH, 132);
+    lv_obj_add_flag(ui.car.phase_chart, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Initialize stripe pattern style  
+void initStripeStyle() {
+    lv_style_init(&stripe_style);
+    lv_style_set_bg_img_src(&stripe_style, &img_skew_strip);
+    lv_style_set_bg_img_tiled(&stripe_style, true);
+    lv_style_set_bg_img_opa(&stripe_style, LV_OPA_30);
+    lv_style_set_bg_img_recolor_opa(&stripe_style, 0);
+}
+
+// Create UI
+void createUI() {
+    // Main screen
+    ui.screen = lv_obj_create(NULL);
+    lv_obj_set_size(ui.screen, SCREEN_WIDTH, SCREEN_HEIGHT);
+    lv_obj_set_style_bg_color(ui.screen, lv_color_hex(COLOR_GRID_BG), 0);
+    lv_obj_set_style_pad_all(ui.screen, 0, 0);
+    lv_obj_set_scrollbar_mode(ui.screen, LV_SCROLLBAR_MODE_OFF);
+    
+    // Upper container
+    ui.upper_container = lv_obj_create(ui.screen);
+    lv_obj_set_pos(ui.upper_container, 0, 0);
+    lv_obj_set_size(ui.upper_container, SCREEN_WIDTH, UPPER_SECTION_HEIGHT);
+    styleContainerWithBorder(ui.upper_container);
+    lv_obj_set_style_pad_all(ui.upper_container, PADDING, 0);
+    
+    // Create columns (IN with header, OUT without - we'll add OUT label separately)
+    lv_obj_t* in_column = createColumn(ui.upper_container, "In", PADDING, true);
+    lv_obj_t* out_column = createColumn(ui.upper_container, "Out", COLUMN_WIDTH + (2 * PADDING), false);
+    
+    // Calculate bar dimensions - center bars horizontally
+    // Total usable width minus padding on both sides
+    int totalUsableWidth = SCREEN_WIDTH - (4 * PADDING);
+    int barWidth = 360; // Fixed width for centered bars
+    int barStartX = (SCREEN_WIDTH - barWidth) / 2; // Center horizontally
+    
+    // OUT label position (right side, aligned with value columns)
+    int outLabelX = SCREEN_WIDTH - (3 * PADDING) - 60; // Right-aligned
+    
+    // Create IN bar centered at top
+    ui.in_bar.container = createCompositeBar(ui.upper_container, barStartX, 2, barWidth, 20);
+    ui.in_bar.generation_segment = createBarSegment(ui.in_bar.container, lv_color_hex(COLOR_BAR_GENERATION), &ui.in_bar.generation_label);
+    ui.in_bar.battery_out_segment = createBarSegment(ui.in_bar.container, lv_color_hex(COLOR_BAR_BATTERY_OUT), &ui.in_bar.battery_out_label);
+    ui.in_bar.grid_in_segment = createBarSegment(ui.in_bar.container, lv_color_hex(COLOR_BAR_GRID_IN), &ui.in_bar.grid_in_label);
+    // Remove background for IN bar container
+    lv_obj_set_style_bg_opa(ui.in_bar.container, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_bg_color(ui.in_bar.container, lv_color_hex(0x000000), 0); // color irrelevant when transparent
+    
+    // Create OUT bar below IN bar (offset by bar height + gap)
+    int outBarY = 2 + 20 + 4; // IN bar Y + height + gap
+    ui.out_bar.container = createCompositeBar(ui.upper_container, barStartX, outBarY, barWidth, 20);
+    ui.out_bar.consumption_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_CONSUMPTION), &ui.out_bar.consumption_label);
+    ui.out_bar.loadpoint_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_LOADPOINT), &ui.out_bar.loadpoint_label);
+    ui.out_bar.battery_in_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_BATTERY_IN), &ui.out_bar.battery_in_label);
+    ui.out_bar.grid_out_segment = createBarSegment(ui.out_bar.container, lv_color_hex(COLOR_BAR_GRID_OUT), &ui.out_bar.grid_out_label);
+    // Remove background for OUT bar container
+    lv_obj_set_style_bg_opa(ui.out_bar.container, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_bg_color(ui.out_bar.container, lv_color_hex(0x000000), 0);
+    
+    // Create OUT label right-aligned, vertically aligned with OUT bar
+    lv_obj_t* out_header = lv_label_create(ui.upper_container);
+    lv_label_set_text(out_header, "Out");
+    styleLabelHeader(out_header);
+    positionAndAlign(out_header, outLabelX, outBarY, 60, LV_TEXT_ALIGN_RIGHT);
+
+    // Restyle IN and OUT segments to transparent frames with border
+    auto styleFrameSegment = [](lv_obj_t* seg, lv_obj_t* label){
+        if(!seg) return;
+        lv_obj_set_style_bg_opa(seg, LV_OPA_TRANSP, 0);
+        lv_obj_set_style_border_width(seg, 1, 0);
+        lv_obj_set_style_border_color(seg, lv_color_hex(BS_GRAY_MEDIUM), 0);
+        lv_obj_set_style_pad_all(seg, 0, 0);
+        lv_obj_set_style_radius(seg, 8, 0); // rounded edges
+        if(label){
+            // Override any previous contrast color to static dark text
+            lv_obj_set_style_text_color(label, lv_color_hex(BS_GRAY_DARK), 0);
+        }
+    };
+    styleFrameSegment(ui.in_bar.generation_segment, ui.in_bar.generation_label);
+    styleFrameSegment(ui.in_bar.battery_out_segment, ui.in_bar.battery_out_label);
+    styleFrameSegment(ui.in_bar.grid_in_segment, ui.in_bar.grid_in_label);
+    styleFrameSegment(ui.out_bar.consumption_segment, ui.out_bar.consumption_label);
+    styleFrameSegment(ui.out_bar.loadpoint_segment, ui.out_bar.loadpoint_label);
+    styleFrameSegment(ui.out_bar.battery_in_segment, ui.out_bar.battery_in_label);
+    styleFrameSegment(ui.out_bar.grid_out_segment, ui.out_bar.grid_out_label);
+
+    // ---------------------------------------------------------------------
+    // Overlay bar (aggregated self consumption / import / export flows)
+    // Positioned vertically centered across the space spanned by IN and OUT bars
+    // IN bar: y=2 height=20, gap=4, OUT bar: y=26 height=20
+    // Total span = 44px from y=2 to y=46. Choose overlay height 16px.
+    // Center Y = 2 + 44/2 = 24 -> top = 24 - 8 = 16
+    const int overlayHeight = 16;
+    int overlayY = 16; // computed as above
+    ui.overlay_bar.container = createCompositeBar(ui.upper_container, barStartX, overlayY, barWidth, overlayHeight);
+    if (ui.overlay_bar.container) {
+        // Bring to foreground so it visually overlaps both bars
+        lv_obj_move_foreground(ui.overlay_bar.container);
+        // Slight transparency so underlying bars can still be perceived
+        lv_obj_set_style_bg_opa(ui.overlay_bar.container, LV_OPA_TRANSP, 0);
+        // Create four segments using existing semantic colors
+        ui.overlay_bar.selfpv_segment       = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_GENERATION), &ui.overlay_bar.selfpv_label);
+        ui.overlay_bar.selfbattery_segment  = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_BATTERY_OUT), &ui.overlay_bar.selfbattery_label);
+        ui.overlay_bar.grid_import_segment  = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_GRID_IN), &ui.overlay_bar.grid_import_label);
+        ui.overlay_bar.pv_export_segment    = createBarSegment(ui.overlay_bar.container, lv_color_hex(COLOR_BAR_GRID_OUT), &ui.overlay_bar.pv_export_label);
+    }
+    
+    // Create energy rows (moved down by 30px: from 30/52/74/96 to 60/82/104/126)
+    createEnergyRow(in_column, "Erzeugung", "", "0W", 60, 
+                    &ui.generation.desc, &ui.generation.value1, &ui.generation.value2);
+    createEnergyRow(in_column, "Batterie entladen", "", "0W", 82, 
+                    &ui.battery_discharge.desc, &ui.battery_discharge.value1, &ui.battery_discharge.value2);
+    createEnergyRow(in_column, "Netzbezug", "", "0W", 104, 
+                    &ui.grid_feed.desc, &ui.grid_feed.value1, &ui.grid_feed.value2);
+
+    // Price forecast in the In column's free fourth row: palette 0 = background, 1 = price bar,
+    // 2 = cheapest window, 3 = current slot
+    static uint8_t tariffChartBuf[LV_CANVAS_BUF_SIZE_INDEXED_4BIT(TARIFF_CHART_WIDTH, TARIFF_CHART_HEIGHT)];
+    ui.tariff.desc = lv_label_create(in_column);
+    lv_label_set_text(ui.tariff.desc, "Preis");
+    styleLabelPrimary(ui.tariff.desc);
+    lv_obj_set_pos(ui.tariff.desc, 0, 126);
+    ui.tariff.chart = lv_canvas_create(in_column);
+    lv_canvas_set_buffer(ui.tariff.chart, tariffChartBuf, TARIFF_CHART_WIDTH, TARIFF_CHART_HEIGHT, LV_IMG_CF_INDEXED_4BIT);
+    lv_canvas_set_palette(ui.tariff.chart, 0, lv_color_hex(COLOR_PANEL_BG));
+    lv_canvas_set_palette(ui.tariff.chart, 1, lv_color_hex(COLOR_TEXT_SECONDARY));
+    lv_canvas_set_palette(ui.tariff.chart, 2, lv_color_hex(COLOR_BAR_GENERATION));
+    lv_canvas_set_palette(ui.tariff.chart, 3, lv_color_hex(COLOR_TEXT_PRIMARY));
+    lv_obj_set_pos(ui.tariff.chart, 50, 128);
+    ui.tariff.value = lv_label_create(in_column);
+    lv_label_set_text(ui.tariff.value, "");
+    styleLabelValue(ui.tariff.value);
+    positionAndAlign(ui.tariff.value, 175, 126, 46, LV_TEXT_ALIGN_RIGHT);
+    lv_obj_add_flag(ui.tariff.desc, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(ui.tariff.chart, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(ui.tariff.value, LV_OBJ_FLAG_HIDDEN);
+
+    createEnergyRow(out_column, "Verbrauch", "", "0W", 60, 
+                    &ui.consumption.desc, &ui.consumption.value1, &ui.consumption.value2);
+    createEnergyRow(out_column, "Ladepunkt", "", "0W", 82, 
+                    &ui.loadpoint.desc, &ui.loadpoint.value1, &ui.loadpoint.value2);
+    createEnergyRow(out_column, "Batterie laden", "", "0W", 104, 
+                    &ui.battery_charge.desc, &ui.battery_charge.value1, &ui.battery_charge.value2);
+    createEnergyRow(out_column, "Einspeisung", "", "5W", 126, 
+                    &ui.grid_feedin.desc, &ui.grid_feedin.value1, &ui.grid_feedin.value2);
+    
+    // Lower container
+    ui.lower_container = lv_obj_create(ui.screen);
+    lv_obj_set_pos(ui.lower_container, 0, UPPER_SECTION_HEIGHT);
+    lv_obj_set_size(ui.lower_container, SCREEN_WIDTH, LOWER_SECTION_HEIGHT);
+    styleContainerWithBorder(ui.lower_container);
+    lv_obj_set_style_pad_all(ui.lower_container, PADDING, 0);
+    
+    // Create car section
+    createCarSection(ui.lower_container, "Gartenhaus", "NotAModelY");
+    
+    // Load screen
+    lv_scr_load(ui.screen);
+}
+
+static lv_obj_t* bootStrip = nullptr;
+static lv_obj_t* bootStripBar = nullptr;
+static lv_obj_t* bootStripLabel = nullptr;
+
+void showBootProgress(const char* text, int percent) {
+    if (!bootStrip) {
+        bootStrip = lv_obj_create(lv_layer_top());
+        lv_obj_set_pos(bootStrip, 0, SCREEN_HEIGHT - BOOT_STRIP_HEIGHT);
+        lv_obj_set_size(bootStrip, SCREEN_WIDTH, BOOT_STRIP_HEIGHT);
+        lv_obj_set_style_bg_color(bootStrip, lv_color_hex(COLOR_TEXT_PRIMARY), 0);
+        lv_obj_set_style_bg_opa(bootStrip, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_width(bootStrip, 0, 0);
+        lv_obj_set_style_radius(bootStrip, 0, 0);
+        lv_obj_set_style_pad_all(bootStrip, 0, 0);
+        lv_obj_set_scrollbar_mode(bootStrip, LV_SCROLLBAR_MODE_OFF);
+        lv_obj_clear_flag(bootStrip, LV_OBJ_FLAG_SCROLLABLE);
+
+        // Progress: a plain rectangle along the top edge, widened per stage
+        bootStripBar = lv_obj_create(bootStrip);
+        lv_obj_set_pos(bootStripBar, 0, 0);
+        lv_obj_set_size(bootStripBar, 0, 3);
+        lv_obj_set_style_bg_color(bootStripBar, lv_color_hex(COLOR_BAR_GENERATION), 0);
+        lv_obj_set_style_bg_opa(bootStripBar, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_width(bootStripBar, 0, 0);
+        lv_obj_set_style_radius(bootStripBar, 0, 0);
+
+        bootStripLabel = lv_label_create(bootStrip);
+        styleLabel(bootStripLabel, FONT_SMALL, lv_color_hex(COLOR_PANEL_BG));
+        lv_obj_set_pos(bootStripLabel, PADDING, 5);
+    }
+    lv_label_set_text(bootStripLabel, text);
+    lv_obj_set_width(bootStripBar, SCREEN_WIDTH * percent / 100);
+}
+
+void hideBootProgress() {
+    if (!bootStrip) return;
+    lv_obj_del(bootStrip);
+    bootStrip = nullptr;
+    bootStripBar = nullptr;
+    bootStripLabel = nullptr;
 }
@@ -4,9 +4,7 @@
 #include <lvgl.h>
 #include <Arduino.h>
 #include "config.h"
-
-// Forward declaration for power formatting (implemented in main sketch)
-String formatPower(float watts);
+#include "formatters.h" // formatPower for segment labels
 
 // Forward declarations / shared UI structs
 struct UIElements {
@@ -51,6 +49,13 @@ struct UIElements {
         lv_obj_t* pv_export_label;
     } overlay_bar;
 
+    // Grid price forecast row in the In column (tariff.h), hidden until the first fetch
+    struct {
+        lv_obj_t* desc;
+        lv_obj_t* chart;   // 4-bit indexed canvas, painted by updateTariffChart()
+        lv_obj_t* value;   // current price
+    } tariff;
+
     struct {
         lv_obj_t* title_label;
         lv_obj_t* car_label;
@@ -76,6 +81,7 @@ struct UIElements {
         lv_obj_t* plan_value;
         lv_obj_t* plan_soc_value;
         lv_obj_t* ladelimit_value;
+        lv_obj_t* phase_chart;   // phase current history, 4-bit indexed canvas (display_updates.cpp)
     } car;
 };
 
@@ -108,3 +114,12 @@ lv_obj_t* createColumn(lv_obj_t* parent, const char* title, int x_pos, bool show
 
 // Car section creation (uses global ui)
 void createCarSection(lv_obj_t* parent, const char* title, const char* car_name);
+
+// Main screen (fills the global ui and loads it) and the charging stripe style it uses
+void initStripeStyle();
+void createUI();
+
+// Boot progress strip (top layer, over the dashboard) until the first live data arrives:
+// a status line and a bar filled to `percent`. Created on first use.
+void showBootProgress(const char* text, int percent);
+void hideBootProgress();
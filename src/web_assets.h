@@ -0,0 +1,242 @@
+// Generated by tools/embed_web.py from web/ - do not edit
+#pragma once
+
+#include <Arduino.h>
+
+struct WebAsset {
+    const char* path;      // URL path
+    const char* mime;
+    const uint8_t* gz;     // gzip-compressed body (flash)
+    size_t gzLen;
+    const char* etag;      // quoted content hash
+};
+
+// app.css: 382 bytes, 249 gzipped
+static const uint8_t WEB_APP_CSS_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6D, 0x8F, 0x41, 0x6A, 0xC3, 0x30,
+    0x10, 0x45, 0xF7, 0x39, 0x45, 0x20, 0x9B, 0x16, 0xEA, 0x20, 0xDB, 0x49, 0xA0, 0xD2, 0x2A, 0x14,
+    0x72, 0x8F, 0x91, 0x47, 0xB6, 0x87, 0x28, 0x1A, 0x23, 0xC9, 0xD8, 0xC6, 0xF4, 0xEE, 0x95, 0x13,
+    0x87, 0x16, 0x52, 0x06, 0x81, 0x84, 0x86, 0xFF, 0xDE, 0xD7, 0x8C, 0xD3, 0x5C, 0xB3, 0x8B, 0x59,
+    0x0D, 0x37, 0xB2, 0x93, 0x3C, 0x7B, 0x02, 0xAB, 0x6E, 0xE0, 0x1B, 0x72, 0xB2, 0x10, 0xDD, 0xA8,
+    0x34, 0x54, 0xD7, 0xC6, 0x73, 0xEF, 0x50, 0xEE, 0x6A, 0xB1, 0x8C, 0xFA, 0xDE, 0xB4, 0xF9, 0x5C,
+    0xB1, 0x65, 0x2F, 0x77, 0x65, 0x59, 0xA6, 0xF7, 0xBE, 0x02, 0x8F, 0xF3, 0x9F, 0xD5, 0xA1, 0xA5,
+    0x68, 0x54, 0x07, 0x88, 0xE4, 0x1A, 0x99, 0x1F, 0x53, 0xD0, 0x1A, 0x9A, 0xA7, 0xD0, 0xAD, 0x50,
+    0x9A, 0x3D, 0x1A, 0x9F, 0x79, 0x40, 0xEA, 0x83, 0x5C, 0xFE, 0x35, 0x8F, 0x59, 0x68, 0x01, 0x79,
+    0x90, 0x62, 0x5B, 0xA4, 0xA5, 0x43, 0x3A, 0xBE, 0xD1, 0xF0, 0x26, 0x3E, 0xEE, 0xB3, 0xCF, 0xDF,
+    0x13, 0x0A, 0x9E, 0xE4, 0x22, 0xFF, 0x3C, 0x5D, 0x4A, 0x15, 0xCD, 0x18, 0x33, 0x34, 0x15, 0x7B,
+    0x88, 0xC4, 0x4E, 0x3A, 0x76, 0x46, 0xDD, 0x2B, 0x0D, 0x86, 0x9A, 0x36, 0x4A, 0xCD, 0x16, 0x17,
+    0x45, 0x1D, 0xDD, 0x8C, 0x14, 0x3A, 0x0B, 0x93, 0x24, 0x67, 0xC9, 0x99, 0x4C, 0x5B, 0xAE, 0xAE,
+    0xBF, 0x96, 0x8B, 0xD9, 0x4B, 0xE7, 0x15, 0xF3, 0x80, 0x3E, 0x6A, 0xBD, 0xBA, 0xAF, 0xDD, 0x96,
+    0x6B, 0x22, 0x85, 0x08, 0xB1, 0x0F, 0x4F, 0xCF, 0xC3, 0xD7, 0xF9, 0x72, 0x14, 0xFF, 0x29, 0xFD,
+    0x00, 0xCB, 0x9E, 0xFB, 0x4A, 0x7E, 0x01, 0x00, 0x00,
+};
+
+// app.js: 2069 bytes, 969 gzipped
+static const uint8_t WEB_APP_JS_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7D, 0x55, 0x4D, 0x73, 0xDB, 0x36,
+    0x10, 0xBD, 0xFB, 0x57, 0xEC, 0x4C, 0x27, 0x21, 0x59, 0x2B, 0x94, 0xDC, 0xE9, 0xC9, 0x9A, 0x4E,
+    0x47, 0xAA, 0xED, 0x49, 0x1A, 0x3B, 0xF6, 0x54, 0xBE, 0x79, 0x7C, 0x00, 0xC9, 0x25, 0x89, 0x08,
+    0x04, 0x58, 0x7C, 0xD0, 0x51, 0x3B, 0xFE, 0xEF, 0x59, 0x80, 0x14, 0x45, 0x29, 0x1F, 0x07, 0x9B,
+    0xC2, 0xEE, 0xDB, 0xC5, 0xC3, 0xDB, 0x05, 0x76, 0x3E, 0x87, 0x8D, 0x65, 0xD6, 0x19, 0x68, 0x59,
+    0x85, 0x97, 0x60, 0x68, 0xC1, 0x73, 0x30, 0x35, 0x0A, 0x31, 0x03, 0xC1, 0x3B, 0x84, 0x8E, 0x09,
+    0x87, 0x06, 0x4A, 0xAD, 0x1A, 0x98, 0x9B, 0x00, 0x3E, 0x8B, 0x4B, 0x27, 0x73, 0xCB, 0x95, 0x84,
+    0x38, 0x81, 0xFF, 0xCF, 0x00, 0xC6, 0xB5, 0x92, 0xF7, 0x65, 0x19, 0x77, 0x64, 0x05, 0x8D, 0xD6,
+    0x69, 0x09, 0x1D, 0xFC, 0x09, 0xD1, 0xFD, 0xA7, 0x08, 0x2E, 0xE9, 0x73, 0x73, 0x13, 0x2D, 0xE1,
+    0x75, 0x1A, 0x60, 0xD0, 0xC6, 0xBC, 0x98, 0x41, 0x08, 0x29, 0x54, 0xEE, 0x1A, 0x94, 0x36, 0xAD,
+    0xD0, 0x5E, 0x0B, 0xF4, 0x3F, 0xD7, 0xBB, 0x0F, 0x05, 0x01, 0x92, 0xD4, 0xE2, 0x17, 0xFB, 0x97,
+    0x92, 0x96, 0x6C, 0xF0, 0x07, 0x74, 0x3E, 0xCD, 0x34, 0x8F, 0xC6, 0x52, 0xA3, 0xA9, 0x07, 0x3E,
+    0xE4, 0x40, 0x9B, 0xD7, 0x71, 0x34, 0x30, 0x8E, 0x28, 0xBE, 0x46, 0x39, 0xE1, 0xAD, 0x27, 0x14,
+    0x75, 0xFA, 0xD9, 0x28, 0x19, 0x27, 0x94, 0xF3, 0x1B, 0x9C, 0xD9, 0x27, 0x84, 0x40, 0x35, 0xE2,
+    0x6D, 0x34, 0x03, 0x93, 0xF2, 0x76, 0x55, 0x14, 0xB4, 0xA1, 0x49, 0x96, 0x53, 0x6F, 0x8D, 0xAC,
+    0xF7, 0x13, 0x19, 0x7C, 0x4F, 0x8B, 0xD1, 0xDD, 0x31, 0x0D, 0x0D, 0x11, 0x37, 0xA9, 0xE8, 0x2A,
+    0x71, 0x87, 0xCD, 0xDE, 0xC1, 0x4B, 0x88, 0x9B, 0xA4, 0x0F, 0x17, 0x5D, 0x83, 0x0D, 0xC5, 0x37,
+    0xA9, 0x33, 0x58, 0xC0, 0x39, 0x44, 0x30, 0xA7, 0xBF, 0x73, 0x32, 0x18, 0xFE, 0x1F, 0x06, 0x43,
+    0xB6, 0xB3, 0x68, 0x66, 0x83, 0xB5, 0xD4, 0xAC, 0x7A, 0xC8, 0xAD, 0x77, 0xBC, 0x01, 0xBF, 0xF0,
+    0x92, 0x21, 0xC9, 0x29, 0x98, 0xAE, 0xD0, 0x58, 0xF0, 0x3C, 0x06, 0x6C, 0xC6, 0x2B, 0x6F, 0xBA,
+    0x21, 0xCB, 0x11, 0xAB, 0x3A, 0xB0, 0xF2, 0xCC, 0x89, 0xB0, 0xB0, 0xF5, 0x94, 0x58, 0x7D, 0x38,
+    0x7D, 0x0F, 0xB6, 0x1A, 0x65, 0x41, 0x01, 0xD1, 0x7E, 0x83, 0x4C, 0xA8, 0x7C, 0x1B, 0x76, 0xA8,
+    0xD3, 0xC1, 0xB6, 0x0E, 0xA6, 0x13, 0xAE, 0xA3, 0xF7, 0x31, 0x64, 0x18, 0xBD, 0xF3, 0x1A, 0x54,
+    0x87, 0xFA, 0x18, 0xF3, 0x5E, 0x39, 0x2D, 0x76, 0xA9, 0x40, 0x59, 0xD9, 0x3A, 0x60, 0xEB, 0x68,
+    0x39, 0xF2, 0x08, 0xC4, 0x52, 0x12, 0xDF, 0x32, 0x6D, 0x57, 0x36, 0x19, 0x48, 0x9D, 0x13, 0xAB,
+    0x19, 0x0C, 0x66, 0x68, 0x05, 0x93, 0x92, 0x34, 0xF4, 0x79, 0x25, 0xBE, 0xC0, 0x15, 0xB3, 0x38,
+    0x8D, 0x82, 0x5F, 0xE1, 0x62, 0xB1, 0x58, 0x50, 0xBD, 0xD5, 0xAD, 0xCA, 0x99, 0xC0, 0x8D, 0xD5,
+    0x5C, 0x56, 0x71, 0x72, 0xD8, 0x67, 0xAC, 0x68, 0xC8, 0x4F, 0xB9, 0xC3, 0x77, 0x04, 0xBC, 0x4E,
+    0x2B, 0x8B, 0x7D, 0x6D, 0xE9, 0xAB, 0xF4, 0xEE, 0xA8, 0xB4, 0xD8, 0x4C, 0x35, 0x0C, 0x39, 0x89,
+    0x5B, 0x1E, 0x9A, 0x9B, 0x72, 0x7A, 0x40, 0xDA, 0x1A, 0xCD, 0x1A, 0x7F, 0x4F, 0x1E, 0x36, 0xFF,
+    0xAC, 0xEE, 0x02, 0xE7, 0x3B, 0x66, 0x89, 0xAD, 0x72, 0xB2, 0x38, 0x20, 0x7C, 0xE9, 0xA8, 0x21,
+    0x2E, 0x16, 0xBF, 0xFD, 0x9E, 0x04, 0x55, 0x54, 0xF9, 0x43, 0xEC, 0xC6, 0xF7, 0xCB, 0x14, 0xFB,
+    0x71, 0x1D, 0x9A, 0x61, 0x09, 0xE1, 0x26, 0x4A, 0x05, 0x61, 0x2F, 0x5A, 0x92, 0x7B, 0xA4, 0x07,
+    0xFE, 0x24, 0x69, 0xE6, 0xCA, 0x12, 0x35, 0x9D, 0x86, 0xB5, 0x93, 0x9B, 0x90, 0x4D, 0x6E, 0x4C,
+    0x96, 0x4A, 0xD6, 0xF4, 0xFD, 0xE8, 0x09, 0xC4, 0x59, 0xDF, 0x9F, 0xC3, 0x7E, 0xA4, 0xE9, 0x0D,
+    0xFF, 0x82, 0x45, 0x7C, 0x31, 0x6E, 0x1D, 0x7B, 0x58, 0x46, 0xF2, 0x57, 0x3E, 0x17, 0x19, 0x93,
+    0x28, 0xDC, 0xB6, 0xCF, 0x8A, 0xCB, 0x98, 0x64, 0x88, 0x92, 0xEF, 0xEA, 0x9A, 0xB5, 0x41, 0xD6,
+    0x4C, 0x29, 0xFB, 0xA0, 0x55, 0xC9, 0x05, 0x9A, 0xA9, 0xB8, 0xE4, 0x7E, 0xFB, 0x96, 0x40, 0x01,
+    0x60, 0x86, 0x7E, 0x39, 0x6D, 0xD9, 0xDC, 0x69, 0x4A, 0xB2, 0x07, 0x3D, 0x9D, 0xA0, 0xE1, 0x1D,
+    0x5C, 0x3C, 0x9F, 0xD4, 0xDC, 0xFB, 0x3D, 0xA7, 0x5F, 0x3C, 0x69, 0x0A, 0x0F, 0x01, 0x9E, 0xF4,
+    0x65, 0x38, 0x2D, 0x65, 0x68, 0x6B, 0x66, 0xF0, 0x54, 0x20, 0x2F, 0xC9, 0x0C, 0xF8, 0x74, 0x7F,
+    0xD8, 0x0B, 0xE6, 0xB3, 0x38, 0xF3, 0xC4, 0x9F, 0xA9, 0xCA, 0xC7, 0xD2, 0x1D, 0x3C, 0xF3, 0xB1,
+    0x23, 0x7B, 0xF5, 0x16, 0xBD, 0x7A, 0x8D, 0xF1, 0x15, 0x93, 0x4E, 0x88, 0x03, 0x4D, 0x52, 0x8E,
+    0xC4, 0xB0, 0xA8, 0xE3, 0xB5, 0x52, 0x02, 0x99, 0xFC, 0xA9, 0x92, 0xE1, 0x50, 0xAE, 0xB5, 0xBC,
+    0xC1, 0xF0, 0x38, 0xF5, 0x3F, 0x8F, 0x5F, 0xAE, 0x02, 0x33, 0x57, 0x91, 0xB7, 0x7F, 0xC0, 0x4D,
+    0x1A, 0xD6, 0xD7, 0x92, 0x65, 0x02, 0x8B, 0xE4, 0x14, 0xDA, 0xA8, 0x23, 0x64, 0xA3, 0xEE, 0x54,
+    0x81, 0xDF, 0x41, 0xAD, 0xAD, 0x0C, 0x1B, 0xEE, 0x21, 0xBE, 0xC5, 0x6F, 0xFD, 0x50, 0xF1, 0x8B,
+    0xD0, 0x87, 0x57, 0xE4, 0xE9, 0x57, 0x43, 0x34, 0x9D, 0x2C, 0x67, 0xFE, 0xE9, 0x3E, 0x1A, 0x31,
+    0xAF, 0xC1, 0x1B, 0x5E, 0xFC, 0xF9, 0x1C, 0x1E, 0x55, 0x55, 0x51, 0x27, 0x00, 0xD3, 0x08, 0x0F,
+    0xF7, 0x9B, 0x47, 0xBA, 0xE6, 0x5C, 0x02, 0x3D, 0xDC, 0x90, 0xB1, 0x7C, 0x5B, 0x85, 0x9B, 0xB0,
+    0xF4, 0x2F, 0x00, 0x59, 0x05, 0x97, 0x5B, 0x43, 0x73, 0x8D, 0x0B, 0x01, 0x2F, 0x4A, 0x6F, 0xE1,
+    0x85, 0xDB, 0x5A, 0x39, 0x0B, 0x7F, 0x6F, 0x28, 0xD9, 0x38, 0x70, 0xFE, 0x75, 0xA8, 0x77, 0x1B,
+    0x14, 0x98, 0x5B, 0xA5, 0x57, 0x42, 0xC4, 0xD1, 0x53, 0xC1, 0x2C, 0x7B, 0x67, 0xC3, 0x56, 0xCF,
+    0x34, 0x3F, 0x4A, 0xA5, 0xAF, 0xD9, 0x11, 0x2F, 0xB6, 0xAF, 0x34, 0x4B, 0x59, 0x51, 0x5C, 0x77,
+    0x94, 0xE7, 0x96, 0x1B, 0x1A, 0x50, 0x54, 0x96, 0x28, 0x17, 0x3C, 0xDF, 0xD2, 0xE1, 0x0F, 0x70,
+    0xEC, 0x0E, 0x9D, 0x81, 0x5D, 0xDA, 0x6A, 0xF4, 0x11, 0x57, 0x58, 0x32, 0x27, 0xEC, 0xE1, 0xDD,
+    0xE9, 0x07, 0x17, 0xF3, 0x23, 0x70, 0x65, 0xE9, 0x4D, 0xCA, 0x1C, 0x3D, 0x5C, 0x51, 0x4D, 0xF3,
+    0x2D, 0x4A, 0x66, 0x74, 0x03, 0x1B, 0x24, 0xFE, 0x05, 0x49, 0xE7, 0x4F, 0x1E, 0x8D, 0x13, 0x6B,
+    0x98, 0x7F, 0xA3, 0x8A, 0x41, 0x2F, 0xFA, 0x7F, 0x06, 0x87, 0xD1, 0xE8, 0x6D, 0x54, 0x9B, 0x0F,
+    0x34, 0x22, 0x34, 0x8D, 0xF5, 0x7D, 0xCC, 0x2C, 0xF4, 0xDD, 0x82, 0xDC, 0xAF, 0x89, 0x07, 0x7D,
+    0x05, 0x30, 0x62, 0x1D, 0x2B, 0x15, 0x08, 0x00, 0x00,
+};
+
+// index.html: 1204 bytes, 504 gzipped
+static const uint8_t WEB_INDEX_HTML_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0x4D, 0x6F, 0x1A, 0x31,
+    0x10, 0xBD, 0xE7, 0x57, 0x4C, 0x4F, 0xBE, 0x94, 0xAE, 0x48, 0x84, 0xFA, 0xA1, 0xDD, 0xAD, 0x1A,
+    0x48, 0xDB, 0x54, 0xB4, 0xA1, 0x82, 0x22, 0xF5, 0x68, 0xEC, 0x01, 0xDC, 0x78, 0xD7, 0x96, 0x3D,
+    0x10, 0xF1, 0xEF, 0x33, 0xFB, 0x01, 0x82, 0xC0, 0x56, 0xED, 0x69, 0x65, 0xCF, 0x7B, 0xCF, 0xE3,
+    0xE7, 0x37, 0x9B, 0xBE, 0x1A, 0x3D, 0x0C, 0x67, 0xBF, 0x27, 0x77, 0xB0, 0xA6, 0xC2, 0xE6, 0x57,
+    0xE9, 0xFE, 0x83, 0x52, 0xF3, 0x87, 0x0C, 0x59, 0xCC, 0xEF, 0xE6, 0xC3, 0x21, 0x8C, 0x4C, 0xF4,
+    0x56, 0xEE, 0xD2, 0xA4, 0xD9, 0xBB, 0x4A, 0x0B, 0x24, 0x09, 0xA5, 0x2C, 0x30, 0x13, 0x5B, 0x83,
+    0x4F, 0xDE, 0x05, 0x12, 0xA0, 0x5C, 0x49, 0x58, 0x52, 0x26, 0x9E, 0x8C, 0xA6, 0x75, 0xA6, 0x71,
+    0x6B, 0x14, 0xF6, 0xEA, 0xC5, 0x6B, 0x30, 0xA5, 0x21, 0x23, 0x6D, 0x2F, 0x2A, 0x69, 0x31, 0xEB,
+    0x0B, 0x16, 0xB1, 0xA6, 0x7C, 0x84, 0x80, 0x36, 0x13, 0x91, 0x76, 0x16, 0xE3, 0x1A, 0x91, 0x55,
+    0xD6, 0x01, 0x97, 0x99, 0x48, 0xA4, 0xF7, 0x6F, 0x54, 0x8C, 0x1F, 0xB7, 0x99, 0x1A, 0x2C, 0xFB,
+    0xEF, 0xFB, 0x03, 0x5D, 0x51, 0x92, 0xB6, 0xB7, 0x85, 0xD3, 0xBB, 0xAA, 0xD3, 0xFE, 0x49, 0x7F,
+    0x30, 0x25, 0x49, 0x9B, 0xC8, 0xA8, 0x3E, 0x17, 0xB5, 0xD9, 0x82, 0xB2, 0x32, 0xC6, 0x4C, 0x28,
+    0x19, 0x98, 0x9E, 0xAE, 0xAF, 0xF3, 0xE9, 0x2E, 0x12, 0x16, 0x70, 0x5F, 0x2E, 0x1D, 0xC3, 0xAE,
+    0x19, 0xE6, 0xF3, 0x34, 0x52, 0x70, 0xE5, 0x2A, 0xBF, 0x9F, 0xC0, 0x27, 0xAD, 0x03, 0xC6, 0xF8,
+    0x21, 0x4D, 0xDA, 0x3D, 0x48, 0xA3, 0x97, 0x25, 0x18, 0x9D, 0x09, 0xE3, 0x45, 0xDE, 0xE3, 0x02,
+    0xAF, 0xF3, 0x34, 0xF1, 0x27, 0xD4, 0xCF, 0x01, 0x11, 0xBE, 0xA2, 0xF4, 0x17, 0x99, 0xDC, 0xF4,
+    0x11, 0x17, 0x16, 0x3B, 0xC2, 0xF8, 0x52, 0x61, 0x3C, 0xFF, 0x32, 0x86, 0x89, 0x73, 0xF6, 0xA2,
+    0x82, 0xDD, 0x16, 0x58, 0x74, 0x1F, 0x5F, 0x9D, 0x0C, 0xB3, 0x80, 0xA5, 0xEE, 0x3C, 0x9F, 0xAA,
+    0x6A, 0xB7, 0xC2, 0xED, 0x66, 0xB9, 0xC4, 0x70, 0xF9, 0xE2, 0x6C, 0xAD, 0xC2, 0x82, 0x5F, 0xF6,
+    0x2F, 0x74, 0xE7, 0xE8, 0x22, 0x77, 0xC1, 0x85, 0x6E, 0xDA, 0x2F, 0x4F, 0xA6, 0xC0, 0x8B, 0xC4,
+    0x4D, 0x5D, 0x3A, 0x72, 0x2D, 0x22, 0xE7, 0x4B, 0x9F, 0xF9, 0x36, 0xC2, 0xC5, 0x66, 0x05, 0xDF,
+    0x9D, 0x3E, 0x97, 0x69, 0x1F, 0x3F, 0xD6, 0xA1, 0x10, 0xB5, 0xAA, 0xAE, 0xD0, 0xDD, 0xFD, 0x8C,
+    0xB0, 0x70, 0xFF, 0xA1, 0x55, 0xB8, 0x97, 0x52, 0x09, 0x87, 0xAE, 0x2B, 0x7A, 0x3F, 0x37, 0x46,
+    0x3D, 0xC2, 0x98, 0x43, 0x1F, 0xDB, 0xE8, 0xC9, 0x7D, 0xD8, 0xAD, 0x5B, 0xB1, 0x68, 0xCB, 0x58,
+    0x50, 0x29, 0xF2, 0x39, 0x4F, 0x15, 0x8C, 0x79, 0x3B, 0x4D, 0xE4, 0x31, 0x72, 0xDF, 0xC0, 0x31,
+    0xF6, 0xDB, 0xF4, 0xE1, 0xC7, 0x21, 0xFA, 0x27, 0xE8, 0xFA, 0xBA, 0x09, 0xB9, 0xD5, 0xCA, 0xE2,
+    0x09, 0x07, 0xB4, 0x24, 0xD9, 0x6B, 0x0A, 0x07, 0x57, 0x66, 0xF5, 0x12, 0x6A, 0x47, 0xCF, 0x84,
+    0x0A, 0xF7, 0x2F, 0x3A, 0xEC, 0xC8, 0xC1, 0x9B, 0xDB, 0xAA, 0xB7, 0x83, 0xA3, 0x8D, 0x60, 0xEB,
+    0x4F, 0x54, 0xC1, 0x78, 0x82, 0x18, 0x54, 0x3B, 0xE9, 0x7F, 0xAA, 0x41, 0x47, 0xF9, 0xF6, 0xE6,
+    0x46, 0x0E, 0xDE, 0xB1, 0x5D, 0x49, 0x83, 0xA8, 0x18, 0xED, 0xA8, 0x27, 0xCD, 0xCF, 0xE9, 0x19,
+    0x38, 0x5F, 0xC6, 0xE5, 0xB4, 0x04, 0x00, 0x00,
+};
+
+// logs.css: 879 bytes, 446 gzipped
+static const uint8_t WEB_LOGS_CSS_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6D, 0x92, 0x41, 0x6F, 0xE3, 0x20,
+    0x10, 0x85, 0xEF, 0xFD, 0x15, 0x91, 0x7A, 0x5D, 0x2C, 0x48, 0x1C, 0xD7, 0xC5, 0xA7, 0x76, 0xDB,
+    0xAE, 0xF6, 0xD2, 0x43, 0x0E, 0xBB, 0x67, 0x30, 0xE0, 0xA0, 0x60, 0xC6, 0xC2, 0xB4, 0x49, 0xD6,
+    0xEA, 0x7F, 0x5F, 0xB0, 0x8D, 0x36, 0xCE, 0x46, 0x48, 0x96, 0x3C, 0x7E, 0xCC, 0x7C, 0x7E, 0x6F,
+    0x38, 0x88, 0xF3, 0xA0, 0xC0, 0x7A, 0xA4, 0x58, 0xAB, 0xCD, 0x99, 0x3E, 0x39, 0xCD, 0xCC, 0xB7,
+    0x16, 0x2C, 0xF4, 0x1D, 0xAB, 0x65, 0xD5, 0x32, 0xD7, 0x68, 0x4B, 0xD7, 0xB8, 0x3B, 0x55, 0x9C,
+    0xD5, 0x87, 0xC6, 0xC1, 0x87, 0x15, 0xF4, 0x9E, 0xC8, 0x78, 0xAA, 0x1A, 0x0C, 0x38, 0x7A, 0x2F,
+    0xF2, 0x78, 0xAA, 0xAF, 0xBB, 0x3D, 0x19, 0xE6, 0x52, 0xFE, 0xFD, 0xE9, 0x6D, 0x8B, 0xE7, 0xFB,
+    0xC8, 0x43, 0x47, 0x71, 0xF8, 0x9E, 0x19, 0x68, 0x86, 0xCB, 0x3E, 0x6B, 0xB1, 0x16, 0x1B, 0x5C,
+    0x75, 0x4C, 0x08, 0x6D, 0x1B, 0x5A, 0x74, 0xA7, 0x15, 0x89, 0xB3, 0xE6, 0xB9, 0x79, 0x78, 0xC7,
+    0x15, 0x07, 0x27, 0xA4, 0x43, 0x46, 0x2A, 0x4F, 0x37, 0xA1, 0xD2, 0x83, 0xD1, 0x62, 0x95, 0x46,
+    0x8C, 0xF8, 0xBD, 0xFE, 0x23, 0x29, 0x59, 0x87, 0x9B, 0x46, 0x5B, 0x89, 0xF6, 0x52, 0x37, 0x7B,
+    0x4F, 0x49, 0x16, 0xA1, 0x32, 0xAF, 0x5B, 0xD9, 0x7B, 0xD6, 0x76, 0x09, 0xAE, 0x64, 0x3C, 0x57,
+    0xE5, 0x74, 0xF3, 0x38, 0x49, 0x39, 0x18, 0x91, 0x68, 0xDD, 0x58, 0x09, 0x2C, 0x23, 0xF1, 0xA7,
+    0x19, 0x84, 0xEE, 0x3B, 0xC3, 0xCE, 0x54, 0xDB, 0xB1, 0x3B, 0x37, 0x50, 0x1F, 0x2E, 0xE7, 0x46,
+    0xE2, 0xF4, 0x0B, 0x81, 0x61, 0x95, 0x47, 0xB7, 0x26, 0x68, 0xC7, 0x84, 0xFE, 0xE8, 0x23, 0xF6,
+    0xB2, 0x7B, 0x3E, 0x77, 0x87, 0x26, 0xEB, 0x9C, 0xFC, 0x1C, 0x20, 0xD8, 0xAD, 0xFD, 0x99, 0x66,
+    0xC5, 0xE5, 0xEF, 0xA2, 0x04, 0x5C, 0x96, 0x33, 0x4B, 0xF6, 0xBA, 0xDB, 0x2D, 0x1C, 0xE4, 0x0F,
+    0xA4, 0x26, 0x75, 0x4A, 0x42, 0x29, 0x95, 0x84, 0xBF, 0x77, 0xEF, 0x0B, 0xA1, 0x52, 0x8F, 0x25,
+    0xC6, 0x49, 0x88, 0x31, 0x4E, 0xC2, 0x9F, 0xEF, 0x6F, 0xCB, 0x4C, 0xC8, 0x63, 0xA1, 0x36, 0x37,
+    0x3A, 0xBE, 0x3C, 0xFF, 0x58, 0x08, 0xF3, 0xED, 0x96, 0x15, 0xF9, 0x0D, 0xE1, 0xAF, 0xDD, 0xF3,
+    0x42, 0x58, 0xE0, 0x07, 0x51, 0xF2, 0x2B, 0x61, 0xC8, 0xA4, 0x67, 0x8D, 0x4C, 0x99, 0x48, 0x1C,
+    0x4F, 0x75, 0xDC, 0x6B, 0x2F, 0xD1, 0xB8, 0x7C, 0x34, 0x18, 0x83, 0x8E, 0x8E, 0x75, 0xD5, 0x31,
+    0x38, 0x82, 0xB8, 0x93, 0xEC, 0x40, 0xC7, 0x27, 0x8A, 0x85, 0xD8, 0xC3, 0xC9, 0x7F, 0x99, 0x06,
+    0x8B, 0x66, 0x87, 0xC7, 0x45, 0x89, 0xF1, 0x5D, 0x44, 0x44, 0x46, 0xBF, 0xD9, 0xD5, 0x7A, 0x7A,
+    0x79, 0xF2, 0x48, 0xC8, 0x1A, 0x1C, 0xF3, 0x1A, 0x2C, 0xB5, 0x60, 0x65, 0x75, 0x33, 0xED, 0x79,
+    0x21, 0x63, 0xD4, 0x2B, 0x3C, 0xE1, 0x7B, 0x36, 0x5C, 0x0D, 0xF8, 0x1F, 0x85, 0x83, 0xF7, 0xD0,
+    0x4E, 0x1B, 0xF2, 0x75, 0xF7, 0x17, 0xDC, 0x9E, 0x95, 0x23, 0x6F, 0x03, 0x00, 0x00,
+};
+
+// logs.js: 2185 bytes, 928 gzipped
+static const uint8_t WEB_LOGS_JS_GZ[] PROGMEM = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x56, 0xC1, 0x6E, 0xE3, 0x36,
+    0x10, 0xBD, 0xE7, 0x2B, 0xA6, 0x7B, 0xA8, 0xA4, 0x46, 0x2B, 0xBB, 0xBD, 0x14, 0x48, 0xEA, 0x2E,
+    0xD2, 0xD4, 0x05, 0x5A, 0x64, 0x77, 0x81, 0xFA, 0xD0, 0x02, 0x69, 0x50, 0x30, 0xE4, 0xD8, 0x26,
+    0x40, 0x93, 0x5A, 0x92, 0x92, 0x1B, 0x74, 0xF3, 0xEF, 0x9D, 0xA1, 0x2C, 0x85, 0x4E, 0xB2, 0x6E,
+    0x0E, 0x96, 0x44, 0x72, 0x38, 0x6F, 0xDE, 0xBC, 0x47, 0x66, 0x36, 0x83, 0x1B, 0xB7, 0x09, 0xD0,
+    0x8A, 0x0D, 0x5E, 0x80, 0x77, 0xFB, 0x00, 0xC2, 0x23, 0x78, 0xB4, 0x0A, 0x3D, 0x2A, 0xB8, 0x7F,
+    0x80, 0xB8, 0x45, 0x50, 0xD8, 0x6B, 0x89, 0x35, 0x58, 0xDC, 0x03, 0xDA, 0xE8, 0x35, 0xF2, 0x3A,
+    0xAF, 0x7B, 0x84, 0x5E, 0x0B, 0x98, 0x19, 0xDA, 0x63, 0x16, 0xA2, 0x47, 0xB1, 0x83, 0x72, 0xB5,
+    0x5A, 0x56, 0x67, 0xE5, 0xBA, 0xB3, 0x32, 0x6A, 0x67, 0xA1, 0xAC, 0xE0, 0xDF, 0x33, 0x80, 0x5E,
+    0x78, 0x78, 0x7F, 0xF5, 0xE7, 0xDF, 0xBF, 0x7F, 0xFC, 0x63, 0x05, 0x0B, 0xF8, 0x6E, 0x3E, 0xBF,
+    0xA4, 0xD1, 0x69, 0x55, 0x0C, 0x25, 0xB6, 0x4E, 0x6E, 0x6B, 0xD8, 0x85, 0x21, 0x00, 0x40, 0xAF,
+    0x61, 0x18, 0x84, 0x1F, 0x17, 0xF0, 0xED, 0x9C, 0xFF, 0x2A, 0x82, 0x16, 0x3B, 0x6F, 0xA1, 0xB8,
+    0x2D, 0xE0, 0x3C, 0xE1, 0xF9, 0x59, 0x44, 0x3C, 0x2C, 0xFB, 0x26, 0xAD, 0xAA, 0x9A, 0xE8, 0x6E,
+    0x9C, 0x14, 0x06, 0x57, 0x84, 0xD4, 0x6E, 0x08, 0xC0, 0x39, 0x14, 0x77, 0xC5, 0x65, 0xDA, 0xF4,
+    0x28, 0x7E, 0x17, 0x78, 0x8A, 0x1E, 0xC3, 0xEC, 0x63, 0x8E, 0x28, 0xB4, 0xC2, 0x96, 0xB2, 0x86,
+    0x38, 0xC2, 0xE1, 0x0A, 0x02, 0x41, 0x57, 0x4E, 0x76, 0x3B, 0x62, 0xA1, 0x91, 0x54, 0x6F, 0xC4,
+    0xA5, 0x41, 0xFE, 0x2A, 0x0B, 0x0E, 0x28, 0xAA, 0x21, 0x4B, 0x68, 0xA4, 0x11, 0x21, 0x7C, 0x10,
+    0x3B, 0xA4, 0x08, 0x39, 0x0E, 0x46, 0xFC, 0x27, 0x5E, 0x3B, 0x1B, 0x69, 0x3D, 0x0D, 0xC7, 0x23,
+    0x44, 0x61, 0x44, 0x30, 0x9B, 0xC1, 0xB5, 0x33, 0x46, 0xB4, 0x81, 0x1A, 0xA0, 0xBA, 0xD6, 0x68,
+    0x49, 0x69, 0xC2, 0x05, 0x48, 0xD7, 0x51, 0x9C, 0xB0, 0x0A, 0xF6, 0x5B, 0xB4, 0xA9, 0x31, 0x44,
+    0x00, 0x86, 0x08, 0xCE, 0x22, 0xEC, 0x45, 0x00, 0xEA, 0xC3, 0x06, 0x55, 0x5E, 0x85, 0xC7, 0xB6,
+    0xB4, 0x35, 0xBC, 0xE0, 0x76, 0xA4, 0x81, 0xE6, 0xB9, 0x08, 0x05, 0x89, 0x4E, 0x66, 0xE3, 0xAF,
+    0x6E, 0x3E, 0x57, 0xDF, 0xD7, 0x40, 0xF8, 0x63, 0x1A, 0x3D, 0x6A, 0xCD, 0x00, 0x92, 0x7E, 0x26,
+    0x16, 0x3E, 0x75, 0xE8, 0x1F, 0x56, 0x68, 0x50, 0x46, 0xE7, 0xAF, 0x8C, 0x29, 0x8B, 0x86, 0x60,
+    0x14, 0x55, 0xB3, 0x76, 0x7E, 0x29, 0xE4, 0x36, 0x53, 0x02, 0xE9, 0x6B, 0xCA, 0xEF, 0xF6, 0xC7,
+    0x91, 0x14, 0x16, 0xF5, 0x8E, 0x8A, 0x11, 0xBB, 0x96, 0x82, 0x9F, 0x31, 0x15, 0xCA, 0x56, 0xF8,
+    0x80, 0xBF, 0x12, 0xCF, 0x1C, 0xA9, 0x44, 0x14, 0x01, 0x63, 0x93, 0x70, 0x55, 0x35, 0xE4, 0x63,
+    0x23, 0xC8, 0xF4, 0x7B, 0x0A, 0x25, 0x95, 0xFE, 0x2A, 0xCA, 0x89, 0xA3, 0xE7, 0xFD, 0x62, 0x2E,
+    0xC3, 0x94, 0x87, 0x58, 0x9D, 0x30, 0x85, 0x17, 0x88, 0xC2, 0x6B, 0x78, 0xCE, 0x06, 0x4D, 0x7F,
+    0xB5, 0xD7, 0x56, 0x11, 0xE2, 0x65, 0x4F, 0xFB, 0xAE, 0x5C, 0xE7, 0x25, 0x8E, 0xBA, 0xBE, 0x3C,
+    0x38, 0xE5, 0xDE, 0xA9, 0x87, 0x5C, 0x6A, 0xFC, 0x3D, 0xCE, 0x21, 0x8B, 0x90, 0x95, 0x9F, 0xC5,
+    0x97, 0x45, 0xEE, 0xC1, 0x77, 0x41, 0x5B, 0x89, 0x0B, 0x6E, 0x1E, 0x07, 0x4E, 0x50, 0xD2, 0x30,
+    0xF7, 0xF8, 0x6B, 0x83, 0x3D, 0x9A, 0x97, 0x0B, 0xD2, 0x70, 0x35, 0x26, 0x12, 0x56, 0x6E, 0x9D,
+    0xCF, 0x61, 0x3C, 0xEB, 0x58, 0x90, 0x5E, 0xB7, 0x71, 0xD0, 0x3C, 0x86, 0x46, 0x28, 0x95, 0x20,
+    0xDD, 0xE8, 0x40, 0x8C, 0x21, 0x2D, 0x60, 0x21, 0xD4, 0x4F, 0x62, 0x2C, 0xB1, 0xCF, 0xCD, 0xC4,
+    0xD6, 0xF8, 0x6D, 0xF5, 0xF1, 0x43, 0x93, 0x78, 0xA4, 0xC9, 0x84, 0xE3, 0xE0, 0x20, 0x72, 0xC1,
+    0x95, 0x4D, 0x87, 0xCD, 0x03, 0x04, 0xE6, 0x5F, 0x6C, 0x84, 0xB6, 0xB0, 0xD7, 0x71, 0x0B, 0x22,
+    0x95, 0x3F, 0x48, 0xF7, 0xE0, 0x8A, 0xAE, 0x55, 0x6C, 0x12, 0xD0, 0x31, 0xB0, 0x1A, 0xA6, 0x1C,
+    0xF4, 0x7E, 0xA2, 0x00, 0x56, 0xEA, 0x2D, 0x27, 0x7D, 0x1B, 0xF0, 0xD3, 0xE2, 0x0D, 0xF3, 0x81,
+    0x0D, 0xBD, 0x32, 0x47, 0x6F, 0xEE, 0x46, 0x33, 0x73, 0xCF, 0x32, 0xE9, 0x1E, 0x9A, 0x88, 0x2C,
+    0xA0, 0xBC, 0x6F, 0xF9, 0x19, 0xF1, 0x9A, 0xBC, 0x93, 0xDE, 0xE0, 0xF3, 0xE7, 0x34, 0x29, 0xDA,
+    0x96, 0xCE, 0xD8, 0xEB, 0xAD, 0x36, 0xAA, 0x4C, 0x27, 0x0D, 0x3B, 0x91, 0xB8, 0x2A, 0x8A, 0xAA,
+    0x1A, 0x37, 0x7B, 0x4D, 0x7F, 0x29, 0x2B, 0xF9, 0xB9, 0x61, 0x7B, 0x2E, 0x07, 0x5B, 0x0E, 0x1F,
+    0xEF, 0xC3, 0x14, 0x98, 0x63, 0x7A, 0x1C, 0xED, 0x76, 0xE2, 0xE4, 0x52, 0xBA, 0x1F, 0x6B, 0x65,
+    0x6C, 0xF9, 0xD1, 0x85, 0x4D, 0xEB, 0xB1, 0x87, 0x77, 0xC0, 0xBD, 0x04, 0x7E, 0x2F, 0xE0, 0x22,
+    0x7D, 0x14, 0x4F, 0x01, 0x93, 0xBE, 0x88, 0xB9, 0xC5, 0xC0, 0xE0, 0xD3, 0xE4, 0xCB, 0x4A, 0x9F,
+    0x7C, 0x5E, 0xA7, 0xC3, 0xA5, 0xC1, 0xB1, 0x0E, 0xF2, 0x4A, 0x55, 0x9D, 0x0A, 0x35, 0xBD, 0x81,
+    0xA1, 0x4B, 0xF4, 0x56, 0x0F, 0x8F, 0xD3, 0x11, 0x94, 0x2A, 0xD0, 0xE5, 0x56, 0x0C, 0xDB, 0x6F,
+    0xAA, 0xAC, 0xA7, 0x63, 0x07, 0x4F, 0xB4, 0xE3, 0x7F, 0x29, 0x1F, 0xF7, 0x4B, 0x36, 0xD2, 0x36,
+    0xA0, 0x8F, 0x3F, 0x21, 0x9D, 0x29, 0xC8, 0x8A, 0xA9, 0x0F, 0x16, 0x3A, 0xAC, 0x39, 0xE8, 0x31,
+    0x7C, 0x51, 0x90, 0xD9, 0xE9, 0x39, 0x44, 0xD0, 0x46, 0x50, 0x72, 0x98, 0xA6, 0x98, 0xF9, 0x25,
+    0x3D, 0x7E, 0x48, 0x3B, 0x90, 0x51, 0xED, 0x86, 0x8C, 0xF0, 0x76, 0xBA, 0x52, 0x69, 0xEE, 0xFC,
+    0x3C, 0xD5, 0x12, 0x6E, 0xF5, 0x1D, 0x21, 0xDE, 0xB9, 0x1E, 0xCB, 0xEC, 0x24, 0x24, 0x3F, 0xFD,
+    0x82, 0xC6, 0xC0, 0x3D, 0x6E, 0xE9, 0xF4, 0xC9, 0x6E, 0xF5, 0x82, 0x0C, 0x43, 0xB7, 0x24, 0xDC,
+    0x77, 0xEB, 0x35, 0x7A, 0xFA, 0x27, 0x00, 0x8D, 0x13, 0x2A, 0xA5, 0x16, 0x64, 0x2E, 0x1B, 0x92,
+    0x9B, 0x23, 0x5D, 0xF4, 0xB8, 0xFF, 0x92, 0xCF, 0x29, 0x97, 0x5F, 0x1B, 0xB7, 0x3F, 0x32, 0x3B,
+    0xF9, 0x85, 0x57, 0x4B, 0xE3, 0x02, 0x23, 0xA1, 0xCB, 0x89, 0xEE, 0x31, 0x9A, 0x69, 0x86, 0x0C,
+    0x3C, 0xC4, 0xD0, 0x1E, 0x2B, 0x86, 0xF9, 0x1F, 0xAD, 0x8B, 0x14, 0xC0, 0x89, 0x08, 0x00, 0x00,
+};
+
+#define WEB_APP_CSS_ETAG "c5f1915d"
+#define WEB_APP_JS_ETAG "ea733a58"
+#define WEB_INDEX_HTML_ETAG "cbf1248d"
+#define WEB_LOGS_CSS_ETAG "8ea25411"
+#define WEB_LOGS_JS_ETAG "2a834244"
+
+static const WebAsset WEB_ASSETS[] = {
+    {"/app.css", "text/css", WEB_APP_CSS_GZ, sizeof(WEB_APP_CSS_GZ), "\"c5f1915d\""},
+    {"/app.js", "application/javascript", WEB_APP_JS_GZ, sizeof(WEB_APP_JS_GZ), "\"ea733a58\""},
+    {"/", "text/html", WEB_INDEX_HTML_GZ, sizeof(WEB_INDEX_HTML_GZ), "\"cbf1248d\""},
+    {"/logs.css", "text/css", WEB_LOGS_CSS_GZ, sizeof(WEB_LOGS_CSS_GZ), "\"8ea25411\""},
+    {"/logs.js", "application/javascript", WEB_LOGS_JS_GZ, sizeof(WEB_LOGS_JS_GZ), "\"2a834244\""},
+};
+static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);
@@ -10,7 +10,18 @@
 #include <ArduinoJson.h>
 #include <WiFi.h>
 #include "config.h"
+#include "clock.h"
 #include "logging.h"
+#include "metrics.h"
+#include "screenshot.h"
+#include "events.h"
+#include "capture.h"
+#include "heap_health.h"
+#include "boot_profile.h"
+#include "tariff.h"
+#include "mem_policy.h"
+#include <memory>
+#include "web_assets.h"
 
 // Demo mode flag (defined in main sketch)
 extern bool demoMode;
@@ -18,183 +29,1003 @@ extern bool demoMode;
 // Forward declaration of EVCCData
 extern EVCCData data;
 
+// Label and chart updates skipped because nothing visible changed (display_updates.cpp)
+extern uint32_t uiRedrawsSkipped;
+
+// Live log stream (/logs/stream) bookkeeping
+static volatile int logStreamClients = 0;
+static uint32_t logStreamDrops = 0;    // clients disconnected for falling behind the ring
+
+// EVCCData change feed (/events) bookkeeping
+static volatile int eventsClients = 0;
+static uint32_t eventsResyncs = 0;     // snapshots re-sent to clients that missed a delta
+
+// ?level= names, indexed by LOG_LEVEL_* value
+static const char* const LEVEL_PARAM_NAMES[] = {"error", "warn", "info", "debug", "verbose"};
+
+// Minimum level filter from query (?level=error|warn|info|debug|verbose)
+static uint8_t parseLevelParam(AsyncWebServerRequest *request) {
+    uint8_t filterLevel = LOG_MIN_LEVEL;
+    if (request->hasParam("level")) {
+        String lvl = request->getParam("level")->value(); lvl.toLowerCase();
+        for (uint8_t i = 0; i <= LOG_LEVEL_VERBOSE; i++) {
+            if (lvl == LEVEL_PARAM_NAMES[i]) filterLevel = i;
+        }
+    }
+    return filterLevel;
+}
+
+// Append s as JSON string contents at out[len]; false if it does not fit into cap
+static bool jsonEscapeInto(char* out, size_t cap, size_t& len, const char* s) {
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        char esc[7] = {0};
+        switch (c) {
+            case '"':  strcpy(esc, "\\\""); break;
+            case '\\': strcpy(esc, "\\\\"); break;
+            case '\n': strcpy(esc, "\\n"); break;
+            case '\r': strcpy(esc, "\\r"); break;
+            case '\t': strcpy(esc, "\\t"); break;
+            default: if (c < 0x20) snprintf(esc, sizeof(esc), "\\u%04x", c);
+        }
+        size_t n = esc[0] ? strlen(esc) : 1;
+        if (len + n >= cap) return false;
+        if (esc[0]) memcpy(out + len, esc, n); else out[len] = (char)c;
+        len += n;
+    }
+    return true;
+}
+
+// Format one log entry as an SSE "log" event; returns bytes written or 0 if it does not fit.
+// Collapsed entries carry their repeat count and when the newest repeat was logged.
+static size_t formatLogEvent(char* out, size_t cap, uint32_t seq, const LogEntry& e) {
+    int n = snprintf(out, cap, "id: %lu\nevent: log\ndata: {\"seq\":%lu,\"ms\":%lu,\"epoch\":%lu,\"lvl\":\"%s\",",
+                     (unsigned long)seq, (unsigned long)seq, e.timestamp, (unsigned long)e.epoch, levelToStr(e.level));
+    if (n < 0 || (size_t)n >= cap) return 0;
+    if (e.repeat) {
+        int r = snprintf(out + n, cap - n, "\"rep\":%u,\"lastMs\":%lu,\"lastEpoch\":%lu,",
+                         (unsigned)e.repeat, (unsigned long)e.lastTimestamp, (unsigned long)logLastEpoch(e));
+        if (r < 0 || (size_t)(n + r) >= cap) return 0;
+        n += r;
+    }
+    int m = snprintf(out + n, cap - n, "\"msg\":\"");
+    if (m < 0 || (size_t)(n + m) >= cap) return 0;
+    n += m;
+    size_t len = (size_t)n;
+    if (!jsonEscapeInto(out, cap, len, e.message)) return 0;
+    const char* tail = (e.flags & LOG_FLAG_RESTORED) ? "\",\"prev\":1}\n\n" : "\"}\n\n";
+    size_t tailLen = strlen(tail);
+    if (len + tailLen > cap) return 0;
+    memcpy(out + len, tail, tailLen);
+    return len + tailLen;
+}
+
+// Append s HTML-escaped at out[len]; stops early (truncates) when cap is reached
+static void htmlEscapeInto(char* out, size_t cap, size_t& len, const char* s) {
+    for (; *s; s++) {
+        const char* esc = nullptr;
+        switch (*s) {
+            case '<': esc = "&lt;"; break;
+            case '>': esc = "&gt;"; break;
+            case '&': esc = "&amp;"; break;
+            case '\'': esc = "&#39;"; break;
+        }
+        size_t n = esc ? strlen(esc) : 1;
+        if (len + n >= cap) return;
+        if (esc) memcpy(out + len, esc, n); else out[len] = *s;
+        len += n;
+    }
+}
+
+// Static parts of the /logs page; styling and the live-tail script are cached gzipped assets
+static const char LOGS_PAGE_HEAD[] PROGMEM =
+    "<!DOCTYPE html><html><head><title>EVCC Display Logs</title>"
+    "<meta name='viewport' content='width=device-width, initial-scale=1'>"
+    "<link rel='stylesheet' href='/logs.css?v=" WEB_LOGS_CSS_ETAG "'></head>";
+
+static const char LOGS_PAGE_INTRO[] PROGMEM =
+    "<h1>Debug Logs</h1>"
+    "<div class='meta'><a href='/'>&larr; Back</a> | <a href='/debug/toggle'>Toggle Debug</a><br>"
+    "Filter: <a href='/logs?level=error'>ERR</a> <a href='/logs?level=warn'>WRN</a> <a href='/logs?level=info'>INF</a> <a href='/logs?level=debug'>DBG</a> <a href='/logs?level=verbose'>VRB</a><br>"
+    "Times shown in your local timezone; unsynced entries show relative ms. Faded entries were restored from before the last reset.</div>";
+
+static const char LOGS_PAGE_TAIL[] PROGMEM =
+    "<script src='/logs.js?v=" WEB_LOGS_JS_ETAG "'></script></body></html>";
+
+// Generates the /logs page piece by piece for a chunked response. Entries are read lazily by
+// sequence number, one at a time, so a request needs only this object (a few hundred bytes)
+// instead of a ring snapshot plus the whole page in a String.
+struct LogPageWriter {
+    enum Part : uint8_t { HEAD, BODY_OPEN, INTRO, STATS, ENTRIES, TAIL, DONE };
+
+    uint8_t filterLevel;
+    uint8_t part = HEAD;
+    uint32_t cursor = 0;     // next entry to render
+    uint32_t end = 0;        // first entry not rendered (the live stream continues here)
+    uint32_t visible = 0;
+    const char* piece = nullptr;    // static text, or nullptr for scratch (stays valid when copied)
+    size_t pieceLen = 0;
+    size_t pieceOff = 0;
+    char scratch[400];       // one rendered row / dynamic snippet
+
+    explicit LogPageWriter(uint8_t level) : filterLevel(level) {
+        logSeqRange(cursor, end);
+        visible = end - cursor;
+    }
+
+    void setPiece(const char* p, size_t len) { piece = p; pieceLen = len; pieceOff = 0; }
+
+    // Load the next piece; false when the page is complete
+    bool advance() {
+        switch (part) {
+            case HEAD:
+                setPiece(LOGS_PAGE_HEAD, sizeof(LOGS_PAGE_HEAD) - 1);
+                part = BODY_OPEN;
+                return true;
+            case BODY_OPEN: {
+                // logs.js resumes the live stream from data-since
+                int n = snprintf(scratch, sizeof(scratch), "<body data-since='%lu' data-level='%s'>",
+                                 (unsigned long)end, LEVEL_PARAM_NAMES[filterLevel]);
+                setPiece(nullptr, n > 0 ? (size_t)n : 0);
+                part = INTRO;
+                return true;
+            }
+            case INTRO:
+                setPiece(LOGS_PAGE_INTRO, sizeof(LOGS_PAGE_INTRO) - 1);
+                part = STATS;
+                return true;
+            case STATS: {
+                int n = snprintf(scratch, sizeof(scratch),
+                    "<p>Total:%lu Visible:%lu Overwrites:%lu Dropped:%lu Collapsed:%lu RateLimited:%lu StreamDrops:%lu MinLevel:%d</p>",
+                    (unsigned long)logTotal, (unsigned long)visible, (unsigned long)logOverwrites, (unsigned long)logDropped,
+                    (unsigned long)logCollapsed, (unsigned long)logRateLimited, (unsigned long)logStreamDrops, (int)LOG_MIN_LEVEL);
+                setPiece(nullptr, n > 0 ? (size_t)n : 0);
+                part = ENTRIES;
+                return true;
+            }
+            case ENTRIES: {
+                LogEntry e;
+                while (cursor < end) {
+                    uint32_t seq = cursor++;
+                    if (!logReadEntry(seq, e)) {
+                        // Overwritten while the page was being sent: skip to what is still buffered
+                        uint32_t oldest, next;
+                        logSeqRange(oldest, next);
+                        if (cursor < oldest) cursor = oldest;
+                        continue;
+                    }
+                    if (!logLevelVisible(e.level, filterLevel)) continue;
+                    setPiece(nullptr, renderRow(seq, e));
+                    return true;
+                }
+                part = TAIL;
+                return advance();
+            }
+            case TAIL:
+                setPiece(LOGS_PAGE_TAIL, sizeof(LOGS_PAGE_TAIL) - 1);
+                part = DONE;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    size_t renderRow(uint32_t seq, const LogEntry& e) {
+        const char* lvl = levelToStr(e.level);
+        int n = snprintf(scratch, sizeof(scratch),
+            "<div class='log%s' data-seq='%lu' data-epoch='%lu' data-ms='%lu'><span class='timestamp'>[loading]</span><span class='lvl %s'>%s</span><span class='message'>",
+            (e.flags & LOG_FLAG_RESTORED) ? " prev" : "", (unsigned long)seq, (unsigned long)e.epoch, e.timestamp, lvl, lvl);
+        size_t len = (n > 0 && (size_t)n < sizeof(scratch)) ? (size_t)n : 0;
+        const size_t tailReserve = 112; // closing tags + repeat note always fit
+        htmlEscapeInto(scratch, sizeof(scratch) - tailReserve, len, e.message);
+        if (e.repeat) {
+            // logs.js adds the newest repeat's time from data-epoch / data-ms
+            n = snprintf(scratch + len, sizeof(scratch) - len,
+                "</span><span class='rep' data-n='%u' data-epoch='%lu' data-ms='%lu'>repeated %u&times;</span></div>",
+                (unsigned)e.repeat, (unsigned long)logLastEpoch(e), (unsigned long)e.lastTimestamp, (unsigned)e.repeat);
+        } else {
+            n = snprintf(scratch + len, sizeof(scratch) - len, "</span></div>");
+        }
+        return len + (n > 0 ? (size_t)n : 0);
+    }
+
+    // Chunked response callback body; returns 0 once the page is complete
+    size_t fill(char* out, size_t maxLen) {
+        size_t used = 0;
+        while (used < maxLen) {
+            if (pieceOff >= pieceLen) {
+                if (!advance()) break;
+                continue;
+            }
+            size_t n = pieceLen - pieceOff;
+            if (n > maxLen - used) n = maxLen - used;
+            memcpy(out + used, (piece ? piece : scratch) + pieceOff, n);
+            pieceOff += n;
+            used += n;
+        }
+        return used;
+    }
+};
+
+// Generates /metrics (Prometheus text exposition) one metric family at a time into a small
+// scratch buffer. Pipeline counters are copied once per scrape so all families are consistent.
+struct MetricsWriter {
+    PerfStats snap;
+    uint8_t family = 0;
+    size_t len = 0;
+    size_t off = 0;
+    char scratch[1024];      // largest family (poll histogram) is up to ~760 bytes
+
+    MetricsWriter() { perfSnapshot(snap); }
+
+    void appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (len >= sizeof(scratch)) return;
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(scratch + len, sizeof(scratch) - len, fmt, args);
+        va_end(args);
+        if (n > 0) len += (size_t)n;
+        if (len > sizeof(scratch) - 1) len = sizeof(scratch) - 1; // truncated
+    }
+    void header(const char* name, const char* type, const char* help) {
+        appendf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+    void gauge(const char* name, const char* help, double value) {
+        header(name, "gauge", help);
+        appendf("%s %.0f\n", name, value);
+    }
+    void counter(const char* name, const char* help, uint64_t value) {
+        header(name, "counter", help);
+        appendf("%s %llu\n", name, (unsigned long long)value);
+    }
+    void summary(const char* name, const char* help, const PerfTiming& t) {
+        header(name, "summary", help);
+        appendf("%s_sum %.6f\n%s_count %lu\n", name, t.sumUs / 1e6, name, (unsigned long)t.count);
+    }
+
+    // This boot's phases (boot_profile.h); earlier boots are in /status
+    void bootPhases(bool heap) {
+        const char* name = heap ? "evcc_boot_phase_free_heap_bytes" : "evcc_boot_phase_seconds";
+        header(name, "gauge", heap ? "Free heap when the boot phase completed." : "Time since reset when the boot phase completed.");
+        const BootProfile& p = bootProfileCurrent();
+        for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+            if (p.phases[i].us == 0) continue;
+            if (heap) appendf("%s{phase=\"%s\"} %lu\n", name, bootPhaseName((BootPhase)i), (unsigned long)p.phases[i].freeHeap);
+            else appendf("%s{phase=\"%s\"} %.6f\n", name, bootPhaseName((BootPhase)i), p.phases[i].us / 1e6);
+        }
+    }
+
+    // Render the next family into scratch; false when all have been written
+    bool advance() {
+        len = 0;
+        off = 0;
+        switch (family++) {
+            case 0: gauge("evcc_uptime_seconds", "Seconds since boot.", clockMillis() / 1000); break;
+            case 1: gauge("evcc_heap_free_bytes", "Free heap.", ESP.getFreeHeap()); break;
+            case 2: gauge("evcc_heap_largest_free_block_bytes", "Largest allocatable heap block.", ESP.getMaxAllocHeap()); break;
+            case 3: gauge("evcc_heap_min_free_bytes", "Lowest free heap since boot.", ESP.getMinFreeHeap()); break;
+            case 4: {
+                header("evcc_poll_duration_seconds", "histogram", "EVCC API request latency including body download.");
+                uint32_t cumulative = 0;
+                for (int i = 0; i < POLL_LATENCY_BUCKET_COUNT; i++) {
+                    cumulative += snap.pollBuckets[i];
+                    appendf("evcc_poll_duration_seconds_bucket{le=\"%g\"} %lu\n", POLL_LATENCY_BUCKETS[i], (unsigned long)cumulative);
+                }
+                cumulative += snap.pollBuckets[POLL_LATENCY_BUCKET_COUNT];
+                appendf("evcc_poll_duration_seconds_bucket{le=\"+Inf\"} %lu\n", (unsigned long)cumulative);
+                appendf("evcc_poll_duration_seconds_sum %.6f\nevcc_poll_duration_seconds_count %lu\n",
+                        snap.poll.sumUs / 1e6, (unsigned long)snap.poll.count);
+                break;
+            }
+            case 5: counter("evcc_poll_failures_total", "Polls without a usable HTTP response.", snap.pollFailures); break;
+            case 6: summary("evcc_parse_duration_seconds", "Time spent parsing the EVCC payload.", snap.parse); break;
+            case 7: counter("evcc_parse_errors_total", "Payloads that failed to parse.", snap.parseErrors); break;
+            case 8: summary("evcc_ui_update_duration_seconds", "Time spent applying data to the widgets.", snap.uiUpdate); break;
+            case 9: summary("evcc_display_flush_duration_seconds", "Time spent pushing rendered areas to the display.", snap.flush); break;
+            case 10: counter("evcc_display_flush_pixels_total", "Pixels pushed to the display.", snap.flushPixels); break;
+            case 11: counter("evcc_redraws_skipped_total", "Label and chart updates skipped because nothing visible changed.", uiRedrawsSkipped); break;
+            case 12: {
+                header("evcc_stage_duration_max_seconds", "gauge", "Slowest single run of each pipeline stage since boot.");
+                const PerfTiming* stages[] = {&snap.poll, &snap.parse, &snap.uiUpdate, &snap.flush};
+                const char* names[] = {"poll", "parse", "ui_update", "flush"};
+                for (int i = 0; i < 4; i++) {
+                    appendf("evcc_stage_duration_max_seconds{stage=\"%s\"} %.6f\n", names[i], stages[i]->maxUs / 1e6);
+                }
+                break;
+            }
+            case 13: {
+                bool connected = WiFi.status() == WL_CONNECTED;
+                gauge("evcc_wifi_connected", "1 while associated with the access point.", connected ? 1 : 0);
+                if (connected) gauge("evcc_wifi_rssi_dbm", "Received signal strength.", WiFi.RSSI());
+                break;
+            }
+            case 14: counter("evcc_wifi_disconnects_total", "Connection losses seen by the main loop.", snap.wifiDisconnects); break;
+            case 15: counter("evcc_wifi_reconnects_total", "Connections re-established after a loss.", snap.wifiReconnects); break;
+            case 16: counter("evcc_log_entries_total", "Log entries stored.", logTotal); break;
+            case 17:
+                header("evcc_log_dropped_total", "counter", "Log messages not kept in the ring, by reason.");
+                appendf("evcc_log_dropped_total{reason=\"level\"} %lu\n", (unsigned long)logDropped);
+                appendf("evcc_log_dropped_total{reason=\"rate_limited\"} %lu\n", (unsigned long)logRateLimited);
+                appendf("evcc_log_dropped_total{reason=\"overwritten\"} %lu\n", (unsigned long)logOverwrites);
+                break;
+            case 18: counter("evcc_log_collapsed_total", "Duplicate log lines folded into a repeat count.", logCollapsed); break;
+            case 19: counter("evcc_log_stream_drops_total", "Live log viewers disconnected for falling behind.", logStreamDrops); break;
+            case 20:
+                header("evcc_task_stack_free_min_bytes", "gauge", "Stack high-water mark (least free stack seen).");
+                if (perfLoopTask) {
+                    appendf("evcc_task_stack_free_min_bytes{task=\"loop\"} %lu\n", (unsigned long)uxTaskGetStackHighWaterMark(perfLoopTask));
+                }
+                // Response callbacks run on the async TCP task
+                appendf("evcc_task_stack_free_min_bytes{task=\"async_tcp\"} %lu\n", (unsigned long)uxTaskGetStackHighWaterMark(nullptr));
+                break;
+            case 21: summary("evcc_screenshot_render_duration_seconds", "Full-screen band re-render time for /screenshot.bmp.", snap.screenshot); break;
+            case 22: gauge("evcc_events_clients", "Connected /events subscribers.", eventsClients); break;
+            case 23: counter("evcc_events_resyncs_total", "Snapshots re-sent to /events subscribers that missed a delta.", eventsResyncs); break;
+            case 24: {
+                CaptureStats cs;
+                captureGetStats(cs);
+                gauge("evcc_capture_records", "Responses held in the capture ring.", cs.records);
+                gauge("evcc_capture_bytes", "Encoded size of the capture ring contents.", cs.bytesUsed);
+                gauge("evcc_capture_raw_bytes", "Decoded size of the capture ring contents.", cs.rawBytes);
+                break;
+            }
+            case 25:
+                gauge("evcc_heap_largest_free_block_trend_bytes_per_hour", "Trend of the hourly minimum largest free block.", heapHealth.largestTrend);
+                gauge("evcc_heap_restart_planned_timestamp_seconds", "Planned maintenance restart (0 = none).", (double)heapHealth.restartAt);
+                break;
+            case 26: bootPhases(false); break;
+            case 27: bootPhases(true); break;
+            default:
+                return false;
+        }
+        return true;
+    }
+
+    // Chunked response callback body; returns 0 once all families are written
+    size_t fill(char* out, size_t maxLen) {
+        size_t used = 0;
+        while (used < maxLen) {
+            if (off >= len) {
+                if (!advance()) break;
+                continue;
+            }
+            size_t n = len - off;
+            if (n > maxLen - used) n = maxLen - used;
+            memcpy(out + used, scratch + off, n);
+            off += n;
+            used += n;
+        }
+        return used;
+    }
+};
+
+// Streams the capture ring as NDJSON, one decoded response per line. The body is JSON-escaped
+// straight into the send buffer, so a line never has to exist in memory as a whole.
+static volatile bool captureDownloadBusy = false; // decoding needs three payload-sized buffers
+
+struct CaptureWriter {
+    enum Part : uint8_t { NEXT, HEAD, BODY, TAIL };
+
+    std::shared_ptr<CaptureReader> reader;
+    uint8_t part = NEXT;
+    CaptureInfo info;
+    const char* body = nullptr;
+    size_t bodyOff = 0;
+    char head[112];
+    size_t headLen = 0;
+    size_t headOff = 0;
+
+    explicit CaptureWriter(std::shared_ptr<CaptureReader> r) : reader(r) {}
+
+    size_t fill(char* out, size_t maxLen) {
+        size_t used = 0;
+        while (used < maxLen) {
+            switch (part) {
+                case NEXT: {
+                    if (!reader->next(info, body)) return used;
+                    int n = snprintf(head, sizeof(head), "{\"seq\":%lu,\"ms\":%lu,\"epoch\":%lu,\"len\":%u,%s\"body\":\"",
+                                     (unsigned long)info.seq, (unsigned long)info.ms, (unsigned long)info.epoch,
+                                     (unsigned)info.len, info.truncated ? "\"truncated\":true," : "");
+                    headLen = n > 0 ? (size_t)n : 0;
+                    headOff = 0;
+                    bodyOff = 0;
+                    part = HEAD;
+                    break;
+                }
+                case HEAD: {
+                    size_t n = headLen - headOff;
+                    if (n > maxLen - used) n = maxLen - used;
+                    memcpy(out + used, head + headOff, n);
+                    headOff += n;
+                    used += n;
+                    if (headOff == headLen) part = BODY;
+                    break;
+                }
+                case BODY: {
+                    // Escape one character at a time; stop when the next escape does not fit
+                    while (bodyOff < info.len) {
+                        char one[2] = {body[bodyOff], 0};
+                        size_t len = 0;
+                        char esc[8];
+                        if (one[0] == 0) { memcpy(esc, "\\u0000", 6); len = 6; }
+                        else if (!jsonEscapeInto(esc, sizeof(esc), len, one)) break;
+                        if (len > maxLen - used) return used;
+                        memcpy(out + used, esc, len);
+                        used += len;
+                        bodyOff++;
+                    }
+                    part = TAIL;
+                    headOff = 0;
+                    break;
+                }
+                case TAIL: {
+                    static const char tail[] = "\"}\n";
+                    size_t n = sizeof(tail) - 1 - headOff;
+                    if (n > maxLen - used) n = maxLen - used;
+                    memcpy(out + used, tail + headOff, n);
+                    headOff += n;
+                    used += n;
+                    if (headOff == sizeof(tail) - 1) part = NEXT;
+                    break;
+                }
+            }
+        }
+        return used;
+    }
+};
+
+// Serve an embedded gzipped asset straight from flash, answering revalidations with 304
+static void sendAsset(AsyncWebServerRequest *request, const WebAsset* asset) {
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset->etag) {
+        AsyncWebServerResponse *notModified = request->beginResponse(304);
+        notModified->addHeader("ETag", asset->etag);
+        request->send(notModified);
+        return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse_P(200, asset->mime, asset->gz, asset->gzLen);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", asset->etag);
+    // Pages revalidate (cheap 304); CSS/JS are linked with ?v=<hash> and never change under a URL
+    response->addHeader("Cache-Control", strcmp(asset->mime, "text/html") == 0 ? "no-cache" : "public, max-age=31536000, immutable");
+    request->send(response);
+}
+
+// Toggle endpoints: POST (status page script) answers JSON, GET (plain link) redirects back
+static void sendToggleResult(AsyncWebServerRequest *request, const char* key, bool value) {
+    if (request->method() == HTTP_POST) {
+        char json[48];
+        snprintf(json, sizeof(json), "{\"%s\":%s}", key, value ? "true" : "false");
+        request->send(200, "application/json", json);
+    } else {
+        request->redirect("/");
+    }
+}
+
+// /status payload cache. The JSON is rendered once per data update by the loop task into the
+// back buffer of a double buffer and published by bumping statusGen; requests copy from the
+// current buffer straight into the send buffer, so serialization no longer scales with clients.
+// Both buffers are one memAllocLarge() block, made on the first render.
+static char* statusBuf[2] = {nullptr, nullptr};
+static size_t statusLen[2] = {0, 0};
+static uint32_t statusSeq[2] = {0, 0};  // first /events delta not yet reflected in the buffer
+static uint32_t statusHash[2] = {0, 0}; // ETag: hash of the serialized document
+static uint32_t statusBufGen[2] = {0, 0}; // generation a buffer holds, 0 while it is rewritten
+static uint32_t statusGen = 0;
+static volatile bool statusDirty = false;
+static portMUX_TYPE statusMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void statusEtag(char* out, size_t cap, uint32_t hash) {
+    snprintf(out, cap, "\"%08lx\"", (unsigned long)hash);
+}
+
+// Request a re-render from the loop task (e.g. after a setting changed in a web handler)
+void statusCacheInvalidate() { statusDirty = true; }
+bool statusCacheDirty() { return statusDirty; }
+
+// Hands the /status document one persistent memAllocLarge() block, so it neither sits on the
+// loop task's stack nor churns the heap on every render (loop task only). A failed
+// allocation is retried on the next render.
+static void* statusDocBlock = nullptr;
+struct StatusDocAllocator {
+    void* allocate(size_t size) {
+        if (!statusDocBlock) statusDocBlock = memAllocLarge("status document", STATUS_DOC_CAPACITY);
+        return size <= STATUS_DOC_CAPACITY ? statusDocBlock : nullptr;
+    }
+    void deallocate(void*) {}
+    void* reallocate(void* p, size_t size) { return size <= STATUS_DOC_CAPACITY ? p : nullptr; }
+};
+
+// Render the /status payload; call from the loop task only (reads EVCCData unlocked)
+void statusCacheRender() {
+    statusDirty = false;
+    BasicJsonDocument<StatusDocAllocator> doc(STATUS_DOC_CAPACITY);
+    if (doc.capacity() == 0) return;
+    doc["uptime"] = clockMillis() / 1000;
+    doc["freeHeap"] = ESP.getFreeHeap();
+    // Buffer placement (mem_policy.h)
+    JsonObject memory = doc.createNestedObject("memory");
+    memory["psram"] = memPsramAvailable();
+    if (memPsramAvailable()) {
+        memory["psramSize"] = ESP.getPsramSize();
+        memory["psramFree"] = ESP.getFreePsram();
+    }
+    MemPlacement placed[MEM_MAX_PLACEMENTS];
+    int placedCount = memPlacements(placed, MEM_MAX_PLACEMENTS);
+    JsonArray buffers = memory.createNestedArray("buffers");
+    for (int i = 0; i < placedCount; i++) {
+        JsonObject b = buffers.createNestedObject();
+        b["name"] = placed[i].name;
+        b["size"] = placed[i].size;
+        b["region"] = memRegionName(placed[i].region);
+    }
+    // Heap trend (heap_health.h): hourly minima oldest first, slopes in bytes/hour
+    JsonObject heap = doc.createNestedObject("heapHealth");
+    heap["largestBlock"] = heapHealth.last.largestBlock;
+    heap["minFree"] = heapHealth.last.minFree;
+    heap["largestTrend"] = (long)heapHealth.largestTrend;
+    heap["freeTrend"] = (long)heapHealth.freeTrend;
+    heap["hoursToFloor"] = heapHealth.hoursToFloor;
+    heap["restartAt"] = (unsigned long)heapHealth.restartAt;
+    HeapSample hourly[HEAP_TREND_HOURS];
+    int hours = heapHealthHourly(hourly, HEAP_TREND_HOURS);
+    JsonArray largestHourly = heap.createNestedArray("largestHourly");
+    for (int i = 0; i < hours; i++) largestHourly.add(hourly[i].largestBlock);
+    // Boot phase profiles (boot_profile.h), oldest first: completion time in us since reset
+    // and free heap per phase, 0 where a phase was not reached
+    BootProfile profiles[BOOT_PROFILE_HISTORY];
+    int profileCount = bootProfileHistory(profiles, BOOT_PROFILE_HISTORY);
+    JsonObject boot = doc.createNestedObject("bootProfiles");
+    JsonArray phaseNames = boot.createNestedArray("phases");
+    for (int i = 0; i < BOOT_PHASE_COUNT; i++) phaseNames.add(bootPhaseName((BootPhase)i));
+    JsonArray boots = boot.createNestedArray("boots");
+    for (int b = 0; b < profileCount; b++) {
+        JsonObject o = boots.createNestedObject();
+        o["boot"] = profiles[b].boot;
+        JsonArray us = o.createNestedArray("us");
+        JsonArray heapAt = o.createNestedArray("heap");
+        for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+            us.add(profiles[b].phases[i].us);
+            heapAt.add(profiles[b].phases[i].freeHeap);
+        }
+    }
+    // LVGL's static pool (lv_conf.h), separate from the heap above
+    lv_mem_monitor_t lvMem;
+    lv_mem_monitor(&lvMem);
+    JsonObject lvglMem = doc.createNestedObject("lvglMem");
+    lvglMem["size"] = lvMem.total_size;
+    lvglMem["used"] = lvMem.total_size - lvMem.free_size;
+    lvglMem["maxUsed"] = lvMem.max_used;
+    lvglMem["biggestFree"] = lvMem.free_biggest_size;
+    lvglMem["fragPct"] = lvMem.frag_pct;
+    doc["debugEnabled"] = debugEnabled;
+    doc["demoMode"] = demoMode;
+    doc["wifiConnected"] = WiFi.status() == WL_CONNECTED;
+    doc["ipAddress"] = WiFi.localIP().toString();
+    doc["logBufferSize"] = logCount;
+    JsonObject logStats = doc.createNestedObject("log");
+    logStats["total"] = logTotal;
+    logStats["count"] = logCount;
+    logStats["capacity"] = logCapacity;
+    logStats["overwrites"] = logOverwrites;
+    logStats["dropped"] = logDropped;
+    logStats["collapsed"] = logCollapsed;
+    logStats["rateLimited"] = logRateLimited;
+    logStats["minLevel"] = LOG_MIN_LEVEL;
+    logStats["streamClients"] = logStreamClients;
+    logStats["streamDrops"] = logStreamDrops;
+
+    // Reset-reason / uptime history (RTC memory, oldest first)
+    ResetRecord resets[RTC_RESET_HISTORY];
+    int resetCount = rtcResetHistory(resets, RTC_RESET_HISTORY);
+    JsonArray resetArr = doc.createNestedArray("resets");
+    for (int i = 0; i < resetCount; i++) {
+        JsonObject r = resetArr.createNestedObject();
+        r["boot"] = resets[i].boot;
+        r["uptime"] = resets[i].uptimeSec;
+        r["startEpoch"] = (unsigned long)resets[i].startEpoch;
+        r["endReason"] = resetReasonToStr(resets[i].endReason);
+    }
+    
+    // Grid tariff forecast (tariff.h): prices in 0.1 ct/kWh
+    JsonObject tariffObj = doc.createNestedObject("tariff");
+    tariffObj["slots"] = tariff.count;
+    tariffObj["dropped"] = tariff.dropped;
+    tariffObj["slotSeconds"] = tariff.slotSeconds;
+    tariffObj["fetchedAt"] = (unsigned long)tariff.fetchedAt;
+    time_t tariffNow = clockEpoch();
+    int tariffSlot = tariffCurrentSlot(tariff, tariffNow);
+    if (tariffSlot >= 0) {
+        tariffObj["current"] = tariff.price[tariffSlot];
+        int cheapest = tariffCheapestWindow(tariff, tariffSlot, tariffWindowSlots(tariff));
+        if (cheapest >= 0) tariffObj["cheapestStart"] = (unsigned long)tariff.start[cheapest];
+    }
+    
+    // Add current EVCC data
+    JsonObject evcc = doc.createNestedObject("evcc");
+    evcc["gridPower"] = data.gridPower;
+    evcc["pvPower"] = data.pvPower;
+    evcc["homePower"] = data.homePower;
+    evcc["batteryPower"] = data.batteryPower;
+    evcc["batterySoc"] = data.batterySoc;
+    evcc["solarForecastTodayEnergy"] = data.solarForecastTodayEnergy;
+    evcc["solarForecastScale"] = data.solarForecastScale;
+    
+    // Add loadpoint 1 data
+    JsonObject lp1 = doc.createNestedObject("loadpoint1");
+    lp1["title"] = data.lp1.title;
+    lp1["vehicleTitle"] = data.lp1.vehicleTitle;
+    lp1["chargePower"] = data.lp1.chargePower;
+    lp1["charging"] = data.lp1.charging;
+    lp1["plugged"] = data.lp1.plugged;
+    lp1["soc"] = data.lp1.soc;
+    lp1["vehicleRange"] = data.lp1.vehicleRange;
+    lp1["effectivePlanSoc"] = data.lp1.effectivePlanSoc;
+    lp1["effectiveLimitSoc"] = data.lp1.effectiveLimitSoc;
+    lp1["effectivePlanTime"] = data.lp1.effectivePlanTime;
+    lp1["planProjectedStart"] = data.lp1.planProjectedStart;
+    lp1["phasesActive"] = data.lp1.phasesActive;
+    lp1["maxCurrent"] = data.lp1.maxCurrent;
+    lp1["offeredCurrent"] = data.lp1.offeredCurrent;
+    lp1["chargeRemainingDuration"] = data.lp1.chargeRemainingDuration;
+    lp1["chargedEnergy"] = data.lp1.chargedEnergy;
+    JsonArray lp1currents = lp1.createNestedArray("chargeCurrents");
+    for (int i = 0; i < 3; i++) lp1currents.add(data.lp1.chargeCurrents[i]);
+    
+    // Add loadpoint 2 data
+    JsonObject lp2 = doc.createNestedObject("loadpoint2");
+    lp2["title"] = data.lp2.title;
+    lp2["vehicleTitle"] = data.lp2.vehicleTitle;
+    lp2["chargePower"] = data.lp2.chargePower;
+    lp2["charging"] = data.lp2.charging;
+    lp2["plugged"] = data.lp2.plugged;
+    lp2["soc"] = data.lp2.soc;
+    lp2["vehicleRange"] = data.lp2.vehicleRange;
+    lp2["effectivePlanSoc"] = data.lp2.effectivePlanSoc;
+    lp2["effectiveLimitSoc"] = data.lp2.effectiveLimitSoc;
+    lp2["effectivePlanTime"] = data.lp2.effectivePlanTime;
+    lp2["planProjectedStart"] = data.lp2.planProjectedStart;
+    lp2["phasesActive"] = data.lp2.phasesActive;
+    lp2["maxCurrent"] = data.lp2.maxCurrent;
+    lp2["offeredCurrent"] = data.lp2.offeredCurrent;
+    lp2["chargeRemainingDuration"] = data.lp2.chargeRemainingDuration;
+    lp2["chargedEnergy"] = data.lp2.chargedEnergy;
+    JsonArray lp2currents = lp2.createNestedArray("chargeCurrents");
+    for (int i = 0; i < 3; i++) lp2currents.add(data.lp2.chargeCurrents[i]);
+
+    if (!statusBuf[0]) {
+        char* block = (char*)memAllocLarge("status cache", 2 * STATUS_JSON_CAPACITY);
+        if (!block) return;
+        statusBuf[0] = block;
+        statusBuf[1] = block + STATUS_JSON_CAPACITY;
+    }
+    int back = (statusGen + 1) & 1;
+    // The snapshot at boot shows placeholder or restored data: deltas are taken against it
+    eventsSeed(data);
+    uint32_t eventsOldest, eventsNext;
+    eventsSeqRange(eventsOldest, eventsNext);
+    size_t needed = measureJson(doc);
+    if (doc.overflowed() || needed >= STATUS_JSON_CAPACITY) {
+        // Never publish a truncated document; /status keeps serving the previous generation
+        LOG_RATE_LIMITED(60000, LOG_LEVEL_WARN, "Status JSON incomplete: " + String(needed) + " bytes, doc " + String(doc.memoryUsage()));
+        return;
+    }
+    // The back buffer still holds generation statusGen - 1, which /status transfers may be
+    // copying from: retire it under the lock first so they abort instead of reading a mix
+    portENTER_CRITICAL(&statusMux);
+    statusBufGen[back] = 0;
+    portEXIT_CRITICAL(&statusMux);
+    size_t n = serializeJson(doc, statusBuf[back], STATUS_JSON_CAPACITY);
+    portENTER_CRITICAL(&statusMux);
+    statusLen[back] = n;
+    statusSeq[back] = eventsNext;
+    statusHash[back] = fnv1a(statusBuf[back], n);
+    statusGen++;
+    statusBufGen[back] = statusGen;
+    portEXIT_CRITICAL(&statusMux);
+}
+
+// Format the cached /status document as an SSE "snapshot" event. Returns 0 (try again later)
+// until a render that includes delta minSeq - 1 exists and the event fits; sets cursor to the
+// first delta the snapshot does not include.
+static size_t formatSnapshotEvent(char* out, size_t cap, uint32_t minSeq, uint32_t& cursor) {
+    size_t used = 0;
+    portENTER_CRITICAL(&statusMux);
+    int cur = statusGen & 1;
+    size_t len = statusLen[cur];
+    uint32_t seq = statusSeq[cur];
+    if (len > 0 && seq >= minSeq) {
+        int h = seq > 0 ? snprintf(out, cap, "id: %lu\nevent: snapshot\ndata: ", (unsigned long)(seq - 1))
+                        : snprintf(out, cap, "event: snapshot\ndata: ");
+        if (h > 0 && (size_t)h + len + 2 <= cap) {
+            memcpy(out + h, statusBuf[cur], len);
+            used = h + len;
+            out[used++] = '\n';
+            out[used++] = '\n';
+            cursor = seq;
+        }
+    }
+    portEXIT_CRITICAL(&statusMux);
+    return used;
+}
+
 // Setup web server endpoints
 void setupWebServer(AsyncWebServer& server) {
-    // Root endpoint - simple status page
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-        String html = "<!DOCTYPE html><html><head><title>EVCC Display</title>";
-        html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-        html += "<style>body{font-family:Arial;margin:20px;background:#f0f0f0;}";
-        html += "h1{color:#333;}.card{background:white;padding:15px;margin:10px 0;border-radius:5px;box-shadow:0 2px 4px rgba(0,0,0,0.1);}";
-        html += "a{color:#2196F3;text-decoration:none;font-weight:bold;}.btn{display:inline-block;padding:10px 20px;background:#2196F3;color:white;border-radius:5px;margin:5px;}";
-        html += ".status{color:#4CAF50;font-weight:bold;}</style></head><body>";
-        html += "<h1>EVCC Display Status</h1>";
-        html += "<div class='card'><h2>System Info</h2>";
-        html += "<p><strong>IP Address:</strong> " + WiFi.localIP().toString() + "</p>";
-        html += "<p><strong>Free Heap:</strong> " + String(ESP.getFreeHeap()) + " bytes</p>";
-        html += "<p><strong>Uptime:</strong> " + String(millis() / 1000) + " seconds</p>";
-        html += "<p><strong>Debug Mode:</strong> <span class='status'>" + String(debugEnabled ? "ON" : "OFF") + "</span></p>";
-        html += "<p><strong>Demo Mode:</strong> <span class='status'>" + String(demoMode ? "ON" : "OFF") + "</span></p>";
-        html += "</div><div class='card'><h2>Quick Links</h2>";
-        html += "<a href='/logs' class='btn'>View Logs</a> ";
-        html += "<a href='/status' class='btn'>JSON Status</a> ";
-        html += "<a href='/debug/toggle' class='btn'>Toggle Debug</a>";
-        html += String(" <a href='/demo/toggle' class='btn'>") + (demoMode?"Live Mode":"Demo Mode") + "</a>";
-        html += "</div></body></html>";
-        request->send(200, "text/html", html);
-    });
+    // Static UI (pre-gzipped in flash, see tools/embed_web.py); live values come from /status
+    for (size_t i = 0; i < WEB_ASSET_COUNT; i++) {
+        const WebAsset* asset = &WEB_ASSETS[i];
+        server.on(asset->path, HTTP_GET, [asset](AsyncWebServerRequest *request){
+            sendAsset(request, asset);
+        });
+    }
     
-    // Status endpoint - JSON format
+    // Status endpoint - JSON format. Served from the cache rendered by statusCacheRender();
+    // unchanged payloads are answered with 304 via the content ETag.
     server.on("/status", HTTP_GET, [](AsyncWebServerRequest *request){
-        StaticJsonDocument<2048> doc;
-        doc["uptime"] = millis() / 1000;
-        doc["freeHeap"] = ESP.getFreeHeap();
-        doc["debugEnabled"] = debugEnabled;
-        doc["wifiConnected"] = WiFi.status() == WL_CONNECTED;
-        doc["ipAddress"] = WiFi.localIP().toString();
-        doc["logBufferSize"] = logCount;
-        JsonObject logStats = doc.createNestedObject("log");
-        logStats["total"] = logTotal;
-        logStats["count"] = logCount;
-        logStats["overwrites"] = logOverwrites;
-        logStats["dropped"] = logDropped;
-        logStats["minLevel"] = LOG_MIN_LEVEL;
-        
-        // Add current EVCC data
-        JsonObject evcc = doc.createNestedObject("evcc");
-        evcc["gridPower"] = data.gridPower;
-        evcc["pvPower"] = data.pvPower;
-        evcc["homePower"] = data.homePower;
-        evcc["batteryPower"] = data.batteryPower;
-        evcc["batterySoc"] = data.batterySoc;
-        evcc["solarForecastTodayEnergy"] = data.solarForecastTodayEnergy;
-        evcc["solarForecastScale"] = data.solarForecastScale;
-        
-        // Add loadpoint 1 data
-        JsonObject lp1 = doc.createNestedObject("loadpoint1");
-        lp1["title"] = data.lp1.title;
-        lp1["vehicleTitle"] = data.lp1.vehicleTitle;
-        lp1["chargePower"] = data.lp1.chargePower;
-        lp1["charging"] = data.lp1.charging;
-        lp1["plugged"] = data.lp1.plugged;
-        lp1["soc"] = data.lp1.soc;
-        lp1["vehicleRange"] = data.lp1.vehicleRange;
-        lp1["effectivePlanSoc"] = data.lp1.effectivePlanSoc;
-        lp1["effectiveLimitSoc"] = data.lp1.effectiveLimitSoc;
-        lp1["effectivePlanTime"] = data.lp1.effectivePlanTime;
-        lp1["planProjectedStart"] = data.lp1.planProjectedStart;
-        lp1["phasesActive"] = data.lp1.phasesActive;
-        lp1["maxCurrent"] = data.lp1.maxCurrent;
-        lp1["offeredCurrent"] = data.lp1.offeredCurrent;
-        lp1["chargeRemainingDuration"] = data.lp1.chargeRemainingDuration;
-        lp1["chargedEnergy"] = data.lp1.chargedEnergy;
-        JsonArray lp1currents = lp1.createNestedArray("chargeCurrents");
-        for (int i = 0; i < 3; i++) lp1currents.add(data.lp1.chargeCurrents[i]);
-        
-        // Add loadpoint 2 data
-        JsonObject lp2 = doc.createNestedObject("loadpoint2");
-        lp2["title"] = data.lp2.title;
-        lp2["vehicleTitle"] = data.lp2.vehicleTitle;
-        lp2["chargePower"] = data.lp2.chargePower;
-        lp2["charging"] = data.lp2.charging;
-        lp2["plugged"] = data.lp2.plugged;
-        lp2["soc"] = data.lp2.soc;
-        lp2["vehicleRange"] = data.lp2.vehicleRange;
-        lp2["effectivePlanSoc"] = data.lp2.effectivePlanSoc;
-        lp2["effectiveLimitSoc"] = data.lp2.effectiveLimitSoc;
-        lp2["effectivePlanTime"] = data.lp2.effectivePlanTime;
-        lp2["planProjectedStart"] = data.lp2.planProjectedStart;
-        lp2["phasesActive"] = data.lp2.phasesActive;
-        lp2["maxCurrent"] = data.lp2.maxCurrent;
-        lp2["offeredCurrent"] = data.lp2.offeredCurrent;
-        lp2["chargeRemainingDuration"] = data.lp2.chargeRemainingDuration;
-        lp2["chargedEnergy"] = data.lp2.chargedEnergy;
-        JsonArray lp2currents = lp2.createNestedArray("chargeCurrents");
-        for (int i = 0; i < 3; i++) lp2currents.add(data.lp2.chargeCurrents[i]);
-        
-        String output;
-        serializeJson(doc, output);
-        request->send(200, "application/json", output);
+        uint32_t gen, hash;
+        size_t len;
+        portENTER_CRITICAL(&statusMux);
+        gen = statusGen;
+        len = statusLen[gen & 1];
+        hash = statusHash[gen & 1];
+        portEXIT_CRITICAL(&statusMux);
+        if (len == 0) {
+            request->send(503, "text/plain", "Status not ready");
+            return;
+        }
+        char etag[16];
+        statusEtag(etag, sizeof(etag), hash);
+        if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag) {
+            AsyncWebServerResponse *notModified = request->beginResponse(304);
+            notModified->addHeader("ETag", etag);
+            request->send(notModified);
+            return;
+        }
+        AsyncWebServerResponse *response = request->beginResponse("application/json", len,
+            [request, gen](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                size_t n = 0;
+                bool gone;
+                portENTER_CRITICAL(&statusMux);
+                // The second render after gen rewrites gen's buffer; it clears statusBufGen under
+                // the lock before writing the first byte, so a copy here is either whole or refused
+                gone = statusBufGen[gen & 1] != gen;
+                if (!gone && index < statusLen[gen & 1]) {
+                    n = statusLen[gen & 1] - index;
+                    if (n > maxLen) n = maxLen;
+                    memcpy(buffer, statusBuf[gen & 1] + index, n);
+                }
+                portEXIT_CRITICAL(&statusMux);
+                // Returning 0 does not end a Content-Length response (it would be polled until
+                // the client times out), so drop the connection. abort() defers the disconnect
+                // callbacks to the async TCP task, so the request outlives this call.
+                if (gone) request->client()->abort();
+                return n;
+            });
+        response->addHeader("ETag", etag);
+        response->addHeader("Cache-Control", "no-cache");
+        request->send(response);
+    });
+    
+    // Prometheus metrics (text exposition format), streamed family by family
+    server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+        MetricsWriter writer;
+        request->send(request->beginChunkedResponse("text/plain; version=0.0.4",
+            [writer](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+                return writer.fill((char*)buffer, maxLen);
+            }));
+    });
+    
+    // EVCCData change feed (Server-Sent Events). New subscribers get a "snapshot" event (the
+    // cached /status document), then "delta" events with only the changed fields, read from a
+    // shared ring with a per-client cursor. A client that misses a delta (fell behind the ring,
+    // or the delta was too large to keep) gets a fresh snapshot instead of a growing queue.
+    server.on("/events", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (eventsClients >= EVENTS_MAX_CLIENTS) {
+            request->send(503, "text/plain", "Too many event stream clients");
+            return;
+        }
+        uint32_t oldest, next;
+        eventsSeqRange(oldest, next);
+        uint32_t cursor = 0;
+        bool needSnapshot = true;
+        if (request->hasHeader("Last-Event-ID")) {
+            cursor = strtoul(request->header("Last-Event-ID").c_str(), nullptr, 10) + 1;
+            needSnapshot = cursor < oldest || cursor > next; // resume from the ring when possible
+        }
+        uint32_t minSnapshotSeq = 0;
+
+        eventsClients++;
+        request->onDisconnect([](){ eventsClients--; });
+
+        uint32_t lastSend = clockMillis();
+        AsyncWebServerResponse *response = request->beginChunkedResponse("text/event-stream",
+            [cursor, needSnapshot, minSnapshotSeq, lastSend](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            char *out = (char*)buffer;
+            if (index == 0) {
+                return snprintf(out, maxLen, "retry: 3000\n\n");
+            }
+            size_t used = 0;
+            if (needSnapshot) {
+                used = formatSnapshotEvent(out, maxLen, minSnapshotSeq, cursor);
+                if (used > 0) needSnapshot = false;
+            }
+            if (!needSnapshot) {
+                uint32_t oldest, next;
+                eventsSeqRange(oldest, next);
+                while (cursor < next) {
+                    char head[40];
+                    int h = snprintf(head, sizeof(head), "id: %lu\nevent: delta\ndata: ", (unsigned long)cursor);
+                    if (used + h + 2 >= maxLen) break;
+                    int n = eventsRead(cursor, out + used + h, maxLen - used - h - 2);
+                    if (n == -2) break; // continue once the send buffer has drained
+                    if (n <= 0) {
+                        // Overwritten or too large: resync from a render that includes it
+                        eventsResyncs++;
+                        needSnapshot = true;
+                        minSnapshotSeq = cursor + 1;
+                        break;
+                    }
+                    memcpy(out + used, head, h);
+                    used += h + n;
+                    out[used++] = '\n';
+                    out[used++] = '\n';
+                    cursor++;
+                }
+            }
+            uint32_t now = clockMillis();
+            if (used > 0) {
+                lastSend = now;
+                return used;
+            }
+            if (now - lastSend >= EVENTS_HEARTBEAT_MS && maxLen > 8) {
+                lastSend = now;
+                memcpy(out, ":ping\n\n", 7);
+                return 7;
+            }
+            return RESPONSE_TRY_AGAIN;
+        });
+        response->addHeader("Cache-Control", "no-cache");
+        request->send(response);
+    });
+    
+    // Recent raw EVCC responses as NDJSON (corpus for host-side replay and parser benchmarks)
+    server.on("/capture", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (captureDownloadBusy) {
+            request->send(503, "text/plain", "Capture download already running");
+            return;
+        }
+        std::shared_ptr<CaptureReader> reader(new CaptureReader());
+        if (!reader->ok()) {
+            request->send(503, "text/plain", "Out of memory");
+            return;
+        }
+        captureDownloadBusy = true;
+        request->onDisconnect([](){ captureDownloadBusy = false; });
+        CaptureWriter writer(reader);
+        request->send(request->beginChunkedResponse("application/x-ndjson",
+            [writer](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+                return writer.fill((char*)buffer, maxLen);
+            }));
+    });
+    
+    // Screen capture: the loop task re-renders the screen band by band, each band is streamed
+    // as BMP rows before the next one is rendered (no frame buffer needed)
+    server.on("/screenshot.bmp", HTTP_GET, [](AsyncWebServerRequest *request){
+        uint32_t id = screenshotBegin();
+        if (!id) {
+            request->send(503, "text/plain", "Screenshot busy or out of memory");
+            return;
+        }
+        request->onDisconnect([id](){ screenshotAbort(id); });
+        AsyncWebServerResponse *response = request->beginResponse("image/bmp", SCREENSHOT_BMP_SIZE,
+            [](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return screenshotFill(buffer, maxLen, index);
+            });
+        response->addHeader("Cache-Control", "no-store");
+        request->send(response);
+    });
+    
+    // Live log tail (Server-Sent Events). Every client keeps its own sequence cursor and only
+    // entries past it are formatted, directly into the TCP send buffer as the socket drains.
+    // A client that falls behind the ring is dropped instead of being buffered for.
+    server.on("/logs/stream", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (logStreamClients >= LOG_STREAM_MAX_CLIENTS) {
+            request->send(503, "text/plain", "Too many log stream clients");
+            return;
+        }
+        uint32_t oldest, next;
+        logSeqRange(oldest, next);
+        uint32_t cursor = oldest;
+        if (request->hasHeader("Last-Event-ID")) {
+            cursor = strtoul(request->header("Last-Event-ID").c_str(), nullptr, 10) + 1;
+        } else if (request->hasParam("since")) {
+            cursor = strtoul(request->getParam("since")->value().c_str(), nullptr, 10);
+        }
+        if (cursor > next) cursor = next;     // id from before a reboot
+        if (cursor < oldest) cursor = oldest; // resume with what is still buffered
+        uint8_t filterLevel = parseLevelParam(request);
+
+        logStreamClients++;
+        request->onDisconnect([](){ logStreamClients--; });
+
+        uint32_t lastSend = clockMillis();
+        bool dropped = false;
+        uint16_t repeatSent = 0; // repeat count of entry cursor - 1 as last sent
+        AsyncWebServerResponse *response = request->beginChunkedResponse("text/event-stream",
+            [cursor, filterLevel, lastSend, dropped, repeatSent](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+            if (dropped) return 0; // ends the response
+            char *out = (char*)buffer;
+            if (index == 0) {
+                // Headers only go out together with the first body bytes
+                return snprintf(out, maxLen, "retry: 3000\n\n");
+            }
+            uint32_t oldest, next;
+            logSeqRange(oldest, next);
+            if (cursor < oldest) {
+                logStreamDrops++;
+                dropped = true;
+                int n = snprintf(out, maxLen, "event: overflow\ndata: %lu\n\n", (unsigned long)(oldest - cursor));
+                return (n > 0 && (size_t)n < maxLen) ? (size_t)n : 0;
+            }
+            size_t used = 0;
+            LogEntry e;
+            // Duplicates collapse into the newest entry, usually after it went out: send it
+            // again with the new count (logs.js updates the row with the same seq)
+            if (cursor > oldest && logReadEntry(cursor - 1, e) && e.repeat != repeatSent) {
+                if (logLevelVisible(e.level, filterLevel)) {
+                    used = formatLogEvent(out, maxLen, cursor - 1, e);
+                    if (used == 0) return RESPONSE_TRY_AGAIN;
+                }
+                repeatSent = e.repeat;
+            }
+            while (cursor < next && logReadEntry(cursor, e)) {
+                if (logLevelVisible(e.level, filterLevel)) {
+                    size_t n = formatLogEvent(out + used, maxLen - used, cursor, e);
+                    if (n == 0) break; // send buffer full, continue from here on next ack
+                    used += n;
+                }
+                repeatSent = e.repeat;
+                cursor++;
+            }
+            uint32_t now = clockMillis();
+            if (used > 0) {
+                lastSend = now;
+                return used;
+            }
+            if (now - lastSend >= LOG_STREAM_HEARTBEAT_MS && maxLen > 8) {
+                lastSend = now;
+                memcpy(out, ":ping\n\n", 7);
+                return 7;
+            }
+            return RESPONSE_TRY_AGAIN; // polled again by the async TCP task
+        });
+        response->addHeader("Cache-Control", "no-cache");
+        request->send(response);
     });
     
-    // Logs endpoint - HTML format (client converts epoch to local time)
+    // Logs endpoint - HTML format (client converts epoch to local time).
+    // Registered after /logs/stream: a handler also matches every URL below its own path
     server.on("/logs", HTTP_GET, [](AsyncWebServerRequest *request){
-        // Determine minimum level filter from query (?level=error|warn|info|debug|verbose)
-        uint8_t filterLevel = LOG_MIN_LEVEL;
-        if (request->hasParam("level")) {
-            String lvl = request->getParam("level")->value(); lvl.toLowerCase();
-            if (lvl == "error") filterLevel = LOG_LEVEL_ERROR; else
-            if (lvl == "warn") filterLevel = LOG_LEVEL_WARN; else
-            if (lvl == "info") filterLevel = LOG_LEVEL_INFO; else
-            if (lvl == "debug") filterLevel = LOG_LEVEL_DEBUG; else
-            if (lvl == "verbose") filterLevel = LOG_LEVEL_VERBOSE;
-        }
-
-        // Snapshot under lock
-        LogEntry snapshot[LOG_BUFFER_SIZE];
-        int snapCount = 0;
-        int snapHead = 0;
-        portENTER_CRITICAL(&logMux);
-        snapCount = logCount;
-        snapHead = logHead;
-        for (int i = 0; i < snapCount; i++) {
-            int idx = (logHead - snapCount + i + LOG_BUFFER_SIZE) % LOG_BUFFER_SIZE;
-            snapshot[i] = logBuffer[idx];
-        }
-        portEXIT_CRITICAL(&logMux);
-
-        String html = "<!DOCTYPE html><html><head><title>EVCC Display Logs</title>";
-        html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-        html += "<meta http-equiv='refresh' content='10'>";
-        html += "<style>body{font-family:Arial,monospace;margin:20px;background:#1e1e1e;color:#d4d4d4;}";
-        html += "h1{color:#4CAF50;margin-top:0;} .log{background:#2d2d30;padding:6px 10px;margin:4px 0;border-left:3px solid #4CAF50;font-size:12px;line-height:1.4;}";
-        html += ".timestamp{color:#8ab4f8;font-weight:bold;margin-right:6px;} .lvl{display:inline-block;font-size:10px;padding:2px 4px;border-radius:3px;margin-right:4px;}";
-        html += ".lvl.ERR{background:#b71c1c;color:#fff;} .lvl.WRN{background:#ff9800;color:#000;} .lvl.INF{background:#2196f3;color:#fff;} .lvl.DBG{background:#455a64;color:#fff;} .lvl.VRB{background:#607d8b;color:#fff;}";
-        html += ".message{color:#e0e0e0;white-space:pre-wrap;word-break:break-word;} a{color:#4CAF50;text-decoration:none;display:inline-block;margin:10px 0;} .meta{font-size:11px;color:#888;margin-bottom:10px;}";
-        html += "</style></head><body>";
-        html += "<h1>Debug Logs</h1>";
-        html += "<div class='meta'><a href='/'>&larr; Back</a> | <a href='/debug/toggle'>Toggle Debug</a><br>";
-        html += "Filter: <a href='/logs?level=error'>ERR</a> <a href='/logs?level=warn'>WRN</a> <a href='/logs?level=info'>INF</a> <a href='/logs?level=debug'>DBG</a> <a href='/logs?level=verbose'>VRB</a><br>";
-        html += "Times shown in your local timezone; unsynced entries show relative ms.</div>";
-        html += "<p>Total:" + String(logTotal) + " Visible:" + String(snapCount) + " Overwrites:" + String(logOverwrites) + " Dropped:" + String(logDropped) + " MinLevel:" + String(LOG_MIN_LEVEL) + "</p>";
-
-        for (int i = 0; i < snapCount; i++) {
-            const LogEntry &e = snapshot[i];
-            if (e.level < filterLevel) continue;
-            html += "<div class='log' data-epoch='" + String((unsigned long)e.epoch) + "' data-ms='" + String(e.timestamp) + "'>";
-            html += "<span class='timestamp'>[loading]</span><span class='lvl " + String(levelToStr(e.level)) + "'>" + String(levelToStr(e.level)) + "</span>";
-            html += "<span class='message'>" + String(e.message) + "</span></div>";
-        }
-
-        html += "<script>(function(){function fmt(e){if(!e)return null; if(e<100000)return null; return new Date(e*1000);}";
-        html += "document.querySelectorAll('.log').forEach(function(row){var epoch=parseInt(row.dataset.epoch);var ms=row.dataset.ms;var span=row.querySelector('.timestamp');var d=fmt(epoch);if(d){span.textContent='['+d.toLocaleString()+']';}else{span.textContent='['+ms+' ms]';}});})();</script>";
-        html += "</body></html>";
-        request->send(200, "text/html", html);
+        LogPageWriter writer(parseLevelParam(request));
+        request->send(request->beginChunkedResponse("text/html",
+            [writer](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+                return writer.fill((char*)buffer, maxLen);
+            }));
     });
     
     // Debug toggle endpoint
-    server.on("/debug/toggle", HTTP_GET, [](AsyncWebServerRequest *request){
+    server.on("/debug/toggle", HTTP_GET | HTTP_POST, [](AsyncWebServerRequest *request){
         debugEnabled = !debugEnabled;
-        String message = "Debug mode is now " + String(debugEnabled ? "ON" : "OFF");
-        logMessage(message, true); // Force to serial
-        
-        String html = "<!DOCTYPE html><html><head><title>Debug Toggle</title>";
-        html += "<meta http-equiv='refresh' content='2;url=/'>";
-        html += "<style>body{font-family:Arial;margin:50px;text-align:center;background:#f0f0f0;}";
-        html += "h1{color:#4CAF50;}</style></head><body>";
-        html += "<h1>✓ " + message + "</h1>";
-        html += "<p>Redirecting to status page...</p></body></html>";
-        request->send(200, "text/html", html);
+        logMessage(String("Debug mode is now ") + (debugEnabled ? "ON" : "OFF"), true); // Force to serial
+        statusCacheInvalidate();
+        sendToggleResult(request, "debugEnabled", debugEnabled);
     });
 
     // Demo mode toggle
-    server.on("/demo/toggle", HTTP_GET, [](AsyncWebServerRequest *request){
+    server.on("/demo/toggle", HTTP_GET | HTTP_POST, [](AsyncWebServerRequest *request){
         demoMode = !demoMode;
-        String message = String("Demo mode is now ") + (demoMode?"ON":"OFF");
-        logMessage(message, true);
-        String html = "<!DOCTYPE html><html><head><title>Demo Toggle</title><meta http-equiv='refresh' content='1;url=/'></head><body style='font-family:Arial;text-align:center;margin-top:60px'>";
-        html += "<h1>" + message + "</h1><p>Redirecting...</p></body></html>";
-        request->send(200, "text/html", html);
+        logMessage(String("Demo mode is now ") + (demoMode ? "ON" : "OFF"), true);
+        statusCacheInvalidate();
+        sendToggleResult(request, "demoMode", demoMode);
     });
     
     // 404 handler
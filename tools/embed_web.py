@@ -0,0 +1,123 @@
+"""
+Embed the web UI (web/) into the firmware as pre-gzipped flash arrays.
+
+Runs automatically before every PlatformIO build (extra_scripts = pre:...) and
+can be run by hand for Arduino IDE builds:
+
+    python tools/embed_web.py
+
+Writes src/web_assets.h. Each asset gets a content hash used as its ETag;
+"{{etag:<file>}}" placeholders in HTML files are replaced with the hash of the
+referenced file so pages can link versioned, long-cached CSS/JS.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+MIME_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+}
+
+PLACEHOLDER = re.compile(r"\{\{etag:([^}]+)\}\}")
+
+
+def project_dir():
+    try:
+        return env.subst("$PROJECT_DIR")  # noqa: F821 (provided by PlatformIO)
+    except NameError:
+        return os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def symbol(name):
+    return "WEB_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def url_path(name):
+    return "/" if name == "index.html" else "/" + name
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def build(root):
+    web_dir = os.path.join(root, "web")
+    out_path = os.path.join(root, "src", "web_assets.h")
+    names = sorted(n for n in os.listdir(web_dir) if os.path.splitext(n)[1] in MIME_TYPES)
+
+    sources = {}
+    for name in names:
+        with open(os.path.join(web_dir, name), "rb") as f:
+            sources[name] = f.read()
+
+    # Non-HTML first so HTML placeholders can reference their hashes
+    etags = {}
+    ordered = sorted(names, key=lambda n: n.endswith(".html"))
+    for name in ordered:
+        data = sources[name]
+        if name.endswith(".html"):
+            text = data.decode("utf-8")
+            text = PLACEHOLDER.sub(lambda m: etags[m.group(1)], text)
+            data = text.encode("utf-8")
+            sources[name] = data
+        etags[name] = hashlib.sha1(data).hexdigest()[:8]
+
+    out = [
+        "// Generated by tools/embed_web.py from web/ - do not edit",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "struct WebAsset {",
+        "    const char* path;      // URL path",
+        "    const char* mime;",
+        "    const uint8_t* gz;     // gzip-compressed body (flash)",
+        "    size_t gzLen;",
+        "    const char* etag;      // quoted content hash",
+        "};",
+        "",
+    ]
+    total_raw = total_gz = 0
+    for name in names:
+        gz = gzip.compress(sources[name], compresslevel=9, mtime=0)
+        total_raw += len(sources[name])
+        total_gz += len(gz)
+        out.append("// %s: %d bytes, %d gzipped" % (name, len(sources[name]), len(gz)))
+        out.append("static const uint8_t %s_GZ[] PROGMEM = {" % symbol(name))
+        out.append(c_array(gz))
+        out.append("};")
+        out.append("")
+
+    for name in names:
+        out.append('#define %s_ETAG "%s"' % (symbol(name), etags[name]))
+    out.append("")
+    out.append("static const WebAsset WEB_ASSETS[] = {")
+    for name in names:
+        mime = MIME_TYPES[os.path.splitext(name)[1]]
+        out.append('    {"%s", "%s", %s_GZ, sizeof(%s_GZ), "\\"%s\\""},' % (
+            url_path(name), mime, symbol(name), symbol(name), etags[name]))
+    out.append("};")
+    out.append("static const size_t WEB_ASSET_COUNT = sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]);")
+    out.append("")
+    content = "\n".join(out)
+
+    old = None
+    if os.path.exists(out_path):
+        with open(out_path) as f:
+            old = f.read()
+    if old != content:  # keep the timestamp stable so unchanged assets don't trigger rebuilds
+        with open(out_path, "w") as f:
+            f.write(content)
+    print("embed_web: %d assets, %d bytes -> %d gzipped" % (len(names), total_raw, total_gz))
+
+
+build(project_dir())
@@ -0,0 +1,358 @@
+"""
+Per-module flash and RAM footprint of the firmware, from the linker map.
+
+Registered as PlatformIO targets by platformio.ini (extra_scripts = post:...), which
+also makes the linker write $BUILD_DIR/firmware.map:
+
+    pio run -t footprint              report, diffed against tools/footprint_baseline.json
+    pio run -t footprint-baseline     report and store it as the new baseline
+
+or by hand on any map file:
+
+    python tools/footprint.py .pio/build/esp32dev/firmware.map [--baseline FILE]
+        [--save-baseline FILE] [--by object] [--symbols 25] [--json]
+
+Every input section of the map is assigned to a column by the output section it was
+placed in (ESP32 layout):
+
+    code    .flash.text             instruction flash (cached)
+    rodata  .flash.rodata           constants, fonts, images, strings
+    iram    .iram0.*                IRAM code (copied from flash at boot)
+    data    .dram0.data             initialized DRAM (copied from flash at boot)
+    bss     .dram0.bss, .noinit     zeroed / uninitialized DRAM: static buffers
+    rtc     .rtc.*, .rtc_noinit     RTC slow/fast memory
+    psram   .ext_ram.*              external RAM
+
+"flash" is what the image occupies (code + rodata + iram + data + rtc), "dram" is
+data + bss. Modules are src/ files, libraries (lvgl, TFT_eSPI, ...), the Arduino core
+and ESP-IDF components; --by object splits libraries into their object files.
+Symbols come from -ffunction-sections/-fdata-sections names, demangled with c++filt
+when one is on the PATH.
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+COLUMNS = ("code", "rodata", "iram", "data", "bss", "rtc", "psram")
+
+# Output section prefix -> column; anything else (debug info, .comment, ...) is not loaded
+SECTION_COLUMNS = (
+    (".flash.text", "code"),
+    (".flash.rodata", "rodata"),
+    (".flash.appdesc", "rodata"),
+    (".iram0", "iram"),
+    (".dram0.data", "data"),
+    (".dram0.bss", "bss"),
+    (".noinit", "bss"),
+    (".rtc", "rtc"),
+    (".ext_ram", "psram"),
+)
+
+# Memory Configuration regions reported with their size limit
+REGIONS = (
+    ("iram0_0_seg", "IRAM", ("iram",)),
+    ("dram0_0_seg", "DRAM", ("data", "bss")),
+    ("drom0_0_seg", "flash rodata", ("rodata",)),
+    ("irom0_0_seg", "flash code", ("code",)),
+)
+
+SECTION_PREFIXES = (".literal.", ".text.", ".rodata.", ".data.", ".bss.", ".sdata.", ".sbss.",
+                    ".iram1.", ".dram1.", ".rtc.", ".noinit.", ".ext_ram.")
+
+BASELINE_MIN_SYMBOL = 64   # smaller symbols are summed per module only
+
+OUTPUT_RE = re.compile(r"^(\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?")
+INPUT_RE = re.compile(r"^ (\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+))?$")
+FILL_RE = re.compile(r"^ \*fill\*\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+CONTINUED_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$")
+SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([^\s=].*)$")
+REGION_RE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+ARCHIVE_RE = re.compile(r"(?:^|[\\/])lib([^\\/]+)\.a\((.+)\)$")
+
+
+def column_of(output_section):
+    for prefix, column in SECTION_COLUMNS:
+        if output_section.startswith(prefix):
+            return column
+    return None
+
+
+def module_of(path, by_object):
+    m = ARCHIVE_RE.search(path)
+    if m:
+        lib = "arduino-core" if m.group(1) == "FrameworkArduino" else m.group(1)
+        return "%s/%s" % (lib, m.group(2)) if by_object else lib
+    norm = path.replace("\\", "/")
+    if "/src/" in norm:
+        name = norm.split("/src/")[-1]
+        return "src/" + re.sub(r"\.o$", "", name)
+    return os.path.basename(norm) or "(linker)"
+
+
+def symbol_of(section):
+    for prefix in SECTION_PREFIXES:
+        if section.startswith(prefix):
+            name = section[len(prefix):]
+            # merged strings/constants and numbered IRAM_ATTR sections carry no symbol name
+            if not name or name.isdigit() or re.match(r"^(str|cst)\d", name):
+                return None
+            return name
+    return None
+
+
+class Entry:
+    __slots__ = ("column", "module", "symbol", "size")
+
+    def __init__(self, column, module, symbol, size):
+        self.column, self.module, self.symbol, self.size = column, module, symbol, size
+
+
+def parse_map(path, by_object):
+    """Returns (entries, regions) where regions maps name -> length."""
+    with open(path, errors="replace") as f:
+        lines = f.read().splitlines()
+
+    regions = {}
+    i = 0
+    while i < len(lines) and not lines[i].startswith("Memory Configuration"):
+        i += 1
+    while i < len(lines) and not lines[i].startswith("Linker script and memory map"):
+        m = REGION_RE.match(lines[i])
+        if m and m.group(1) != "Name":
+            regions[m.group(1)] = int(m.group(3), 16)
+        i += 1
+
+    entries = []
+    column = None
+    pending = None          # input section whose name is on the previous line
+    last = None             # last entry still waiting for a symbol name
+    for line in lines[i:]:
+        if not line:
+            continue
+        if line[0] == ".":
+            m = OUTPUT_RE.match(line)
+            column = column_of(m.group(1)) if m else None
+            pending = last = None
+            continue
+        if column is None:
+            continue
+        if pending is not None:
+            m = CONTINUED_RE.match(line)
+            section, pending = pending, None
+            if m:
+                last = add_entry(entries, column, section, int(m.group(1), 16), int(m.group(2), 16),
+                                 m.group(3), by_object)
+                continue
+        m = FILL_RE.match(line)
+        if m:
+            if int(m.group(2), 16):
+                entries.append(Entry(column, "(alignment)", "*fill*", int(m.group(2), 16)))
+            last = None
+            continue
+        m = INPUT_RE.match(line)
+        if m and (m.group(1)[0] == "." or m.group(1) == "COMMON"):  # not linker script patterns
+            section = m.group(1)
+            if m.group(2) is None:
+                pending = section
+                last = None
+            else:
+                last = add_entry(entries, column, section, int(m.group(2), 16), int(m.group(3), 16),
+                                 m.group(4), by_object)
+            continue
+        m = SYMBOL_RE.match(line)
+        if m and last is not None and last.symbol is None:
+            last.symbol = m.group(2).strip()
+            last = None
+    for e in entries:
+        if e.symbol is None:
+            e.symbol = "(unnamed)"
+    return entries, regions
+
+
+def add_entry(entries, column, section, addr, size, source, by_object):
+    if size == 0 or addr == 0:
+        return None
+    source = source.strip()
+    e = Entry(column, module_of(source, by_object), None, size)
+    name = symbol_of(section)
+    if name is not None:
+        e.symbol = name
+    entries.append(e)
+    return e if name is None else None
+
+
+def demangle(names):
+    tool = shutil.which("xtensa-esp32-elf-c++filt") or shutil.which("c++filt")
+    mangled = sorted(n for n in names if n.startswith("_Z"))
+    if not tool or not mangled:
+        return {}
+    try:
+        out = subprocess.run([tool], input="\n".join(mangled), capture_output=True, text=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return {}
+    return dict(zip(mangled, out.splitlines()))
+
+
+def empty_row():
+    return dict.fromkeys(COLUMNS, 0)
+
+
+def summarize(entries, regions):
+    totals = empty_row()
+    modules = {}
+    symbols = {}
+    for e in entries:
+        totals[e.column] += e.size
+        modules.setdefault(e.module, empty_row())[e.column] += e.size
+        key = "%s %s" % (e.module, e.symbol)
+        symbols.setdefault(key, empty_row())[e.column] += e.size
+    names = demangle({k.split(" ", 1)[1] for k in symbols})
+    if names:
+        symbols = {"%s %s" % (k.split(" ", 1)[0], names.get(k.split(" ", 1)[1], k.split(" ", 1)[1])): v
+                   for k, v in symbols.items()}
+    return {"totals": totals, "regions": regions, "modules": modules, "symbols": symbols}
+
+
+def flash(row):
+    return row["code"] + row["rodata"] + row["iram"] + row["data"] + row["rtc"]
+
+
+def dram(row):
+    return row["data"] + row["bss"]
+
+
+def print_table(title, rows, limit=None, delta=None):
+    print(title)
+    header = "  %-44s %8s %8s %8s %8s %8s %8s %8s %8s" % ("", "flash", "code", "rodata", "iram", "data", "bss",
+                                                          "dram", "rtc")
+    print(header)
+    items = sorted(rows.items(), key=lambda kv: -(flash(kv[1]) + kv[1]["bss"]))
+    if limit:
+        items = items[:limit]
+    for name, r in items:
+        print("  %-44s %8d %8d %8d %8d %8d %8d %8d %8d" % (name[:44], flash(r), r["code"], r["rodata"], r["iram"],
+                                                            r["data"], r["bss"], dram(r), r["rtc"]))
+    print()
+
+
+def report(summary, symbol_limit):
+    t = summary["totals"]
+    print("footprint: flash %d bytes (code %d, rodata %d, iram %d, data %d), dram %d (data %d, bss %d), rtc %d%s\n"
+          % (flash(t), t["code"], t["rodata"], t["iram"], t["data"], dram(t), t["data"], t["bss"], t["rtc"],
+             ", psram %d" % t["psram"] if t["psram"] else ""))
+    for region, label, columns in REGIONS:
+        length = summary["regions"].get(region)
+        if length:
+            used = sum(t[c] for c in columns)
+            print("  %-13s %8d of %8d bytes  %5.1f%%" % (label, used, length, 100.0 * used / length))
+    print()
+    print_table("by module:", summary["modules"])
+    print_table("largest symbols:", summary["symbols"], symbol_limit)
+    static = {k: v for k, v in summary["symbols"].items() if dram(v) >= 256}
+    print_table("static RAM (data + bss >= 256 bytes):",
+                {k: v for k, v in sorted(static.items(), key=lambda kv: -dram(kv[1]))}, symbol_limit)
+
+
+def diff_rows(old, new, min_change):
+    changes = []
+    for name in set(old) | set(new):
+        a, b = old.get(name, empty_row()), new.get(name, empty_row())
+        d = {c: b.get(c, 0) - a.get(c, 0) for c in COLUMNS}
+        df, dd = flash(d), dram(d)
+        if abs(df) >= min_change or abs(dd) >= min_change:
+            state = "new" if name not in old else "gone" if name not in new else ""
+            changes.append((name, df, dd, d["iram"], state))
+    changes.sort(key=lambda c: -(abs(c[1]) + abs(c[2])))
+    return changes
+
+
+def report_diff(baseline, summary, symbol_limit):
+    bt, t = baseline["totals"], summary["totals"]
+    print("vs baseline: flash %+d bytes (%d -> %d), dram %+d bytes (%d -> %d), iram %+d bytes\n"
+          % (flash(t) - flash(bt), flash(bt), flash(t), dram(t) - dram(bt), dram(bt), dram(t),
+             t["iram"] - bt["iram"]))
+    for title, old, new, min_change in (
+            ("modules", baseline["modules"], summary["modules"], 1),
+            ("symbols", baseline["symbols"], kept_symbols(summary["symbols"]), BASELINE_MIN_SYMBOL)):
+        changes = diff_rows(old, new, min_change)
+        if not changes:
+            continue
+        print("changed %s:" % title)
+        print("  %-52s %9s %9s %9s" % ("", "flash", "dram", "iram"))
+        for name, df, dd, di, state in changes[:symbol_limit]:
+            print("  %-52s %+9d %+9d %+9d %s" % (name[:52], df, dd, di, state))
+        print()
+
+
+def kept_symbols(symbols):
+    return {k: v for k, v in symbols.items() if flash(v) + v["bss"] + v["psram"] >= BASELINE_MIN_SYMBOL}
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("map", help="linker map (-Wl,-Map)")
+    parser.add_argument("--baseline", help="compare with this baseline JSON")
+    parser.add_argument("--save-baseline", metavar="FILE", help="store this build as the baseline")
+    parser.add_argument("--by", choices=("module", "object"), default="module")
+    parser.add_argument("--symbols", type=int, default=25, help="rows in the symbol tables")
+    parser.add_argument("--json", action="store_true", help="print the summary as JSON")
+    args = parser.parse_args(argv)
+
+    entries, regions = parse_map(args.map, args.by == "object")
+    if not entries:
+        sys.exit("%s: no loadable sections found (not an ESP32 linker map?)" % args.map)
+    summary = summarize(entries, regions)
+    if args.json:
+        json.dump(summary, sys.stdout, indent=1, sort_keys=True)
+        print()
+    else:
+        report(summary, args.symbols)
+
+    if args.baseline:
+        if os.path.exists(args.baseline):
+            with open(args.baseline) as f:
+                report_diff(json.load(f), summary, args.symbols)
+        else:
+            print("no baseline at %s (pio run -t footprint-baseline stores one)" % args.baseline)
+    if args.save_baseline:
+        stored = dict(summary, symbols=kept_symbols(summary["symbols"]))
+        with open(args.save_baseline, "w") as f:
+            json.dump(stored, f, indent=1, sort_keys=True)
+            f.write("\n")
+        print("baseline written to %s" % args.save_baseline)
+
+
+def register_targets(env):
+    project = env.subst("$PROJECT_DIR")
+    script = os.path.join(project, "tools", "footprint.py")
+    baseline = os.path.join(project, "tools", "footprint_baseline.json")
+    map_file = "$BUILD_DIR/firmware.map"
+    env.Append(LINKFLAGS=["-Wl,-Map," + map_file])
+    run = '"$PYTHONEXE" "%s" "%s" ' % (script, map_file)
+    env.AddCustomTarget(
+        name="footprint",
+        dependencies="$BUILD_DIR/${PROGNAME}.elf",
+        actions=[run + '--baseline "%s"' % baseline],
+        title="Footprint",
+        description="Per-module flash/RAM report, diffed against tools/footprint_baseline.json")
+    env.AddCustomTarget(
+        name="footprint-baseline",
+        dependencies="$BUILD_DIR/${PROGNAME}.elf",
+        actions=[run + '--save-baseline "%s"' % baseline],
+        title="Footprint baseline",
+        description="Store the current footprint as tools/footprint_baseline.json")
+
+
+if __name__ == "__main__":
+    main()
+else:
+    try:
+        Import("env")  # noqa: F821 (PlatformIO extra script)
+        register_targets(env)  # noqa: F821
+    except NameError:
+        pass
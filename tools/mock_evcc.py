@@ -0,0 +1,357 @@
+"""
+Mock EVCC server for exercising httpGet() and the parser under bad network conditions.
+
+Serves GET /api/state (the jq query is ignored, bodies already have the filtered shape
+the display asks for), GET /api/tariff/grid (a synthetic 24 h price forecast in 15 min
+slots) and a /ws WebSocket that pushes the state. Faults apply to both HTTP endpoints.
+Runs on localhost for host builds or on the LAN for device soak tests (point EVCC_HOST and
+EVCC_PORT in wifi_config.h at it):
+
+    python tools/mock_evcc.py --port 7070 --scenario tools/scenarios/faults.json
+    python tools/mock_evcc.py --capture capture.ndjson --host 0.0.0.0
+
+State comes from a /capture download (bodies are served in order, looping), a single
+JSON file (--state) or, by default, a synthetic day (PV curve, house load, battery and
+one charging car) that follows the wall clock.
+
+A scenario is a JSON object; every key is optional:
+
+    {
+      "latency_ms": 80 | {"min": 20, "max": 400} | {"median": 150, "p99": 3000},
+      "error_rate": 0.05, "error_status": [500, 502, 503],
+      "reset_rate": 0.02,          connection reset, before or in the middle of the body
+      "truncate_rate": 0.02,       valid HTTP response carrying cut-off JSON
+      "redirect_rate": 0.01,       302 to the same URL (the device does not follow it)
+      "huge_rate": 0.01, "huge_bytes": 65536,
+      "chunked": false | true | 0.5 (probability),
+      "drip": {"rate": 0.1, "bytes": 16, "interval_ms": 250},
+      "stall": {"rate": 0.01, "ms": 12000},   headers sent, body after ms
+      "phases": [{"duration_s": 300}, {"duration_s": 60, "error_rate": 1.0}]
+    }
+
+Phases run in order and loop; each one overrides the top-level settings for its
+duration, so a script like the one above gives five good minutes, then one minute of 500s.
+"""
+
+import argparse
+import base64
+import datetime
+import hashlib
+import json
+import math
+import random
+import socket
+import struct
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+
+class Scenario:
+    def __init__(self, script, rng):
+        self.base = {k: v for k, v in script.items() if k != "phases"}
+        self.phases = script.get("phases") or []
+        self.rng = rng
+        self.start = time.monotonic()
+
+    def current(self):
+        """Settings in effect now (top level overridden by the active phase)."""
+        if not self.phases:
+            return self.base
+        total = sum(p.get("duration_s", 60) for p in self.phases)
+        t = (time.monotonic() - self.start) % total
+        for phase in self.phases:
+            t -= phase.get("duration_s", 60)
+            if t < 0:
+                merged = dict(self.base)
+                merged.update({k: v for k, v in phase.items() if k != "duration_s"})
+                return merged
+        return self.base
+
+    def chance(self, value):
+        if value is True:
+            return True
+        return bool(value) and self.rng.random() < float(value)
+
+    def latency(self, spec):
+        if spec is None:
+            return 0.0
+        if isinstance(spec, (int, float)):
+            return spec / 1000.0
+        if "median" in spec:
+            # Log-normal through the median and p99 (z(0.99) = 2.326)
+            median = max(spec["median"], 0.001)
+            sigma = math.log(max(spec.get("p99", median), median) / median) / 2.326
+            return self.rng.lognormvariate(math.log(median), sigma) / 1000.0
+        return self.rng.uniform(spec.get("min", 0), spec.get("max", 0)) / 1000.0
+
+
+class StateSource:
+    def __init__(self, capture=None, state=None):
+        self.bodies = []
+        self.index = 0
+        self.lock = threading.Lock()
+        if capture:
+            with open(capture, encoding="utf-8") as f:
+                for line in f:
+                    line = line.strip()
+                    if not line:
+                        continue
+                    record = json.loads(line)
+                    if "body" in record and not record.get("truncated"):
+                        self.bodies.append(record["body"].encode())
+            if not self.bodies:
+                sys.exit("%s: no usable records" % capture)
+        elif state:
+            with open(state, "rb") as f:
+                self.bodies.append(f.read().strip())
+
+    def next_body(self):
+        if not self.bodies:
+            return json.dumps(synthetic_state(time.time()), separators=(",", ":")).encode()
+        with self.lock:
+            body = self.bodies[self.index % len(self.bodies)]
+            self.index += 1
+        return body
+
+
+def synthetic_state(now):
+    """A plausible day: PV bell curve, base load with noise, battery buffering, one car."""
+    local = time.localtime(now)
+    hour = local.tm_hour + local.tm_min / 60.0 + local.tm_sec / 3600.0
+    noise = random.Random(int(now / 10))
+    pv = max(0.0, 8200 * math.sin(math.pi * (hour - 6.5) / 13.5)) if 6.5 < hour < 20 else 0.0
+    pv = round(pv * noise.uniform(0.85, 1.0), 1)
+    home = round(350 + 250 * noise.random() + (900 if 18 <= hour < 20 else 0), 1)
+    charging = 10 <= hour < 15
+    charge_power = round(min(11000, max(1400, pv - home)), 1) if charging else 0.0
+    soc = 40 + int(max(0.0, min(hour, 15) - 10) * 9)
+    surplus = pv - home - charge_power
+    battery = round(max(-3000.0, min(3000.0, -surplus)), 1)
+    grid = round(home + charge_power - pv + battery, 1)
+    amps = round(charge_power / 3 / 230, 1)
+    return {
+        "gridPower": grid,
+        "pvPower": pv,
+        "batterySoc": 20 + int(70 * max(0.0, min(1.0, (hour - 8) / 8))),
+        "homePower": home,
+        "batteryPower": battery,
+        "solar": {"scale": 0.92, "todayEnergy": 41250.0},
+        "loadpoints": [{
+            "chargePower": charge_power, "soc": soc, "charging": charging, "plugged": True,
+            "title": "Garage", "vehicletitle": "Mock EV", "vehicleRange": soc * 4,
+            "effectivePlanTime": None, "effectivePlanSoc": 0, "effectiveLimitSoc": 80,
+            "planProjectedStart": None, "chargeCurrents": [amps, amps, amps],
+            "maxCurrent": 16, "offeredCurrent": amps, "phasesActive": 3 if charging else 0,
+            "chargeRemainingDuration": 3600 if charging else 0,
+            "chargedEnergy": round(max(0.0, min(hour, 15) - 10) * 7000, 1),
+        }],
+    }
+
+
+def synthetic_tariff(now):
+    """evcc's /api/tariff/grid: 96 quarter-hour slots from the current one, local offsets in
+    the timestamps, cheap around midday (PV) and at night, expensive in the evening."""
+    slot = datetime.timedelta(minutes=15)
+    start = datetime.datetime.fromtimestamp(now - now % 900).astimezone()
+    rates = []
+    for i in range(96):
+        t = start + i * slot
+        hour = t.hour + t.minute / 60.0
+        price = 0.27 + 0.07 * math.cos(math.pi * (hour - 19) / 12) - (0.09 if 11 <= hour < 15 else 0.0)
+        rates.append({"start": t.isoformat(), "end": (t + slot).isoformat(), "value": round(price, 4)})
+    return {"result": {"rates": rates}}
+
+
+def pad_body(body, size):
+    """Valid JSON of about `size` bytes: the original object plus a padding field."""
+    filler = max(0, size - len(body) - 16)
+    return body[:-1] + b',"padding":"' + b"x" * filler + b'"}'
+
+
+class MockHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    server_version = "mock-evcc"
+
+    def log_message(self, fmt, *args):
+        pass  # one line per request is printed by log_result
+
+    def log_result(self, outcome, sent, started):
+        elapsed = (time.monotonic() - started) * 1000
+        self.server.stats[outcome] = self.server.stats.get(outcome, 0) + 1
+        print("%s %-15s %-4s %-10s %6d B %7.0f ms" % (time.strftime("%H:%M:%S"), self.client_address[0],
+                                                       self.command, outcome, sent, elapsed), flush=True)
+
+    def reset(self):
+        """Abort with RST instead of FIN."""
+        self.connection.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack("ii", 1, 0))
+        self.close_connection = True
+        self.connection.close()
+
+    def do_GET(self):
+        path = self.path.split("?", 1)[0]
+        if path == "/ws":
+            return self.serve_websocket()
+        if path == "/api/state":
+            return self.serve_body(self.server.source.next_body)
+        if path == "/api/tariff/grid":
+            return self.serve_body(lambda: json.dumps(synthetic_tariff(time.time()), separators=(",", ":")).encode())
+        self.send_error(404)
+
+    def serve_body(self, next_body):
+        started = time.monotonic()
+        scenario = self.server.scenario
+        s = scenario.current()
+        rng = scenario.rng
+        time.sleep(scenario.latency(s.get("latency_ms")))
+
+        if scenario.chance(s.get("redirect_rate")) and "redirected" not in self.path:
+            self.send_response(302)
+            self.send_header("Location", self.path + ("&" if "?" in self.path else "?") + "redirected=1")
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return self.log_result("redirect", 0, started)
+        if scenario.chance(s.get("error_rate")):
+            status = rng.choice(s.get("error_status") or [500])
+            body = b'{"error":"mock failure"}'
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+            return self.log_result("http-%d" % status, len(body), started)
+
+        body = next_body()
+        outcome = "ok"
+        if scenario.chance(s.get("huge_rate")):
+            body = pad_body(body, int(s.get("huge_bytes", 65536)))
+            outcome = "huge"
+        if scenario.chance(s.get("truncate_rate")):
+            body = body[:rng.randint(1, max(1, len(body) - 1))]
+            outcome = "truncated"
+        reset_at = rng.randint(0, len(body)) if scenario.chance(s.get("reset_rate")) else None
+        if reset_at == 0:
+            self.reset()
+            return self.log_result("reset", 0, started)
+
+        # HTTP/1.0 clients (the tariff stream) cannot take chunked encoding
+        chunked = self.request_version == "HTTP/1.1" and scenario.chance(s.get("chunked"))
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        if chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.flush()
+
+        stall = s.get("stall") or {}
+        if scenario.chance(stall.get("rate")):
+            time.sleep(stall.get("ms", 10000) / 1000.0)
+            outcome = "stalled" if outcome == "ok" else outcome
+        drip = s.get("drip") or {}
+        dripping = scenario.chance(drip.get("rate"))
+        piece = int(drip.get("bytes", 16)) if dripping else (256 if chunked else len(body))
+        if dripping and outcome == "ok":
+            outcome = "drip"
+
+        sent = 0
+        try:
+            while sent < len(body):
+                n = min(piece, len(body) - sent)
+                if reset_at is not None and sent + n >= reset_at:
+                    self.wfile.write(self.frame(body[sent:reset_at], chunked))
+                    self.wfile.flush()
+                    self.reset()
+                    return self.log_result("reset", reset_at, started)
+                self.wfile.write(self.frame(body[sent:sent + n], chunked))
+                self.wfile.flush()
+                sent += n
+                if dripping:
+                    time.sleep(drip.get("interval_ms", 250) / 1000.0)
+            if chunked:
+                self.wfile.write(b"0\r\n\r\n")
+        except (BrokenPipeError, ConnectionResetError):
+            return self.log_result("client-gone", sent, started)
+        self.log_result(outcome + ("/chunked" if chunked else ""), sent, started)
+
+    @staticmethod
+    def frame(data, chunked):
+        return b"%x\r\n%s\r\n" % (len(data), data) if chunked else data
+
+    def serve_websocket(self):
+        key = self.headers.get("Sec-WebSocket-Key")
+        if not key or self.headers.get("Upgrade", "").lower() != "websocket":
+            self.send_error(400)
+            return
+        started = time.monotonic()
+        accept = base64.b64encode(hashlib.sha1((key + WS_GUID).encode()).digest()).decode()
+        self.send_response(101)
+        self.send_header("Upgrade", "websocket")
+        self.send_header("Connection", "Upgrade")
+        self.send_header("Sec-WebSocket-Accept", accept)
+        self.end_headers()
+        self.wfile.flush()
+        self.close_connection = True
+
+        scenario = self.server.scenario
+        sent = 0
+        try:
+            while True:
+                s = scenario.current()
+                if scenario.chance(s.get("reset_rate")):
+                    self.reset()
+                    return self.log_result("ws-reset", sent, started)
+                payload = self.server.source.next_body()
+                header = bytearray([0x81])  # FIN + text frame, server frames are unmasked
+                if len(payload) < 126:
+                    header.append(len(payload))
+                elif len(payload) < 65536:
+                    header += struct.pack("!BH", 126, len(payload))
+                else:
+                    header += struct.pack("!BQ", 127, len(payload))
+                self.wfile.write(bytes(header) + payload)
+                self.wfile.flush()
+                sent += len(payload)
+                time.sleep(self.server.ws_interval + scenario.latency(s.get("latency_ms")))
+        except (BrokenPipeError, ConnectionResetError, OSError):
+            self.log_result("ws-closed", sent, started)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1", help="bind address (0.0.0.0 for device tests)")
+    parser.add_argument("--port", type=int, default=7070)
+    parser.add_argument("--scenario", help="scenario JSON (default: no faults)")
+    parser.add_argument("--capture", help="/capture NDJSON to serve, in order, looping")
+    parser.add_argument("--state", help="single JSON body to serve")
+    parser.add_argument("--ws-interval", type=float, default=10.0, help="seconds between /ws pushes")
+    parser.add_argument("--seed", type=int, help="random seed for reproducible fault sequences")
+    args = parser.parse_args()
+
+    script = {}
+    if args.scenario:
+        with open(args.scenario, encoding="utf-8") as f:
+            script = json.load(f)
+    server = ThreadingHTTPServer((args.host, args.port), MockHandler)
+    server.daemon_threads = True
+    server.scenario = Scenario(script, random.Random(args.seed))
+    server.source = StateSource(args.capture, args.state)
+    server.ws_interval = args.ws_interval
+    server.stats = {}
+    print("mock EVCC on http://%s:%d/api/state" % (args.host, args.port), flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        summary = ", ".join("%s %d" % kv for kv in sorted(server.stats.items()))
+        print("\nrequests: %s" % (summary or "none"))
+
+
+if __name__ == "__main__":
+    main()
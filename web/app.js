@@ -0,0 +1,47 @@
+// Status page: static shell, live values from /status
+(function () {
+  function onOff(v) { return v ? 'ON' : 'OFF'; }
+  function set(id, v) { document.getElementById(id).textContent = v; }
+
+  function refresh() {
+    fetch('/status').then(function (r) { return r.json(); }).then(function (s) {
+      set('ip', s.ipAddress);
+      set('heap', s.freeHeap);
+      var m = s.lvglMem;
+      if (m) set('lvmem', m.used + ' / ' + m.size + ' bytes, ' + m.fragPct + '% fragmented, largest free ' + m.biggestFree);
+      var h = s.heapHealth;
+      if (h) {
+        var trend = 'largest block ' + h.largestBlock + ' bytes, ' + h.largestTrend + ' bytes/h over ' + h.largestHourly.length + ' h';
+        if (h.restartAt) trend += ', restart planned ' + new Date(h.restartAt * 1000).toLocaleString();
+        set('heaptrend', trend);
+      }
+      var mem = s.memory;
+      if (mem) {
+        set('placement', (mem.psram ? 'PSRAM ' + Math.round(mem.psramFree / 1024) + ' of ' + Math.round(mem.psramSize / 1024) + ' KB free; ' : 'no PSRAM; ') +
+          mem.buffers.map(function (b) { return b.name + ' ' + (b.size / 1024).toFixed(1) + ' KB (' + b.region + ')'; }).join(', '));
+      }
+      var bp = s.bootProfiles;
+      if (bp && bp.boots.length) {
+        var cur = bp.boots[bp.boots.length - 1];
+        set('boot', '#' + cur.boot + ': ' + bp.phases.map(function (name, i) {
+          return cur.us[i] ? name + ' ' + (cur.us[i] / 1000).toFixed(0) + ' ms' : null;
+        }).filter(Boolean).join(', '));
+      }
+      set('uptime', s.uptime);
+      set('debug', onOff(s.debugEnabled));
+      set('demo', onOff(s.demoMode));
+      set('demoBtn', s.demoMode ? 'Live Mode' : 'Demo Mode');
+    }).catch(function () {});
+  }
+
+  // Toggles are POSTed in the background; plain links still work without JS
+  document.querySelectorAll('[data-toggle]').forEach(function (a) {
+    a.addEventListener('click', function (ev) {
+      ev.preventDefault();
+      fetch(a.getAttribute('href'), { method: 'POST' }).then(refresh);
+    });
+  });
+
+  refresh();
+  setInterval(refresh, 10000);
+})();
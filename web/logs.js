@@ -0,0 +1,53 @@
+// Logs page: rows are rendered by the device, new entries arrive via /logs/stream (SSE)
+(function () {
+  var MAX_ROWS = 200;
+  function ts(epoch, ms) {
+    if (epoch >= 100000) return '[' + new Date(epoch * 1000).toLocaleString() + ']';
+    return '[' + ms + ' ms]';
+  }
+  function span(c, t) {
+    var s = document.createElement('span');
+    s.className = c;
+    s.textContent = t;
+    return s;
+  }
+  // Collapsed duplicates: count and when the newest one was logged
+  function rep(n, epoch, ms) {
+    return 'repeated ' + n + '\u00d7, last ' + ts(epoch, ms);
+  }
+
+  document.querySelectorAll('.log').forEach(function (row) {
+    row.querySelector('.timestamp').textContent = ts(parseInt(row.dataset.epoch), row.dataset.ms);
+  });
+  document.querySelectorAll('.rep').forEach(function (s) {
+    s.textContent = rep(s.dataset.n, parseInt(s.dataset.epoch), s.dataset.ms);
+  });
+
+  if (!window.EventSource) return;
+  var body = document.body;
+  var es = new EventSource('/logs/stream?since=' + body.dataset.since + '&level=' + body.dataset.level);
+  var anchor = document.querySelector('script');
+  es.addEventListener('log', function (ev) {
+    var e = JSON.parse(ev.data);
+    // An entry sent again with a new repeat count updates its row
+    var row = document.querySelector('.log[data-seq="' + e.seq + '"]');
+    if (row) {
+      if (!e.rep) return;
+      var s = row.querySelector('.rep') || row.appendChild(span('rep', ''));
+      s.textContent = rep(e.rep, e.lastEpoch, e.lastMs);
+      return;
+    }
+    row = document.createElement('div');
+    row.className = e.prev ? 'log prev' : 'log';
+    row.dataset.seq = e.seq;
+    row.appendChild(span('timestamp', ts(e.epoch, e.ms)));
+    row.appendChild(span('lvl ' + e.lvl, e.lvl));
+    row.appendChild(span('message', e.msg));
+    if (e.rep) row.appendChild(span('rep', rep(e.rep, e.lastEpoch, e.lastMs)));
+    body.insertBefore(row, anchor);
+    var rows = document.querySelectorAll('.log');
+    for (var i = 0; i < rows.length - MAX_ROWS; i++) rows[i].remove();
+  });
+  // Fell behind the device's ring buffer: reload for a consistent view
+  es.addEventListener('overflow', function () { es.close(); location.reload(); });
+})();